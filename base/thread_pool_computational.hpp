@@ -59,6 +59,8 @@ public:
     m_condition.notify_all();
   }
 
+  size_t GetThreadsCount() const { return m_threads.size(); }
+
   // Submit task for execution.
   // func - task to be performed.
   // args - arguments for func.
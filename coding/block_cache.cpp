@@ -0,0 +1,141 @@
+#include "coding/block_cache.hpp"
+
+#include <sstream>
+
+// static
+uint32_t const BlockCache::kDefaultLogBlockSize = 12;  // 4 KiB
+// static
+size_t const BlockCache::kDefaultShardsCount = 16;
+
+size_t BlockCache::KeyHash::operator()(Key const & key) const
+{
+  // Neighbouring blocks of the same file should get to different shards.
+  uint64_t h = key.first * 0x9E3779B97F4A7C15ULL ^ key.second;
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  return static_cast<size_t>(h);
+}
+
+BlockCache::BlockCache(uint64_t maxBytes, uint32_t logBlockSize, size_t shardsCount)
+  : m_logBlockSize(logBlockSize)
+  , m_shardMaxBytes(std::max(maxBytes / std::max(shardsCount, size_t(1)), uint64_t(1) << logBlockSize))
+{
+  CHECK_GREATER(shardsCount, 0, ());
+  CHECK_LESS(logBlockSize, 31, ());
+
+  m_shards.reserve(shardsCount);
+  for (size_t i = 0; i < shardsCount; ++i)
+    m_shards.push_back(std::make_unique<Shard>());
+}
+
+uint64_t BlockCache::AcquireFile(std::string const & fileName, uint64_t fileSize,
+                                 uint64_t modificationStamp)
+{
+  std::lock_guard lock(m_filesMutex);
+  auto & file = m_files[{fileName, fileSize, modificationStamp}];
+  if (file.m_refs++ == 0)
+    file.m_id = m_nextFileId++;
+  return file.m_id;
+}
+
+void BlockCache::ReleaseFile(uint64_t fileId)
+{
+  {
+    std::lock_guard lock(m_filesMutex);
+    auto it = std::find_if(m_files.begin(), m_files.end(),
+                           [fileId](auto const & file) { return file.second.m_id == fileId; });
+    CHECK(it != m_files.end(), (fileId));
+    if (--it->second.m_refs != 0)
+      return;
+    m_files.erase(it);
+  }
+
+  for (auto & shard : m_shards)
+  {
+    std::lock_guard lock(shard->m_mutex);
+    for (auto it = shard->m_lru.begin(); it != shard->m_lru.end();)
+    {
+      if (it->first.first != fileId)
+      {
+        ++it;
+        continue;
+      }
+
+      shard->m_bytes -= it->second->capacity();
+      shard->m_blocks.erase(it->first);
+      it = shard->m_lru.erase(it);
+    }
+  }
+}
+
+BlockCache::Block BlockCache::GetBlock(uint64_t fileId, uint64_t blockNum, BlockReader const & readBlock)
+{
+  Key const key(fileId, blockNum);
+  auto & shard = *m_shards[KeyHash()(key) % m_shards.size()];
+
+  {
+    std::lock_guard lock(shard.m_mutex);
+    auto const it = shard.m_blocks.find(key);
+    if (it != shard.m_blocks.end())
+    {
+      ++m_hits;
+      shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second);
+      return it->second->second;
+    }
+  }
+
+  // The block is read without the lock, a concurrent reader of the same block may read it too.
+  ++m_misses;
+  auto data = std::make_shared<std::vector<char>>(size_t(1) << m_logBlockSize);
+  readBlock(blockNum << m_logBlockSize, *data);
+  Block block = std::move(data);
+
+  std::lock_guard lock(shard.m_mutex);
+  auto const [it, inserted] = shard.m_blocks.emplace(key, shard.m_lru.end());
+  if (!inserted)
+    return it->second->second;
+
+  shard.m_lru.emplace_front(key, block);
+  it->second = shard.m_lru.begin();
+  shard.m_bytes += block->capacity();
+
+  while (shard.m_bytes > m_shardMaxBytes && shard.m_lru.size() > 1)
+  {
+    auto const & lru = shard.m_lru.back();
+    shard.m_bytes -= lru.second->capacity();
+    shard.m_blocks.erase(lru.first);
+    shard.m_lru.pop_back();
+    ++m_evictions;
+  }
+
+  return block;
+}
+
+BlockCache::Stats BlockCache::GetStats() const
+{
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  stats.m_evictions = m_evictions;
+
+  for (auto const & shard : m_shards)
+  {
+    std::lock_guard lock(shard->m_mutex);
+    stats.m_bytes += shard->m_bytes;
+    stats.m_blocks += shard->m_lru.size();
+  }
+
+  std::lock_guard lock(m_filesMutex);
+  stats.m_files = m_files.size();
+  return stats;
+}
+
+std::string DebugPrint(BlockCache::Stats const & stats)
+{
+  std::ostringstream out;
+  out << "BlockCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", evictions: " << stats.m_evictions << ", bytes: " << stats.m_bytes
+      << ", blocks: " << stats.m_blocks << ", files: " << stats.m_files << " ]";
+  return out.str();
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// Thread-safe LRU cache of file blocks with a common memory budget. Unlike ReaderCache it is
+/// meant to be shared by all readers of the process: readers of the same file share blocks,
+/// so pages aren't duplicated between threads and mwm handles. Blocks are distributed between
+/// independent shards to reduce lock contention.
+/// Files are identified by name, size and modification stamp, so a file replaced while old readers
+/// are still opened gets a separate blocks namespace.
+class BlockCache
+{
+public:
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    uint64_t m_bytes = 0;
+    uint64_t m_blocks = 0;
+    uint64_t m_files = 0;
+  };
+
+  static uint32_t const kDefaultLogBlockSize;
+  static size_t const kDefaultShardsCount;
+
+  /// @param maxBytes Memory budget for blocks of all files.
+  explicit BlockCache(uint64_t maxBytes, uint32_t logBlockSize = kDefaultLogBlockSize,
+                      size_t shardsCount = kDefaultShardsCount);
+
+  /// @param modificationStamp See base::FileData::GetModificationStamp().
+  /// @return Id of the blocks namespace of the file. The id is the same for all readers of the file
+  /// until the last of them calls ReleaseFile().
+  uint64_t AcquireFile(std::string const & fileName, uint64_t fileSize, uint64_t modificationStamp);
+  /// Drops blocks of the file when it's released by all readers.
+  void ReleaseFile(uint64_t fileId);
+
+  /// Reads [pos, pos + size) of the file with |fileId| namespace. Blocks which aren't cached
+  /// are read with |reader|, which should have Size() and Read(pos, p, size) methods.
+  template <class ReaderT>
+  void Read(uint64_t fileId, ReaderT & reader, uint64_t pos, void * p, size_t size)
+  {
+    if (size == 0)
+      return;
+    ASSERT_LESS_OR_EQUAL(pos + size, reader.Size(), (pos, size, reader.Size()));
+
+    auto const readBlock = [&reader](uint64_t blockPos, std::vector<char> & data)
+    {
+      data.resize(static_cast<size_t>(
+          std::min(static_cast<uint64_t>(data.size()), reader.Size() - blockPos)));
+      reader.Read(blockPos, data.data(), data.size());
+    };
+
+    char * dst = static_cast<char *>(p);
+    uint64_t blockNum = pos >> m_logBlockSize;
+    size_t offset = static_cast<size_t>(pos - (blockNum << m_logBlockSize));
+    while (size > 0)
+    {
+      auto const block = GetBlock(fileId, blockNum, readBlock);
+      ASSERT_LESS(offset, block->size(), ());
+      size_t const copySize = std::min(size, block->size() - offset);
+      memcpy(dst, block->data() + offset, copySize);
+      dst += copySize;
+      size -= copySize;
+      offset = 0;
+      ++blockNum;
+    }
+  }
+
+  Stats GetStats() const;
+
+  uint32_t GetLogBlockSize() const { return m_logBlockSize; }
+
+private:
+  using Block = std::shared_ptr<std::vector<char> const>;
+  using BlockReader = std::function<void(uint64_t blockPos, std::vector<char> & data)>;
+  // File id and block number.
+  using Key = std::pair<uint64_t, uint64_t>;
+
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const;
+  };
+
+  struct Shard
+  {
+    std::mutex m_mutex;
+    // Front is the most recently used.
+    std::list<std::pair<Key, Block>> m_lru;
+    std::unordered_map<Key, decltype(m_lru)::iterator, KeyHash> m_blocks;
+    uint64_t m_bytes = 0;
+  };
+
+  struct File
+  {
+    uint64_t m_id = 0;
+    size_t m_refs = 0;
+  };
+
+  Block GetBlock(uint64_t fileId, uint64_t blockNum, BlockReader const & readBlock);
+
+  uint32_t const m_logBlockSize;
+  uint64_t const m_shardMaxBytes;
+  std::vector<std::unique_ptr<Shard>> m_shards;
+
+  mutable std::mutex m_filesMutex;
+  // Name, size and modification stamp of a file.
+  std::map<std::tuple<std::string, uint64_t, uint64_t>, File> m_files;
+  uint64_t m_nextFileId = 0;
+
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<uint64_t> m_evictions{0};
+
+  DISALLOW_COPY_AND_MOVE(BlockCache);
+};
+
+std::string DebugPrint(BlockCache::Stats const & stats);
@@ -0,0 +1,168 @@
+#include "testing/testing.hpp"
+
+#include "coding/block_cache.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace block_cache_test
+{
+using std::string, std::vector;
+
+vector<char> MakeData(size_t size)
+{
+  vector<char> data(size);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 253);
+  return data;
+}
+
+void TestRandomReads(BlockCache & cache, uint64_t fileId, vector<char> const & data, uint32_t seed)
+{
+  MemReader memReader(data.data(), data.size());
+  std::mt19937 rng(seed);
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    size_t const pos = rng() % data.size();
+    size_t const len = std::min(static_cast<size_t>(1 + (rng() % 3000)), data.size() - pos);
+    string expected(len, '0'), actual(len, '0');
+    memReader.Read(pos, expected.data(), len);
+    cache.Read(fileId, memReader, pos, actual.data(), len);
+    TEST_EQUAL(expected, actual, (pos, len, i));
+  }
+}
+
+UNIT_TEST(BlockCache_RandomReads)
+{
+  auto const data = MakeData(100000);
+
+  // Budget of 8 blocks of 1 KiB in 4 shards.
+  BlockCache cache(8 * 1024, 10 /* logBlockSize */, 4 /* shardsCount */);
+  auto const fileId = cache.AcquireFile("data", data.size(), 0 /* modificationStamp */);
+  TestRandomReads(cache, fileId, data, 0);
+
+  auto const stats = cache.GetStats();
+  TEST_GREATER(stats.m_hits, 0, (stats));
+  TEST_GREATER(stats.m_evictions, 0, (stats));
+  TEST_LESS_OR_EQUAL(stats.m_bytes, 8 * 1024, (stats));
+  TEST_EQUAL(stats.m_files, 1, (stats));
+}
+
+UNIT_TEST(BlockCache_Files)
+{
+  BlockCache cache(1 << 20);
+  auto const data = MakeData(10000);
+  MemReader reader(data.data(), data.size());
+
+  auto const id1 = cache.AcquireFile("first", data.size(), 0 /* modificationStamp */);
+  auto const id2 = cache.AcquireFile("first", data.size(), 0 /* modificationStamp */);
+  auto const id3 = cache.AcquireFile("second", data.size(), 0 /* modificationStamp */);
+  TEST_EQUAL(id1, id2, ());
+  TEST_NOT_EQUAL(id1, id3, ());
+  // The file was replaced.
+  auto const id4 = cache.AcquireFile("first", data.size(), 1 /* modificationStamp */);
+  TEST_NOT_EQUAL(id1, id4, ());
+  cache.ReleaseFile(id4);
+
+  char c;
+  cache.Read(id1, reader, 0, &c, 1);
+  cache.Read(id3, reader, 0, &c, 1);
+  TEST_EQUAL(cache.GetStats().m_blocks, 2, ());
+
+  // Blocks are kept until the last reader of the file is released.
+  cache.ReleaseFile(id1);
+  TEST_EQUAL(cache.GetStats().m_blocks, 2, ());
+  cache.ReleaseFile(id2);
+  TEST_EQUAL(cache.GetStats().m_blocks, 1, ());
+  TEST_EQUAL(cache.GetStats().m_files, 1, ());
+
+  TEST_NOT_EQUAL(cache.AcquireFile("first", data.size(), 0 /* modificationStamp */), id1, ());
+}
+
+UNIT_TEST(BlockCache_Threads)
+{
+  auto const data = MakeData(300000);
+  BlockCache cache(64 * 1024, 12 /* logBlockSize */, 4 /* shardsCount */);
+  auto const fileId = cache.AcquireFile("data", data.size(), 0 /* modificationStamp */);
+
+  vector<std::thread> threads;
+  for (uint32_t i = 0; i < 4; ++i)
+    threads.emplace_back([&, i]() { TestRandomReads(cache, fileId, data, i); });
+  for (auto & thread : threads)
+    thread.join();
+
+  TEST_LESS_OR_EQUAL(cache.GetStats().m_bytes, 64 * 1024, ());
+}
+
+UNIT_TEST(BlockCache_FileReader)
+{
+  string const fileName = "block_cache_test_tmp.dat";
+  auto const data = MakeData(50000);
+  {
+    FileWriter writer(fileName);
+    writer.Write(data.data(), data.size());
+  }
+
+  {
+    auto cache = std::make_shared<BlockCache>(16 * 1024);
+    FileReader reader1(fileName, cache);
+    FileReader reader2(fileName, cache);
+
+    vector<char> actual(data.size());
+    reader1.Read(0, actual.data(), actual.size());
+    TEST(actual == data, ());
+
+    // The second reader uses blocks of the first one.
+    auto const misses = cache->GetStats().m_misses;
+    auto const subReader = reader2.SubReader(data.size() - 100, 100);
+    subReader.Read(0, actual.data(), 100);
+    TEST(std::equal(actual.begin(), actual.begin() + 100, data.end() - 100), ());
+    TEST_EQUAL(cache->GetStats().m_misses, misses, ());
+  }
+
+  FileWriter::DeleteFileX(fileName);
+}
+
+UNIT_TEST(BlockCache_ReplacedFile)
+{
+  string const fileName = "block_cache_test_replaced.dat";
+  string const tmpFileName = fileName + ".tmp";
+  auto const oldData = MakeData(10000);
+  auto newData = oldData;
+  std::reverse(newData.begin(), newData.end());
+
+  auto const write = [](string const & name, vector<char> const & data)
+  {
+    FileWriter writer(name);
+    writer.Write(data.data(), data.size());
+  };
+  write(fileName, oldData);
+
+  auto cache = std::make_shared<BlockCache>(1 << 20);
+  {
+    FileReader oldReader(fileName, cache);
+    vector<char> actual(oldData.size());
+    oldReader.Read(0, actual.data(), actual.size());
+    TEST(actual == oldData, ());
+
+    // The file of the same size is replaced while the old reader is opened.
+    write(tmpFileName, newData);
+    TEST(base::RenameFileX(tmpFileName, fileName), ());
+
+    FileReader newReader(fileName, cache);
+    newReader.Read(0, actual.data(), actual.size());
+    TEST(actual == newData, ());
+    TEST_EQUAL(cache->GetStats().m_files, 2, ());
+  }
+
+  FileWriter::DeleteFileX(fileName);
+}
+}  // namespace block_cache_test
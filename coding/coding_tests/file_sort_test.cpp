@@ -55,3 +55,74 @@ UNIT_TEST(FileSorter_Random)
 
   TestFileSorter(data, "file_sorter_test_random.tmp", data.size() / 10);
 }
+
+UNIT_TEST(FileSorter_Stable)
+{
+  // Only the high half of an item is compared, the low half keeps the insertion index.
+  struct Less
+  {
+    bool operator()(uint32_t l, uint32_t r) const { return (l >> 16) < (r >> 16); }
+  };
+
+  mt19937 rng(0);
+  vector<uint32_t> data(1000);
+  for (uint32_t i = 0; i < data.size(); ++i)
+    data[i] = ((rng() % 10) << 16) | i;
+
+  vector<char> serial;
+  MemWriter<vector<char>> writer(serial);
+  WriterFunctor<MemWriter<vector<char>>> out(writer);
+  FileSorter<uint32_t, decltype(out), Less> sorter(data.size(), "file_sorter_test_stable.tmp", out);
+  for (auto const item : data)
+    sorter.Add(item);
+  sorter.SortAndFinish();
+
+  stable_sort(data.begin(), data.end(), Less());
+  vector<uint32_t> result(data.size());
+  MemReader reader(serial.data(), serial.size());
+  TEST_EQUAL(reader.Size(), result.size() * sizeof(result[0]), ());
+  reader.Read(0, result.data(), reader.Size());
+  TEST_EQUAL(result, data, ());
+}
+
+UNIT_TEST(BlobFileSorter_Random)
+{
+  using Record = pair<uint32_t, vector<uint8_t>>;
+
+  struct Sink
+  {
+    void operator()(uint32_t key, vector<uint8_t> const & blob) { m_records.emplace_back(key, blob); }
+    vector<Record> m_records;
+  };
+
+  mt19937 rng(0);
+  vector<Record> data(1000);
+  for (auto & [key, blob] : data)
+  {
+    key = rng() % 50;
+    blob.resize(rng() % 100);
+    for (auto & b : blob)
+      b = static_cast<uint8_t>(rng());
+  }
+
+  for (size_t bufferBytes : {size_t(0), size_t(5000), size_t(1000000)})
+  {
+    Sink sink;
+    {
+      BlobFileSorter<uint32_t, Sink> sorter(bufferBytes, "blob_file_sorter_test_random.tmp", sink);
+      for (auto const & [key, blob] : data)
+        sorter.Add(key, blob.data(), blob.size());
+      sorter.SortAndFinish();
+      if (bufferBytes == 1000000)
+        TEST_EQUAL(sorter.GetRunsCount(), 1, ());
+      else
+        TEST_GREATER(sorter.GetRunsCount(), 1, ());
+    }
+
+    // Records with equal keys should keep the insertion order.
+    auto expected = data;
+    stable_sort(expected.begin(), expected.end(),
+                [](Record const & l, Record const & r) { return l.first < r.first; });
+    TEST_EQUAL(sink.m_records, expected, (bufferBytes));
+  }
+}
@@ -3,8 +3,10 @@
 
 #include "coding/byte_stream.hpp"
 
+#include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/timer.hpp"
 
 #include <vector>
 
@@ -181,3 +183,128 @@ UNIT_TEST(ReadVarInt64Array)
   }
 }
 
+UNIT_TEST(DecodeVarUint64Array)
+{
+  vector<uint64_t> values;
+  for (int b = 0; b < 64; ++b)
+  {
+    values.push_back((1ULL << b) - 1);
+    values.push_back(1ULL << b);
+  }
+  values.push_back(uint64_t(-1));
+
+  // Mix long and short values so that they cross word boundaries at every offset.
+  for (size_t shift = 0; shift < 9; ++shift)
+  {
+    vector<uint64_t> testValues(shift, 1);
+    for (auto const v : values)
+    {
+      testValues.push_back(v);
+      testValues.push_back(shift);
+    }
+
+    vector<uint8_t> data;
+    {
+      PushBackByteSink<vector<uint8_t>> dst(data);
+      for (auto const v : testValues)
+        WriteVarUint(dst, v);
+    }
+
+    void const * pDataEnd = data.data() + data.size();
+    {
+      vector<uint64_t> result = {42};
+      void const * pEnd = DecodeVarUint64Array(data.data(), pDataEnd, result);
+      TEST_EQUAL(pEnd, pDataEnd, (shift));
+      TEST_EQUAL(result.front(), 42, ());
+      TEST_EQUAL(vector<uint64_t>(result.begin() + 1, result.end()), testValues, (shift));
+    }
+    {
+      vector<uint64_t> result;
+      void const * pEnd = DecodeVarUint64Array(data.data(), pDataEnd, testValues.size(), result);
+      TEST_EQUAL(pEnd, pDataEnd, (shift));
+      TEST_EQUAL(result, testValues, (shift));
+    }
+    {
+      // Decode a prefix of the buffer: the readable memory continues after the last value.
+      size_t const count = testValues.size() / 2;
+      vector<uint64_t> result;
+      void const * pEnd = DecodeVarUint64Array(data.data(), pDataEnd, count, result);
+      TEST_EQUAL(result, vector<uint64_t>(testValues.begin(), testValues.begin() + count), (shift));
+
+      vector<uint64_t> rest;
+      TEST_EQUAL(DecodeVarUint64Array(pEnd, pDataEnd, rest), pDataEnd, (shift));
+      TEST_EQUAL(rest, vector<uint64_t>(testValues.begin() + count, testValues.end()), (shift));
+    }
+  }
+}
+
+UNIT_TEST(DecodeVarUint64Array_Truncated)
+{
+  vector<uint64_t> result;
+  TEST_EQUAL(DecodeVarUint64Array(nullptr, (void const *)nullptr, result), nullptr, ());
+  TEST(result.empty(), ());
+
+  vector<uint8_t> data;
+  {
+    PushBackByteSink<vector<uint8_t>> dst(data);
+    WriteVarUint(dst, uint64_t(1) << 40);
+  }
+  data.pop_back();
+
+  bool thrown = false;
+  try
+  {
+    DecodeVarUint64Array(data.data(), data.data() + data.size(), result);
+  }
+  catch (ReadVarIntException const &)
+  {
+    thrown = true;
+  }
+  TEST(thrown, ());
+}
+
+UNIT_TEST(DecodeVarUint64Array_Benchmark)
+{
+  // Geometry deltas are mostly 1-3 bytes long.
+  size_t constexpr kCount = 1 << 20;
+  vector<uint64_t> values(kCount);
+  uint64_t seed = 1;
+  for (auto & v : values)
+  {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    v = (seed >> 33) & ((1ULL << (1 + (seed >> 60))) - 1);
+  }
+
+  vector<uint8_t> data;
+  {
+    PushBackByteSink<vector<uint8_t>> dst(data);
+    for (auto const v : values)
+      WriteVarUint(dst, v);
+  }
+  void const * pBeg = data.data();
+  void const * pEnd = data.data() + data.size();
+
+  int constexpr kRuns = 10;
+  vector<uint64_t> result;
+
+  base::Timer timer;
+  for (int i = 0; i < kRuns; ++i)
+  {
+    result.clear();
+    ReadVarUint64Array(pBeg, pEnd, base::MakeBackInsertFunctor(result));
+  }
+  double const readSeconds = timer.ElapsedSeconds();
+  TEST_EQUAL(result, values, ());
+
+  timer.Reset();
+  for (int i = 0; i < kRuns; ++i)
+  {
+    result.clear();
+    DecodeVarUint64Array(pBeg, pEnd, result);
+  }
+  double const decodeSeconds = timer.ElapsedSeconds();
+  TEST_EQUAL(result, values, ());
+
+  LOG(LINFO, ("Million values per second. ReadVarUint64Array:", kRuns * kCount / readSeconds / 1e6,
+              "DecodeVarUint64Array:", kRuns * kCount / decodeSeconds / 1e6));
+}
@@ -1,10 +1,13 @@
 #include "coding/file_reader.hpp"
 
+#include "coding/block_cache.hpp"
 #include "coding/reader_cache.hpp"
 #include "coding/internal/file_data.hpp"
 
 #include "base/logging.hpp"
 
+#include <optional>
+
 #ifndef LOG_FILE_READER_STATS
 #define LOG_FILE_READER_STATS 0
 #endif // LOG_FILE_READER_STATS
@@ -22,8 +25,20 @@ class FileReader::FileReaderData
 {
 public:
   FileReaderData(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
-    : m_fileData(fileName), m_readerCache(logPageSize, logPageCount)
+    : m_fileData(fileName)
+  {
+    m_readerCache.emplace(logPageSize, logPageCount);
+#if LOG_FILE_READER_STATS
+    m_readCallCount = 0;
+#endif
+  }
+
+  FileReaderData(std::string const & fileName, std::shared_ptr<BlockCache> blockCache)
+    : m_fileData(fileName), m_blockCache(std::move(blockCache))
   {
+    CHECK(m_blockCache, ());
+    m_fileId = m_blockCache->AcquireFile(fileName, m_fileData.Size(),
+                                         m_fileData.GetModificationStamp());
 #if LOG_FILE_READER_STATS
     m_readCallCount = 0;
 #endif
@@ -32,8 +47,10 @@ public:
   ~FileReaderData()
   {
 #if LOG_FILE_READER_STATS
-    LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache.GetStatsStr()));
+    LOG(LINFO, ("FileReader", m_fileData.GetName(), GetStatsStr()));
 #endif
+    if (m_blockCache)
+      m_blockCache->ReleaseFile(m_fileId);
   }
 
   uint64_t Size() const { return m_fileData.Size(); }
@@ -43,14 +60,22 @@ public:
 #if LOG_FILE_READER_STATS
     if (((++m_readCallCount) & LOG_FILE_READER_EVERY_N_READS_MASK) == 0)
     {
-      LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache.GetStatsStr()));
+      LOG(LINFO, ("FileReader", m_fileData.GetName(), GetStatsStr()));
     }
 #endif
 
-    return m_readerCache.Read(m_fileData, pos, p, size);
+    if (m_blockCache)
+      m_blockCache->Read(m_fileId, m_fileData, pos, p, size);
+    else
+      m_readerCache->Read(m_fileData, pos, p, size);
   }
 
 private:
+  std::string GetStatsStr() const
+  {
+    return m_blockCache ? DebugPrint(m_blockCache->GetStats()) : m_readerCache->GetStatsStr();
+  }
+
   class FileDataWithCachedSize : public base::FileData
   {
   public:
@@ -66,7 +91,10 @@ private:
   };
 
   FileDataWithCachedSize m_fileData;
-  ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS> m_readerCache;
+  // Exactly one of the caches is used.
+  std::optional<ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS>> m_readerCache;
+  std::shared_ptr<BlockCache> m_blockCache;
+  uint64_t m_fileId = 0;
 
 #if LOG_FILE_READER_STATS
   uint32_t m_readCallCount;
@@ -88,6 +116,16 @@ FileReader::FileReader(std::string const & fileName, uint32_t logPageSize, uint3
 {
 }
 
+FileReader::FileReader(std::string const & fileName, std::shared_ptr<BlockCache> blockCache)
+  : ModelReader(fileName)
+  , m_logPageSize(kDefaultLogPageSize)
+  , m_logPageCount(kDefaultLogPageCount)
+  , m_fileData(std::make_shared<FileReaderData>(fileName, std::move(blockCache)))
+  , m_offset(0)
+  , m_size(m_fileData->Size())
+{
+}
+
 FileReader::FileReader(FileReader const & reader, uint64_t offset, uint64_t size,
                        uint32_t logPageSize, uint32_t logPageCount)
   : ModelReader(reader.GetName())
@@ -9,6 +9,8 @@
 #include <memory>
 #include <string>
 
+class BlockCache;
+
 // FileReader, cheap to copy, not thread safe.
 // It is assumed that file is not modified during FireReader lifetime,
 // because of caching and assumption that Size() is constant.
@@ -20,6 +22,8 @@ public:
 
   explicit FileReader(std::string const & fileName);
   FileReader(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount);
+  /// Reads pages through |blockCache| shared with other readers instead of an own page cache.
+  FileReader(std::string const & fileName, std::shared_ptr<BlockCache> blockCache);
 
   // Reader overrides:
   uint64_t Size() const override { return m_size; }
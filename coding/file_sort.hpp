@@ -2,6 +2,8 @@
 
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "base/base.hpp"
 #include "base/logging.hpp"
@@ -14,6 +16,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -24,7 +27,8 @@ struct Sorter
   Sorter(LessT lessF) : m_Less(lessF) {}
   template <typename IterT> void operator() (IterT beg, IterT end) const
   {
-    std::sort(beg, end, m_Less);
+    // Stable, so that equal items keep the order in which they were added.
+    std::stable_sort(beg, end, m_Less);
   }
 };
 
@@ -107,7 +111,12 @@ private:
     explicit ItemIndexPairGreater(LessT fLess) : m_Less(fLess) {}
     inline bool operator()(std::pair<T, uint32_t> const & a, std::pair<T, uint32_t> const & b) const
     {
-      return m_Less(b.first, a.first);
+      if (m_Less(b.first, a.first))
+        return true;
+      if (m_Less(a.first, b.first))
+        return false;
+      // Equal items are taken from earlier chunks first.
+      return a.second > b.second;
     }
     LessT m_Less;
   };
@@ -141,3 +150,180 @@ private:
   uint32_t m_ItemCount;
   LessT m_Less;
 };
+
+// Sorts variable-length records (a key with an opaque blob) in bounded memory.
+// Records are accumulated until |bufferBytes| is exceeded, then sorted and flushed as a run
+// into a temporary file. SortAndFinish() merges all runs and passes records to the output sink
+// as sink(key, blob). Records with equal keys keep the order in which they were added.
+template <typename KeyT,                              // Trivially copyable key type.
+          class OutputSinkT,                          // sink(KeyT const &, std::vector<uint8_t> const &).
+          typename LessT = std::less<KeyT>            // Key comparator.
+          >
+class BlobFileSorter
+{
+  static_assert(std::is_trivially_copyable<KeyT>::value, "");
+
+public:
+  BlobFileSorter(size_t bufferBytes, std::string const & tmpFileName, OutputSinkT & outputSink,
+                 LessT fLess = LessT())
+    : m_TmpFileName(tmpFileName)
+    , m_BufferBytes(std::max(size_t(1024), bufferBytes))
+    , m_OutputSink(outputSink)
+    , m_Less(fLess)
+  {
+    m_pTmpWriter.reset(new FileWriter(tmpFileName));
+  }
+
+  void Add(KeyT const & key, void const * p, size_t size)
+  {
+    if (!m_Items.empty() && m_Data.size() + size > m_BufferBytes)
+      FlushToTmpFile();
+
+    m_Items.push_back({key, m_ItemCount++, m_Data.size(), static_cast<uint32_t>(size)});
+    auto const * bytes = static_cast<uint8_t const *>(p);
+    m_Data.insert(m_Data.end(), bytes, bytes + size);
+  }
+
+  /// @return Number of the temporary runs (1 means that everything fitted into memory).
+  size_t GetRunsCount() const { return m_Runs.size(); }
+
+  void SortAndFinish()
+  {
+    ASSERT(m_pTmpWriter.get(), ());
+    FlushToTmpFile();
+    m_pTmpWriter.reset();
+    std::vector<uint8_t>().swap(m_Data);
+    std::vector<Item>().swap(m_Items);
+
+    {
+      // Each run has its own reader to avoid evicting pages of other runs from the cache.
+      std::vector<Run> runs;
+      runs.reserve(m_Runs.size());
+      for (auto const & [begin, end] : m_Runs)
+      {
+        FileReader reader(m_TmpFileName, kRunLogPageSize, kRunLogPageCount);
+        runs.emplace_back(reader.SubReader(begin, end - begin));
+      }
+
+      auto const greater = [this, &runs](size_t lhs, size_t rhs)
+      {
+        auto const & l = runs[lhs];
+        auto const & r = runs[rhs];
+        if (m_Less(l.m_Key, r.m_Key))
+          return false;
+        if (m_Less(r.m_Key, l.m_Key))
+          return true;
+        return l.m_Seq > r.m_Seq;
+      };
+      std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> q(greater);
+      for (size_t i = 0; i < runs.size(); ++i)
+      {
+        if (runs[i].Next())
+          q.push(i);
+      }
+
+      while (!q.empty())
+      {
+        size_t const i = q.top();
+        q.pop();
+        m_OutputSink(runs[i].m_Key, runs[i].m_Blob);
+        if (runs[i].Next())
+          q.push(i);
+      }
+    }
+    FileWriter::DeleteFileX(m_TmpFileName);
+  }
+
+  ~BlobFileSorter()
+  {
+    if (m_pTmpWriter.get())
+    {
+      try
+      {
+        SortAndFinish();
+      }
+      catch(RootException const & e)
+      {
+        LOG(LERROR, (e.Msg()));
+      }
+      catch(std::exception const & e)
+      {
+        LOG(LERROR, (e.what()));
+      }
+    }
+  }
+
+private:
+  struct Item
+  {
+    KeyT m_Key;
+    uint64_t m_Seq;
+    size_t m_Offset;
+    uint32_t m_Size;
+  };
+
+  static uint32_t constexpr kRunLogPageSize = 16;
+  static uint32_t constexpr kRunLogPageCount = 2;
+
+  // Sequential reader of one sorted run.
+  struct Run
+  {
+    explicit Run(FileReader const & reader) : m_Src(reader) {}
+
+    bool Next()
+    {
+      if (m_Src.Size() == 0)
+        return false;
+      m_Src.Read(&m_Key, sizeof(m_Key));
+      m_Seq = ReadPrimitiveFromSource<uint64_t>(m_Src);
+      m_Blob.resize(ReadPrimitiveFromSource<uint32_t>(m_Src));
+      if (!m_Blob.empty())
+        m_Src.Read(m_Blob.data(), m_Blob.size());
+      return true;
+    }
+
+    ReaderSource<FileReader> m_Src;
+    KeyT m_Key;
+    uint64_t m_Seq = 0;
+    std::vector<uint8_t> m_Blob;
+  };
+
+  void FlushToTmpFile()
+  {
+    if (m_Items.empty())
+      return;
+
+    std::sort(m_Items.begin(), m_Items.end(), [this](Item const & l, Item const & r)
+    {
+      if (m_Less(l.m_Key, r.m_Key))
+        return true;
+      if (m_Less(r.m_Key, l.m_Key))
+        return false;
+      return l.m_Seq < r.m_Seq;
+    });
+
+    uint64_t const begin = m_pTmpWriter->Pos();
+    for (auto const & item : m_Items)
+    {
+      m_pTmpWriter->Write(&item.m_Key, sizeof(item.m_Key));
+      WriteToSink(*m_pTmpWriter, item.m_Seq);
+      WriteToSink(*m_pTmpWriter, item.m_Size);
+      if (item.m_Size != 0)
+        m_pTmpWriter->Write(&m_Data[item.m_Offset], item.m_Size);
+    }
+    m_Runs.emplace_back(begin, m_pTmpWriter->Pos());
+
+    m_Items.clear();
+    m_Data.clear();
+  }
+
+  std::string const m_TmpFileName;
+  size_t const m_BufferBytes;
+  OutputSinkT & m_OutputSink;
+  std::unique_ptr<FileWriter> m_pTmpWriter;
+  std::vector<Item> m_Items;
+  std::vector<uint8_t> m_Data;
+  std::vector<std::pair<uint64_t, uint64_t>> m_Runs;
+  uint64_t m_ItemCount = 0;
+  LessT m_Less;
+};
@@ -76,6 +76,12 @@ FilesContainerR::FilesContainerR(std::string const & filePath,
   ReadInfo(m_source);
 }
 
+FilesContainerR::FilesContainerR(std::string const & filePath, std::shared_ptr<BlockCache> blockCache)
+  : m_source(std::make_unique<FileReader>(filePath, std::move(blockCache)))
+{
+  ReadInfo(m_source);
+}
+
 FilesContainerR::FilesContainerR(TReader const & file)
   : m_source(file)
 {
@@ -120,6 +120,8 @@ public:
                            uint32_t logPageSize = 10,
                            uint32_t logPageCount = 10);
   explicit FilesContainerR(TReader const & file);
+  /// Reads the file through |blockCache|, see BlockCache.
+  FilesContainerR(std::string const & filePath, std::shared_ptr<BlockCache> blockCache);
 
   TReader GetReader(Tag const & tag) const;
 
@@ -366,13 +366,11 @@ void Decode(DecodeFunT fn, DeltasT const & deltas, GeometryCodingParams const &
   DecodeImpl(fn, deltas, params, points, reserveF);
 }
 
-void const * LoadInner(DecodeFunT fn, void const * pBeg, size_t count,
+void const * LoadInner(DecodeFunT fn, void const * pBeg, void const * pEnd, size_t count,
                        GeometryCodingParams const & params, OutPointsT & points)
 {
   DeltasT deltas;
-  deltas.reserve(count);
-  void const * ret =
-      ReadVarUint64Array(static_cast<char const *>(pBeg), count, base::MakeBackInsertFunctor(deltas));
+  void const * ret = DecodeVarUint64Array(pBeg, pEnd, count, deltas);
 
   Decode(fn, deltas, params, points);
   return ret;
@@ -233,7 +233,8 @@ void SaveOuter(EncodeFunT fn, std::vector<m2::PointD> const & points,
   WriteBufferToSink(buffer, sink);
 }
 
-void const * LoadInner(DecodeFunT fn, void const * pBeg, size_t count,
+/// @param pEnd End of the readable memory after |pBeg| (not the end of the geometry).
+void const * LoadInner(DecodeFunT fn, void const * pBeg, void const * pEnd, size_t count,
                        GeometryCodingParams const & params, OutPointsT & points);
 
 template <class TSource, class TPoints>
@@ -246,8 +247,7 @@ void LoadOuter(DecodeFunT fn, TSource & src, GeometryCodingParams const & params
   src.Read(p, count);
 
   DeltasT deltas;
-  deltas.reserve(count / 2);
-  ReadVarUint64Array(p, p + count, base::MakeBackInsertFunctor(deltas));
+  DecodeVarUint64Array(p, p + count, deltas);
 
   Decode(fn, deltas, params, points, reserveF);
 }
@@ -267,10 +267,10 @@ void SaveOuterPath(std::vector<m2::PointD> const & points, GeometryCodingParams
   SaveOuter(&coding::EncodePolyline, points, params, sink);
 }
 
-inline void const * LoadInnerPath(void const * pBeg, size_t count,
+inline void const * LoadInnerPath(void const * pBeg, void const * pEnd, size_t count,
                                   GeometryCodingParams const & params, OutPointsT & points)
 {
-  return LoadInner(&coding::DecodePolyline, pBeg, count, params, points);
+  return LoadInner(&coding::DecodePolyline, pBeg, pEnd, count, params, points);
 }
 
 template <class TSource, class TPoints>
@@ -300,12 +300,12 @@ inline void StripToTriangles(size_t count, OutPointsT const & strip, OutPointsT
   }
 }
 
-inline void const * LoadInnerTriangles(void const * pBeg, size_t count,
+inline void const * LoadInnerTriangles(void const * pBeg, void const * pEnd, size_t count,
                                        GeometryCodingParams const & params, OutPointsT & triangles)
 {
   CHECK_GREATER_OR_EQUAL(count, 2, ());
   OutPointsT points;
-  void const * res = LoadInner(&coding::DecodeTriangleStrip, pBeg, count, params, points);
+  void const * res = LoadInner(&coding::DecodeTriangleStrip, pBeg, pEnd, count, params, points);
 
   StripToTriangles(count, points, triangles);
   return res;
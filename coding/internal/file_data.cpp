@@ -18,6 +18,9 @@
 #include <fstream>
 #include <vector>
 
+#include <sys/stat.h>
+#include <sys/types.h>
+
 #ifdef OMIM_OS_WINDOWS
 #include <io.h>
 #else
@@ -119,6 +122,29 @@ void FileData::Read(uint64_t pos, void * p, size_t size)
     MYTHROW(Reader::ReadException, (GetErrorProlog(), bytesRead, pos, size));
 }
 
+uint64_t FileData::GetModificationStamp() const
+{
+  uint64_t constexpr kNsInSecond = 1000000000;
+#ifdef OMIM_OS_WINDOWS
+  struct _stat64 st;
+  if (_fstat64(_fileno(m_File), &st) != 0)
+    MYTHROW(Reader::ReadException, (GetErrorProlog()));
+  uint64_t const mtimeNs = static_cast<uint64_t>(st.st_mtime) * kNsInSecond;
+#else
+  struct stat st;
+  if (fstat(fileno(m_File), &st) != 0)
+    MYTHROW(Reader::ReadException, (GetErrorProlog()));
+#if defined(OMIM_OS_MAC) || defined(OMIM_OS_IPHONE)
+  auto const & mtime = st.st_mtimespec;
+#else
+  auto const & mtime = st.st_mtim;
+#endif
+  uint64_t const mtimeNs = static_cast<uint64_t>(mtime.tv_sec) * kNsInSecond + mtime.tv_nsec;
+#endif
+  // A file replaced by rename has another inode even if it has the same modification time.
+  return mtimeNs ^ (static_cast<uint64_t>(st.st_ino) * 0x9E3779B97F4A7C15ULL);
+}
+
 uint64_t FileData::Pos() const
 {
   int64_t const pos = ftell64(m_File);
@@ -20,6 +20,9 @@ public:
 
   uint64_t Size() const;
   uint64_t Pos() const;
+  /// @return Hash of the modification time and inode of the opened file. It changes when
+  /// the file is rewritten or replaced by another one.
+  uint64_t GetModificationStamp() const;
 
   void Seek(uint64_t pos);
 
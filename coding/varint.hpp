@@ -1,5 +1,6 @@
 #pragma once
 
+#include "coding/endianness.hpp"
 #include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
@@ -10,8 +11,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 // Writes any unsigned integer type using optimal bytes count, platform-independent.
 // Value ranges are [0;127] - 1 byte, [128; 16383] - 2 bytes, [16384; 2097151] - 3 bytes, etc.
 template <typename T, typename TSink>
@@ -280,6 +286,150 @@ void const * ReadVarUint64Array(void const * pBeg, size_t count, F f)
   return ::impl::ReadVarInt64Array(pBeg, ::impl::ReadVarInt64ArrayGivenSize(count), f, base::IdFunctor());
 }
 
+namespace impl
+{
+class VarUintPtrSource
+{
+public:
+  explicit VarUintPtrSource(uint8_t const * p) : m_p(p) {}
+
+  void Read(void * p, size_t size)
+  {
+    std::memcpy(p, m_p, size);
+    m_p += size;
+  }
+
+  uint8_t const * Ptr() const { return m_p; }
+
+private:
+  uint8_t const * m_p;
+};
+
+inline uint32_t CountTrailingZeroes(uint64_t x)
+{
+  ASSERT_NOT_EQUAL(x, 0, ());
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint32_t>(__builtin_ctzll(x));
+#else
+  return bits::FloorLog(x & (~x + 1));
+#endif
+}
+
+uint64_t constexpr kVarUintStopBits = 0x8080808080808080ULL;
+
+// Decodes the first varuint from 8 little-endian bytes of |word|.
+// @return Size of the varuint in bytes or 0 if it doesn't fit into 8 bytes.
+inline size_t DecodeVarUintFromWord(uint64_t word, uint64_t & value)
+{
+  uint64_t const stops = ~word & kVarUintStopBits;
+  if (stops == 0)
+    return 0;
+
+  uint64_t const lastBit = stops & (~stops + 1);
+  // Keep bytes of the first varuint only.
+  word &= (lastBit << 1) - 1;
+
+#if defined(__BMI2__)
+  value = _pext_u64(word, 0x7F7F7F7F7F7F7F7FULL);
+#else
+  // Compact 7-bit groups: 7 -> 14 -> 28 -> 56 bits.
+  word &= 0x7F7F7F7F7F7F7F7FULL;
+  word = (word & 0x007F007F007F007FULL) | ((word & 0x7F007F007F007F00ULL) >> 1);
+  word = (word & 0x00003FFF00003FFFULL) | ((word & 0x3FFF00003FFF0000ULL) >> 2);
+  word = (word & 0x000000000FFFFFFFULL) | ((word & 0x0FFFFFFF00000000ULL) >> 4);
+  value = word;
+#endif
+
+  return (CountTrailingZeroes(lastBit) >> 3) + 1;
+}
+
+// Decodes varuints from |p| into [dst, dstEnd). Memory up to |end| may be read, so values are
+// decoded from single word loads while 8 bytes are readable and byte by byte after that.
+inline uint8_t const * DecodeVarUints(uint8_t const * p, uint8_t const * end, uint64_t * dst,
+                                      uint64_t * const dstEnd)
+{
+  while (dst != dstEnd && end - p >= 8)
+  {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    size_t const size = DecodeVarUintFromWord(SwapIfBigEndianMacroBased(word), *dst);
+    if (size != 0)
+    {
+      p += size;
+    }
+    else
+    {
+      VarUintPtrSource src(p);
+      *dst = ReadVarUint(src, static_cast<uint64_t const *>(nullptr));
+      p = src.Ptr();
+    }
+    ++dst;
+  }
+
+  // The tail is shorter than a word.
+  VarUintPtrSource src(p);
+  for (; dst != dstEnd; ++dst)
+    *dst = ReadVarUint(src, static_cast<uint64_t const *>(nullptr));
+  return src.Ptr();
+}
+}  // namespace impl
+
+/// Bulk version of ReadVarUint64Array for contiguous buffers: decodes all varuints from
+/// [pBeg, pEnd) and appends them to |out| (std::vector or buffer_vector of uint64_t).
+/// Output is allocated once and values of up to 8 bytes are decoded from a single word load
+/// without per-byte branches, which is several times faster on geometry deltas.
+template <class Cont>
+void const * DecodeVarUint64Array(void const * pBeg, void const * pEnd, Cont & out)
+{
+  uint8_t const * p = static_cast<uint8_t const *>(pBeg);
+  uint8_t const * const end = static_cast<uint8_t const *>(pEnd);
+  ASSERT_LESS_OR_EQUAL(reinterpret_cast<uintptr_t>(p), reinterpret_cast<uintptr_t>(end), ());
+  if (p == end)
+    return p;
+
+  // Every varuint ends with the only byte without the high bit.
+  if (end[-1] & 128)
+    MYTHROW(ReadVarIntException, ());
+
+  size_t count = 0;
+  uint8_t const * q = p;
+  for (; end - q >= 8; q += 8)
+  {
+    uint64_t word;
+    std::memcpy(&word, q, sizeof(word));
+    count += bits::PopCount(~SwapIfBigEndianMacroBased(word) & ::impl::kVarUintStopBits);
+  }
+  for (; q != end; ++q)
+    count += (*q & 128) ? 0 : 1;
+
+  size_t const first = out.size();
+  out.resize(first + count);
+  uint64_t * const dst = out.data() + first;
+  uint8_t const * const res = ::impl::DecodeVarUints(p, end, dst, dst + count);
+
+  ASSERT_EQUAL(reinterpret_cast<uintptr_t>(res), reinterpret_cast<uintptr_t>(end), ());
+  return res;
+}
+
+/// Decodes |count| varuints from |pBeg| and appends them to |out|. The varuints may end before
+/// |pEnd|, which only bounds the readable memory (e.g. the end of a feature record), so the
+/// word-at-a-time decoding is used everywhere except the last bytes before |pEnd|.
+template <class Cont>
+void const * DecodeVarUint64Array(void const * pBeg, void const * pEnd, size_t count, Cont & out)
+{
+  uint8_t const * const p = static_cast<uint8_t const *>(pBeg);
+  uint8_t const * const end = static_cast<uint8_t const *>(pEnd);
+  ASSERT_LESS_OR_EQUAL(reinterpret_cast<uintptr_t>(p), reinterpret_cast<uintptr_t>(end), ());
+
+  size_t const first = out.size();
+  out.resize(first + count);
+  uint64_t * const dst = out.data() + first;
+  uint8_t const * const res = ::impl::DecodeVarUints(p, end, dst, dst + count);
+
+  ASSERT_LESS_OR_EQUAL(reinterpret_cast<uintptr_t>(res), reinterpret_cast<uintptr_t>(end), ());
+  return res;
+}
+
 template <class Cont, class Sink>
 void WriteVarUintArray(Cont const & v, Sink & sink)
 {
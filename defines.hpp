@@ -23,10 +23,13 @@
 #define ID2REL_EXT ".id2rel"
 
 #define CENTERS_FILE_TAG "centers"
+#define FEATURE_COLUMNS_FILE_TAG "feature_columns"
+#define FEATURES_BLOCKS_FILE_TAG "features_blocks"
 #define FEATURES_FILE_TAG "features"
 #define GEOMETRY_FILE_TAG "geom"
 #define TRIANGLE_FILE_TAG "trg"
 #define INDEX_FILE_TAG "idx"
+#define RTREE_INDEX_FILE_TAG "rtree"
 #define SEARCH_INDEX_FILE_TAG "sdx"
 
 // Feature -> Street, do not rename for compatibility.
@@ -98,6 +101,7 @@
 #define MAXSPEEDS_FILENAME "maxspeeds.csv"
 #define BOUNDARY_POSTCODES_FILENAME "boundary_postcodes.bin"
 #define CITY_BOUNDARIES_COLLECTOR_FILENAME "city_boundaries_collector.bin"
+#define CHANGED_COUNTRIES_FILENAME "changed_countries.txt"
 #define CROSS_MWM_OSM_WAYS_DIR "cross_mwm_osm_ways"
 #define TEMP_ADDR_EXTENSION ".tempaddr"
 
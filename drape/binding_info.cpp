@@ -28,6 +28,7 @@ bool BindingDecl::operator==(BindingDecl const & other) const
   return m_attributeName == other.m_attributeName &&
          m_componentCount == other.m_componentCount &&
          m_componentType == other.m_componentType &&
+         m_normalized == other.m_normalized &&
          m_stride == other.m_stride &&
          m_offset == other.m_offset;
 }
@@ -45,6 +46,8 @@ bool BindingDecl::operator<(BindingDecl const & other) const
     return m_componentCount < other.m_componentCount;
   if (m_componentType != other.m_componentType)
     return m_componentType < other.m_componentType;
+  if (m_normalized != other.m_normalized)
+    return m_normalized < other.m_normalized;
   if (m_stride != other.m_stride)
     return m_stride < other.m_stride;
   return m_offset < other.m_offset;
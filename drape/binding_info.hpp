@@ -20,6 +20,9 @@ struct BindingDecl
   glConst m_componentType;
   uint8_t m_stride;
   uint8_t m_offset;
+  // Integer components are converted to floats in shaders. If true, they are mapped
+  // to [0, 1] for unsigned types and to [-1, 1] for signed ones.
+  bool m_normalized = false;
 
   bool operator==(BindingDecl const & other) const;
   bool operator!=(BindingDecl const & other) const;
@@ -76,6 +79,23 @@ public:
     ++m_index;
   }
 
+  // Declares |componentCount| components of |componentType| which are packed into TFieldType.
+  template <typename TFieldType>
+  void FillPackedDecl(std::string const & attrName, uint8_t componentCount, glConst componentType,
+                      bool normalized)
+  {
+    dp::BindingDecl & decl = m_info.GetBindingDecl(static_cast<uint16_t>(m_index));
+    decl.m_attributeName = attrName;
+    decl.m_componentCount = componentCount;
+    decl.m_componentType = componentType;
+    decl.m_normalized = normalized;
+    decl.m_offset = m_offset;
+    decl.m_stride = sizeof(TVertex);
+
+    m_offset += sizeof(TFieldType);
+    ++m_index;
+  }
+
   dp::BindingInfo m_info;
 
 private:
@@ -62,6 +62,10 @@ void DataBuffer::MoveToGPU(ref_ptr<GraphicsContext> context, GPUBuffer::Target t
                                    m_impl->GetAvailableSize(), batcherHash);
     }
   }
+  else if (apiVersion == dp::ApiVersion::Invalid)
+  {
+    // Null graphics context, data stays in CPU memory.
+  }
   else
   {
     CHECK(false, ("Unsupported API version."));
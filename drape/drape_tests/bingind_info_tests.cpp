@@ -1,6 +1,10 @@
 #include "testing/testing.hpp"
 
 #include "drape/binding_info.hpp"
+#include "drape/utils/vertex_decl.hpp"
+
+#include <cmath>
+#include <cstdint>
 
 using namespace dp;
 
@@ -29,3 +33,49 @@ UNIT_TEST(DynamicHandlingTest)
     TEST_EQUAL(info.IsDynamic(), true, ());
   }
 }
+
+UNIT_TEST(PackedBindingDeclTest)
+{
+  struct Vertex
+  {
+    glsl::vec3 m_position;
+    uint32_t m_texCoord;
+  };
+
+  BindingFiller<Vertex> filler(2);
+  filler.FillDecl<glsl::vec3>("a_position");
+  filler.FillPackedDecl<uint32_t>("a_texCoord", 2 /* componentCount */, gl_const::GLUnsignedShortType,
+                                  true /* normalized */);
+
+  BindingInfo const & info = filler.m_info;
+  TEST_EQUAL(info.GetElementSize(), sizeof(Vertex), ());
+  TEST(!info.GetBindingDecl(0).m_normalized, ());
+
+  BindingDecl const & decl = info.GetBindingDecl(1);
+  TEST_EQUAL(decl.m_componentCount, 2, ());
+  TEST_EQUAL(decl.m_componentType, gl_const::GLUnsignedShortType, ());
+  TEST(decl.m_normalized, ());
+  TEST_EQUAL(decl.m_offset, sizeof(glsl::vec3), ());
+
+  // Bindings which differ in normalization only are different.
+  BindingInfo other = info;
+  other.GetBindingDecl(1).m_normalized = false;
+  TEST(other != info, ());
+  TEST((other < info) != (info < other), ());
+}
+
+UNIT_TEST(PackTexCoordTest)
+{
+  using gpu::BaseVertex;
+  TEST_EQUAL(BaseVertex::PackTexCoord({0.0f, 1.0f}), BaseVertex::TPackedTexCoord({0, 65535}), ());
+  TEST_EQUAL(BaseVertex::PackTexCoord({-0.5f, 1.5f}), BaseVertex::TPackedTexCoord({0, 65535}), ());
+
+  // Texel centers of a color texture are restored with a good enough precision.
+  float constexpr kTextureSize = 1024.0f;
+  for (float texel = 0.5f; texel < kTextureSize; texel += 1.0f)
+  {
+    float const u = texel / kTextureSize;
+    auto const packed = BaseVertex::PackTexCoord({u, u});
+    TEST_LESS(std::fabs(packed[0] / 65535.0f - u), 0.01f / kTextureSize, (texel));
+  }
+}
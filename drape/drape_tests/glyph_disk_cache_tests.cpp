@@ -0,0 +1,246 @@
+#include "testing/testing.hpp"
+
+#include "drape/glyph_disk_cache.hpp"
+#include "drape/glyph_manager.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace glyph_disk_cache_tests
+{
+using dp::Glyph;
+using dp::GlyphDiskCache;
+
+uint32_t constexpr kVersion = 1;
+
+std::string GetCachePath()
+{
+  return GetPlatform().TmpPathForFile("glyph_disk_cache_tests.sdfcache");
+}
+
+GlyphDiskCache::Key MakeKey(strings::UniChar code)
+{
+  GlyphDiskCache::Key key;
+  key.m_fontId = GlyphDiskCache::MakeFontId("font.ttf", 100500);
+  key.m_code = code;
+  key.m_pixelSize = 22;
+  return key;
+}
+
+Glyph MakeGlyph(strings::UniChar code, uint32_t width, uint32_t height)
+{
+  Glyph glyph;
+  glyph.m_metrics = {10.5f, 0.0f, -1.0f, 2.25f, true};
+  glyph.m_image.m_width = width;
+  glyph.m_image.m_height = height;
+  if (width * height != 0)
+  {
+    glyph.m_image.m_data = SharedBufferManager::instance().reserveSharedBuffer(width * height);
+    for (size_t i = 0; i < glyph.m_image.m_data->size(); ++i)
+      (*glyph.m_image.m_data)[i] = static_cast<uint8_t>(code + i);
+  }
+  glyph.m_fontIndex = 0;
+  glyph.m_code = code;
+  return glyph;
+}
+
+void TestGlyphsEqual(Glyph const & lhs, Glyph const & rhs)
+{
+  TEST_EQUAL(lhs.m_code, rhs.m_code, ());
+  TEST_EQUAL(lhs.m_metrics.m_xAdvance, rhs.m_metrics.m_xAdvance, ());
+  TEST_EQUAL(lhs.m_metrics.m_yAdvance, rhs.m_metrics.m_yAdvance, ());
+  TEST_EQUAL(lhs.m_metrics.m_xOffset, rhs.m_metrics.m_xOffset, ());
+  TEST_EQUAL(lhs.m_metrics.m_yOffset, rhs.m_metrics.m_yOffset, ());
+  TEST_EQUAL(lhs.m_metrics.m_isValid, rhs.m_metrics.m_isValid, ());
+  TEST_EQUAL(lhs.m_image.m_width, rhs.m_image.m_width, ());
+  TEST_EQUAL(lhs.m_image.m_height, rhs.m_image.m_height, ());
+  TEST_EQUAL(lhs.m_image.m_data == nullptr, rhs.m_image.m_data == nullptr, ());
+  if (lhs.m_image.m_data != nullptr)
+    TEST(*lhs.m_image.m_data == *rhs.m_image.m_data, ());
+}
+
+void TestFind(GlyphDiskCache const & cache, Glyph const & expected)
+{
+  Glyph glyph;
+  TEST(cache.Find(MakeKey(expected.m_code), glyph), (expected.m_code));
+  glyph.m_fontIndex = expected.m_fontIndex;
+  TestGlyphsEqual(glyph, expected);
+  glyph.m_image.Destroy();
+}
+
+UNIT_TEST(GlyphDiskCache_Smoke)
+{
+  auto const path = GetCachePath();
+  FileWriter::DeleteFileX(path);
+
+  auto glyphA = MakeGlyph('A', 16, 20);
+  auto glyphSpace = MakeGlyph(' ', 0, 0);
+  {
+    GlyphDiskCache cache(path, kVersion);
+    TEST_EQUAL(cache.GetGlyphsCount(), 0, ());
+
+    cache.Put(MakeKey(glyphA.m_code), glyphA);
+    cache.Put(MakeKey(glyphSpace.m_code), glyphSpace);
+    cache.Put(MakeKey(glyphA.m_code), glyphA);
+    TEST_EQUAL(cache.GetGlyphsCount(), 2, ());
+
+    // Glyphs are available before they are written.
+    TestFind(cache, glyphA);
+    TestFind(cache, glyphSpace);
+
+    Glyph glyph;
+    TEST(!cache.Find(MakeKey('B'), glyph), ());
+    auto key = MakeKey('A');
+    key.m_pixelSize = 20;
+    TEST(!cache.Find(key, glyph), ());
+  }
+
+  {
+    GlyphDiskCache cache(path, kVersion);
+    TEST_EQUAL(cache.GetGlyphsCount(), 2, ());
+    TestFind(cache, glyphA);
+    TestFind(cache, glyphSpace);
+
+    auto glyphB = MakeGlyph('B', 15, 21);
+    cache.Put(MakeKey(glyphB.m_code), glyphB);
+    glyphB.m_image.Destroy();
+  }
+
+  {
+    GlyphDiskCache cache(path, kVersion);
+    TEST_EQUAL(cache.GetGlyphsCount(), 3, ());
+    TestFind(cache, glyphA);
+  }
+
+  // Truncated record.
+  {
+    FileWriter writer(path, FileWriter::OP_APPEND);
+    uint32_t const garbage = 42;
+    writer.Write(&garbage, sizeof(garbage));
+  }
+  {
+    GlyphDiskCache cache(path, kVersion);
+    TEST_EQUAL(cache.GetGlyphsCount(), 0, ());
+    cache.Put(MakeKey(glyphA.m_code), glyphA);
+  }
+
+  // Glyphs of other rasterizer version are dropped.
+  {
+    GlyphDiskCache cache(path, kVersion + 1);
+    TEST_EQUAL(cache.GetGlyphsCount(), 0, ());
+  }
+
+  glyphA.m_image.Destroy();
+  FileWriter::DeleteFileX(path);
+}
+
+UNIT_TEST(GlyphDiskCache_FindWritten)
+{
+  auto const path = GetCachePath();
+  FileWriter::DeleteFileX(path);
+
+  auto glyphA = MakeGlyph('A', 16, 20);
+  auto glyphSpace = MakeGlyph(' ', 0, 0);
+  {
+    GlyphDiskCache cache(path, kVersion);
+    cache.Put(MakeKey(glyphA.m_code), glyphA);
+    cache.Put(MakeKey(glyphSpace.m_code), glyphSpace);
+    cache.Flush();
+
+    uint64_t fileSize = 0;
+    TEST(Platform::GetFileSizeByFullPath(path, fileSize), ());
+    TEST_EQUAL(cache.GetGlyphsCount(), 2, ());
+    TestFind(cache, glyphA);
+    TestFind(cache, glyphSpace);
+
+    // Glyphs which are put again (e.g. after the textures reset) are not written twice.
+    cache.Put(MakeKey(glyphA.m_code), glyphA);
+    cache.Flush();
+    uint64_t newFileSize = 0;
+    TEST(Platform::GetFileSizeByFullPath(path, newFileSize), ());
+    TEST_EQUAL(newFileSize, fileSize, ());
+
+    // New glyphs are found after the next writing too.
+    auto glyphB = MakeGlyph('B', 15, 21);
+    cache.Put(MakeKey(glyphB.m_code), glyphB);
+    cache.Flush();
+    TestFind(cache, glyphA);
+    TestFind(cache, glyphB);
+    glyphB.m_image.Destroy();
+  }
+
+  {
+    GlyphDiskCache cache(path, kVersion);
+    TEST_EQUAL(cache.GetGlyphsCount(), 3, ());
+    TestFind(cache, glyphA);
+  }
+
+  glyphA.m_image.Destroy();
+  FileWriter::DeleteFileX(path);
+}
+
+// Compares time of glyphs generation with and without the disk cache.
+UNIT_TEST(GlyphDiskCache_GlyphManagerBenchmark)
+{
+  auto const path = GetCachePath();
+  FileWriter::DeleteFileX(path);
+
+  auto const text = strings::MakeUniString(
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 .,-()"
+      "АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯабвгдеёжзийклмнопрстуфхцчшщъыьэюя"
+      "ÄÖÜäöüßÀÂÇÉÈÊËÎÏÔÛÙàâçéèêëîïôûùΑΒΓΔΕαβγδε東京北京서울");
+
+  auto const generate = [&text](std::string const & cachePath, std::vector<Glyph> & glyphs)
+  {
+    dp::GlyphManager::Params args;
+    args.m_uniBlocks = "unicode_blocks.txt";
+    args.m_whitelist = "fonts_whitelist.txt";
+    args.m_blacklist = "fonts_blacklist.txt";
+    GetPlatform().GetFontNames(args.m_fonts);
+    args.m_sdfCachePath = cachePath;
+    dp::GlyphManager mng(args);
+
+    base::Timer timer;
+    for (auto const c : text)
+      glyphs.push_back(mng.GetGlyph(c));
+    return timer.ElapsedMilliseconds();
+  };
+
+  std::vector<Glyph> expected;
+  auto const noCacheTime = generate({} /* cachePath */, expected);
+  std::vector<Glyph> coldCache;
+  auto const coldCacheTime = generate(path, coldCache);
+  std::vector<Glyph> warmCache;
+  auto const warmCacheTime = generate(path, warmCache);
+
+  LOG(LINFO, ("Glyphs:", text.size(), "no cache:", noCacheTime, "ms, cold cache:", coldCacheTime,
+              "ms, warm cache:", warmCacheTime, "ms"));
+
+  TEST_EQUAL(expected.size(), warmCache.size(), ());
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    TestGlyphsEqual(coldCache[i], expected[i]);
+    TestGlyphsEqual(warmCache[i], expected[i]);
+  }
+
+  for (auto * glyphs : {&expected, &coldCache, &warmCache})
+  {
+    // Image of the invalid glyph is shared.
+    for (auto & glyph : *glyphs)
+    {
+      if (glyph.m_metrics.m_isValid)
+        glyph.m_image.Destroy();
+    }
+  }
+  FileWriter::DeleteFileX(path);
+}
+}  // namespace glyph_disk_cache_tests
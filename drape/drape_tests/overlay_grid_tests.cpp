@@ -0,0 +1,186 @@
+#include "testing/testing.hpp"
+
+#include "drape/overlay_grid.hpp"
+#include "drape/overlay_tree.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/screenbase.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace overlay_grid_tests
+{
+using namespace dp;
+
+double constexpr kScreenWidth = 1080.0;
+double constexpr kScreenHeight = 1920.0;
+
+ScreenBase MakeScreen()
+{
+  m2::RectD const rect(0.0, 0.0, kScreenWidth, kScreenHeight);
+  // Default constructor initializes all the 3d parameters.
+  ScreenBase screen;
+  screen.OnSize(m2::RectI(rect));
+  screen.SetFromRect(m2::AnyRectD(rect));
+  return screen;
+}
+
+std::vector<std::unique_ptr<SquareHandle>> MakeHandles(size_t count, uint32_t seed)
+{
+  std::mt19937 rng(seed);
+  // Some handles are out of the screen.
+  std::uniform_real_distribution<double> x(-100.0, kScreenWidth + 100.0);
+  std::uniform_real_distribution<double> y(-100.0, kScreenHeight + 100.0);
+  std::uniform_real_distribution<double> size(10.0, 200.0);
+  std::uniform_int_distribution<uint64_t> priority(0, 1000);
+
+  std::vector<std::unique_ptr<SquareHandle>> handles;
+  handles.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    OverlayID const id(FeatureID(), kml::kInvalidMarkId, m2::PointI::Zero(), static_cast<uint32_t>(i));
+    handles.push_back(std::make_unique<SquareHandle>(id, dp::Center, m2::PointD(x(rng), y(rng)),
+                                                     m2::PointD(size(rng), size(rng) / 4),
+                                                     m2::PointD::Zero(), priority(rng), false /* isBound */,
+                                                     0 /* minVisibleScale */, false /* isBillboard */));
+  }
+  return handles;
+}
+
+struct HandleRectTraits
+{
+  m2::RectD const LimitRect(ref_ptr<OverlayHandle> const & handle) const
+  {
+    return handle->GetPixelRect(MakeScreen(), false /* perspective */);
+  }
+};
+
+UNIT_TEST(OverlayGrid_ForEachInRect)
+{
+  auto const screen = MakeScreen();
+  auto const handles = MakeHandles(2000, 1 /* seed */);
+
+  OverlayGrid grid;
+  grid.Reset(screen.PixelRectIn3d(), 48.0 /* cellSize */);
+  for (auto const & h : handles)
+    grid.Add(make_ref(h), h->GetPixelRect(screen, false /* perspective */));
+  TEST_EQUAL(grid.GetSize(), handles.size(), ());
+
+  // Erase every third handle.
+  for (size_t i = 0; i < handles.size(); i += 3)
+    grid.Erase(make_ref(handles[i]));
+  TEST_EQUAL(grid.GetSize(), handles.size() - (handles.size() + 2) / 3, ());
+
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<double> coord(-500.0, kScreenHeight + 500.0);
+  for (size_t i = 0; i < 200; ++i)
+  {
+    m2::RectD const rect(m2::PointD(coord(rng), coord(rng)), m2::PointD(coord(rng), coord(rng)));
+
+    std::vector<OverlayHandle *> expected;
+    for (size_t j = 0; j < handles.size(); ++j)
+    {
+      auto const r = handles[j]->GetPixelRect(screen, false /* perspective */);
+      bool const isOutside = r.maxX() <= rect.minX() || r.minX() >= rect.maxX() ||
+                             r.maxY() <= rect.minY() || r.minY() >= rect.maxY();
+      if (j % 3 != 0 && !isOutside)
+        expected.push_back(handles[j].get());
+    }
+
+    std::vector<OverlayHandle *> result;
+    grid.ForEachInRect(rect, [&result](ref_ptr<OverlayHandle> const & h) { result.push_back(h.get()); });
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(result.begin(), result.end());
+    TEST_EQUAL(result, expected, (rect));
+  }
+
+  grid.Clear();
+  TEST(grid.IsEmpty(), ());
+  size_t count = 0;
+  grid.ForEachInRect(screen.PixelRectIn3d(), [&count](ref_ptr<OverlayHandle> const &) { ++count; });
+  TEST_EQUAL(count, 0, ());
+}
+
+// Compares placement of 10k+ handles with the grid and queries of the grid and the k-d tree.
+UNIT_TEST(OverlayGrid_PlacementBenchmark)
+{
+  size_t constexpr kHandlesCount = 12000;
+  int constexpr kIterations = 10;
+
+  auto const screen = MakeScreen();
+  auto const handles = MakeHandles(kHandlesCount, 3 /* seed */);
+
+  OverlayTree tree(1.0 /* visualScale */);
+  base::Timer timer;
+  for (int i = 0; i < kIterations; ++i)
+  {
+    tree.InvalidateOnNextFrame();
+    tree.StartOverlayPlacing(screen, 17 /* zoomLevel */);
+    for (auto const & h : handles)
+      tree.Add(make_ref(h));
+    tree.EndOverlayPlacing();
+  }
+  auto const placementTime = timer.ElapsedMilliseconds();
+
+  // Placed handles don't intersect.
+  std::vector<ref_ptr<OverlayHandle>> placed(tree.GetHandlesCache().begin(), tree.GetHandlesCache().end());
+  TEST(!placed.empty(), ());
+  for (size_t i = 0; i < placed.size(); ++i)
+  {
+    TEST(placed[i]->IsVisible(), ());
+    for (size_t j = i + 1; j < placed.size(); ++j)
+      TEST(!placed[i]->IsIntersect(screen, placed[j]), ());
+  }
+
+  std::vector<m2::RectD> rects;
+  rects.reserve(handles.size());
+  for (auto const & h : handles)
+    rects.push_back(h->GetPixelRect(screen, false /* perspective */));
+
+  OverlayGrid grid;
+  m4::Tree<ref_ptr<OverlayHandle>, HandleRectTraits> kdTree;
+  timer.Reset();
+  for (int i = 0; i < kIterations; ++i)
+  {
+    grid.Reset(screen.PixelRectIn3d(), 48.0 /* cellSize */);
+    for (size_t j = 0; j < handles.size(); ++j)
+      grid.Add(make_ref(handles[j]), rects[j]);
+  }
+  auto const gridBuildTime = timer.ElapsedMilliseconds();
+
+  timer.Reset();
+  for (int i = 0; i < kIterations; ++i)
+  {
+    kdTree.Clear();
+    for (size_t j = 0; j < handles.size(); ++j)
+      kdTree.Add(make_ref(handles[j]), rects[j]);
+  }
+  auto const kdTreeBuildTime = timer.ElapsedMilliseconds();
+
+  size_t gridCount = 0;
+  timer.Reset();
+  for (auto const & rect : rects)
+    grid.ForEachInRect(rect, [&gridCount](ref_ptr<OverlayHandle> const &) { ++gridCount; });
+  auto const gridQueryTime = timer.ElapsedMilliseconds();
+
+  size_t kdTreeCount = 0;
+  timer.Reset();
+  for (auto const & rect : rects)
+    kdTree.ForEachInRect(rect, [&kdTreeCount](ref_ptr<OverlayHandle> const &) { ++kdTreeCount; });
+  auto const kdTreeQueryTime = timer.ElapsedMilliseconds();
+
+  TEST_EQUAL(gridCount, kdTreeCount, ());
+
+  LOG(LINFO, ("Handles:", kHandlesCount, "placed:", placed.size(), "placement:", placementTime / kIterations,
+              "ms; build grid:", gridBuildTime / kIterations, "ms, k-d tree:", kdTreeBuildTime / kIterations,
+              "ms; queries grid:", gridQueryTime, "ms, k-d tree:", kdTreeQueryTime, "ms"));
+}
+}  // namespace overlay_grid_tests
@@ -0,0 +1,199 @@
+#include "testing/testing.hpp"
+
+#include "drape/overlay_tree.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/screenbase.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace overlay_tree_tests
+{
+using namespace dp;
+
+using Handles = std::vector<std::unique_ptr<SquareHandle>>;
+
+double constexpr kScreenWidth = 1080.0;
+double constexpr kScreenHeight = 1920.0;
+uint8_t constexpr kZoomLevel = 17;
+
+ScreenBase MakeScreen()
+{
+  m2::RectD const rect(0.0, 0.0, kScreenWidth, kScreenHeight);
+  // Default constructor initializes all the 3d parameters.
+  ScreenBase screen;
+  screen.OnSize(m2::RectI(rect));
+  screen.SetFromRect(m2::AnyRectD(rect));
+  return screen;
+}
+
+std::unique_ptr<SquareHandle> MakeHandle(uint32_t index, m2::PointD const & pivot, m2::PointD const & size,
+                                         uint64_t priority)
+{
+  OverlayID const id(FeatureID(), kml::kInvalidMarkId, m2::PointI::Zero(), index);
+  return std::make_unique<SquareHandle>(id, dp::Center, pivot, size, m2::PointD::Zero(), priority,
+                                        false /* isBound */, 0 /* minVisibleScale */, false /* isBillboard */);
+}
+
+Handles MakeHandles(size_t count, uint32_t seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> x(-500.0, kScreenWidth + 500.0);
+  std::uniform_real_distribution<double> y(-500.0, kScreenHeight + 500.0);
+  std::uniform_real_distribution<double> size(10.0, 200.0);
+  std::uniform_int_distribution<uint64_t> priority(0, 1000);
+
+  Handles handles;
+  handles.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    handles.push_back(MakeHandle(static_cast<uint32_t>(i), m2::PointD(x(rng), y(rng)),
+                                 m2::PointD(size(rng), size(rng) / 4), priority(rng)));
+  }
+  return handles;
+}
+
+void Place(OverlayTree & tree, ScreenBase const & screen, Handles const & handles)
+{
+  tree.InvalidateOnNextFrame();
+  tree.StartOverlayPlacing(screen, kZoomLevel);
+  for (auto const & h : handles)
+  {
+    if (h)
+      tree.Add(make_ref(h));
+  }
+  tree.EndOverlayPlacing();
+}
+
+std::vector<OverlayHandle const *> GetVisible(Handles const & handles)
+{
+  std::vector<OverlayHandle const *> result;
+  for (auto const & h : handles)
+  {
+    if (h && h->IsVisible())
+      result.push_back(h.get());
+  }
+  return result;
+}
+
+void TestPlacement(OverlayTree const & tree, ScreenBase const & screen, Handles const & handles)
+{
+  auto const visible = GetVisible(handles);
+  TEST_EQUAL(visible.size(), tree.GetHandlesCache().size(), ());
+  for (auto const & h : tree.GetHandlesCache())
+    TEST(h->IsVisible(), ());
+
+  for (size_t i = 0; i < visible.size(); ++i)
+  {
+    for (size_t j = i + 1; j < visible.size(); ++j)
+      TEST(!visible[i]->IsIntersect(screen, make_ref(const_cast<OverlayHandle *>(visible[j]))), ());
+  }
+}
+
+UNIT_TEST(OverlayTree_IncrementalPanning)
+{
+  auto screen = MakeScreen();
+  auto const handles = MakeHandles(3000, 1 /* seed */);
+  auto const fullHandles = MakeHandles(3000, 1 /* seed */);
+
+  OverlayTree tree(1.0 /* visualScale */);
+  OverlayTree fullTree(1.0 /* visualScale */);
+  Place(tree, screen, handles);
+  Place(fullTree, screen, fullHandles);
+  TEST_EQUAL(GetVisible(handles).size(), GetVisible(fullHandles).size(), ());
+
+  // The same screen, nothing is changed.
+  auto const visible = GetVisible(handles);
+  Place(tree, screen, handles);
+  TEST_EQUAL(GetVisible(handles), visible, ());
+
+  for (int i = 0; i < 15; ++i)
+  {
+    screen.Move(7.0, -4.0);
+    Place(tree, screen, handles);
+    TestPlacement(tree, screen, handles);
+
+    fullTree.Clear();
+    Place(fullTree, screen, fullHandles);
+
+    // Incremental placing may keep some handles hidden, but it doesn't lose much.
+    auto const count = GetVisible(handles).size();
+    auto const fullCount = GetVisible(fullHandles).size();
+    TEST_GREATER_OR_EQUAL(count * 100, fullCount * 95, (count, fullCount));
+  }
+}
+
+UNIT_TEST(OverlayTree_IncrementalRemove)
+{
+  auto const screen = MakeScreen();
+
+  Handles handles;
+  handles.push_back(MakeHandle(0, {500.0, 500.0}, {100.0, 20.0}, 10 /* priority */));
+  handles.push_back(MakeHandle(1, {520.0, 505.0}, {100.0, 20.0}, 5 /* priority */));
+  handles.push_back(MakeHandle(2, {100.0, 1500.0}, {100.0, 20.0}, 1 /* priority */));
+
+  OverlayTree tree(1.0 /* visualScale */);
+  Place(tree, screen, handles);
+  TEST(handles[0]->IsVisible(), ());
+  TEST(!handles[1]->IsVisible(), ());
+  TEST(handles[2]->IsVisible(), ());
+
+  // Handle is removed with its tile, the displaced handle appears.
+  TEST(!tree.Remove(make_ref(handles[0])), ());
+  TEST(tree.IsNeedUpdate(), ());
+  handles[0].reset();
+  Place(tree, screen, handles);
+  TEST(handles[1]->IsVisible(), ());
+  TEST(handles[2]->IsVisible(), ());
+
+  // New handle with higher priority displaces the placed one.
+  handles.push_back(MakeHandle(3, {90.0, 1495.0}, {100.0, 20.0}, 20 /* priority */));
+  Place(tree, screen, handles);
+  TEST(handles[1]->IsVisible(), ());
+  TEST(!handles[2]->IsVisible(), ());
+  TEST(handles[3]->IsVisible(), ());
+  TestPlacement(tree, screen, handles);
+}
+
+// Compares placing of 10k+ handles from scratch and the incremental one on panning.
+UNIT_TEST(OverlayTree_PanningBenchmark)
+{
+  size_t constexpr kHandlesCount = 12000;
+  int constexpr kFramesCount = 30;
+
+  auto const handles = MakeHandles(kHandlesCount, 2 /* seed */);
+  auto const fullHandles = MakeHandles(kHandlesCount, 2 /* seed */);
+
+  OverlayTree tree(1.0 /* visualScale */);
+  OverlayTree fullTree(1.0 /* visualScale */);
+
+  auto screen = MakeScreen();
+  Place(tree, screen, handles);
+  base::Timer timer;
+  for (int i = 0; i < kFramesCount; ++i)
+  {
+    screen.Move(3.0, 2.0);
+    Place(tree, screen, handles);
+  }
+  auto const incrementalTime = timer.ElapsedMilliseconds();
+
+  screen = MakeScreen();
+  timer.Reset();
+  for (int i = 0; i < kFramesCount; ++i)
+  {
+    screen.Move(3.0, 2.0);
+    fullTree.Clear();
+    Place(fullTree, screen, fullHandles);
+  }
+  auto const fullTime = timer.ElapsedMilliseconds();
+
+  TestPlacement(tree, screen, handles);
+  LOG(LINFO, ("Handles:", kHandlesCount, "frames:", kFramesCount, "full placing:", fullTime,
+              "ms, incremental placing:", incrementalTime, "ms"));
+}
+}  // namespace overlay_tree_tests
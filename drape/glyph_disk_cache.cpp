@@ -0,0 +1,332 @@
+#include "drape/glyph_disk_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_writer.hpp"
+#include "coding/mmap_reader.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <tuple>
+#include <utility>
+
+namespace dp
+{
+namespace
+{
+uint32_t constexpr kMagic = 0x47464453;  // "SDFG"
+uint32_t constexpr kFileVersion = 1;
+uint64_t constexpr kHeaderSize = 3 * sizeof(uint32_t);
+// Font id, code, pixel size, 4 metrics, width, height and data size.
+uint64_t constexpr kRecordHeaderSize = sizeof(uint64_t) + 9 * sizeof(uint32_t);
+// Text of the whole world takes several thousands of glyphs, it's less than 10 Mb.
+uint64_t constexpr kMaxFileSize = 32 * 1024 * 1024;
+// New glyphs are usually requested in bursts, they are written together.
+auto constexpr kWriteDelay = std::chrono::seconds(2);
+
+uint32_t FloatToBits(float value)
+{
+  uint32_t bits;
+  static_assert(sizeof(bits) == sizeof(value));
+  std::memcpy(&bits, &value, sizeof(value));
+  return bits;
+}
+
+float BitsToFloat(uint32_t bits)
+{
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+}  // namespace
+
+bool GlyphDiskCache::Key::operator<(Key const & rhs) const
+{
+  return std::tie(m_fontId, m_code, m_pixelSize) < std::tie(rhs.m_fontId, rhs.m_code, rhs.m_pixelSize);
+}
+
+GlyphDiskCache::GlyphDiskCache(std::string const & filePath, uint32_t rasterizerVersion)
+  : m_filePath(filePath)
+  , m_rasterizerVersion(rasterizerVersion)
+{
+  if (Load())
+  {
+    LOG(LINFO, ("Glyphs cache is loaded, glyphs count:", m_index.size()));
+    return;
+  }
+
+  m_fileReader.reset();
+  m_index.clear();
+  Reset();
+}
+
+GlyphDiskCache::~GlyphDiskCache()
+{
+  m_writer.ShutdownAndJoin();
+  Write();
+}
+
+// static
+uint64_t GlyphDiskCache::MakeFontId(std::string const & fontName, uint64_t fontFileSize)
+{
+  // FNV-1a, std::hash is not guaranteed to be the same between runs.
+  uint64_t constexpr kOffsetBasis = 14695981039346656037ULL;
+  uint64_t constexpr kPrime = 1099511628211ULL;
+
+  uint64_t hash = kOffsetBasis;
+  for (char const c : fontName)
+    hash = (hash ^ static_cast<uint8_t>(c)) * kPrime;
+  for (size_t i = 0; i < sizeof(fontFileSize); ++i)
+    hash = (hash ^ ((fontFileSize >> (i * 8)) & 0xFF)) * kPrime;
+  return hash;
+}
+
+bool GlyphDiskCache::Find(Key const & key, Glyph & glyph) const
+{
+  std::lock_guard lock(m_mutex);
+
+  Entry const * entry = nullptr;
+  uint8_t const * data = nullptr;
+  if (auto const it = m_index.find(key); it != m_index.end())
+  {
+    entry = &it->second;
+    if (!entry->m_data.empty())
+      data = entry->m_data.data();
+    else if (entry->m_dataSize != 0)
+      data = m_fileReader->Data() + entry->m_dataOffset;
+  }
+  else
+  {
+    for (auto const * entries : {&m_pending, &m_writing})
+    {
+      if (auto const it = entries->find(key); it != entries->end())
+      {
+        entry = &it->second;
+        data = entry->m_data.data();
+        break;
+      }
+    }
+  }
+
+  if (entry == nullptr)
+    return false;
+
+  SharedBufferManager::shared_buffer_ptr_t image;
+  if (entry->m_dataSize != 0)
+  {
+    image = SharedBufferManager::instance().reserveSharedBuffer(entry->m_dataSize);
+    std::memcpy(image->data(), data, entry->m_dataSize);
+  }
+
+  glyph.m_metrics = entry->m_metrics;
+  glyph.m_image.m_width = entry->m_width;
+  glyph.m_image.m_height = entry->m_height;
+  glyph.m_image.m_data = std::move(image);
+  glyph.m_code = key.m_code;
+  return true;
+}
+
+void GlyphDiskCache::Put(Key const & key, Glyph const & glyph)
+{
+  ASSERT(glyph.m_metrics.m_isValid, ());
+
+  std::lock_guard lock(m_mutex);
+  if (!m_isWritable || m_index.count(key) != 0 || m_pending.count(key) != 0 || m_writing.count(key) != 0)
+    return;
+
+  Entry entry;
+  entry.m_metrics = glyph.m_metrics;
+  entry.m_width = glyph.m_image.m_width;
+  entry.m_height = glyph.m_image.m_height;
+  if (glyph.m_image.m_data != nullptr)
+  {
+    entry.m_data = *glyph.m_image.m_data;
+    entry.m_dataSize = static_cast<uint32_t>(entry.m_data.size());
+  }
+  m_pending.emplace(key, std::move(entry));
+
+  if (!m_writeScheduled)
+  {
+    m_writeScheduled = true;
+    m_writer.PushDelayed(kWriteDelay, [this]() { Write(); });
+  }
+}
+
+void GlyphDiskCache::Flush()
+{
+  std::promise<void> written;
+  if (m_writer.Push([this, &written]() { Write(); written.set_value(); }).m_isSuccess)
+    written.get_future().wait();
+}
+
+size_t GlyphDiskCache::GetGlyphsCount() const
+{
+  std::lock_guard lock(m_mutex);
+  return m_index.size() + m_pending.size() + m_writing.size();
+}
+
+bool GlyphDiskCache::Load()
+{
+  if (!Platform::IsFileExistsByFullPath(m_filePath))
+    return false;
+
+  try
+  {
+    m_fileReader = std::make_unique<MmapReader>(m_filePath, MmapReader::Advice::Random);
+    MemReader const reader(m_fileReader->Data(), m_fileReader->Size());
+    ReaderSource<MemReader> src(reader);
+    if (src.Size() < kHeaderSize || ReadPrimitiveFromSource<uint32_t>(src) != kMagic ||
+        ReadPrimitiveFromSource<uint32_t>(src) != kFileVersion ||
+        ReadPrimitiveFromSource<uint32_t>(src) != m_rasterizerVersion)
+    {
+      LOG(LINFO, ("Glyphs cache version is changed."));
+      return false;
+    }
+
+    while (src.Size() > 0)
+    {
+      if (src.Size() < kRecordHeaderSize)
+      {
+        LOG(LWARNING, ("Glyphs cache is truncated."));
+        return false;
+      }
+
+      Key key;
+      key.m_fontId = ReadPrimitiveFromSource<uint64_t>(src);
+      key.m_code = ReadPrimitiveFromSource<uint32_t>(src);
+      key.m_pixelSize = ReadPrimitiveFromSource<uint32_t>(src);
+
+      Entry entry;
+      entry.m_metrics.m_xAdvance = BitsToFloat(ReadPrimitiveFromSource<uint32_t>(src));
+      entry.m_metrics.m_yAdvance = BitsToFloat(ReadPrimitiveFromSource<uint32_t>(src));
+      entry.m_metrics.m_xOffset = BitsToFloat(ReadPrimitiveFromSource<uint32_t>(src));
+      entry.m_metrics.m_yOffset = BitsToFloat(ReadPrimitiveFromSource<uint32_t>(src));
+      entry.m_metrics.m_isValid = true;
+      entry.m_width = ReadPrimitiveFromSource<uint32_t>(src);
+      entry.m_height = ReadPrimitiveFromSource<uint32_t>(src);
+      entry.m_dataSize = ReadPrimitiveFromSource<uint32_t>(src);
+      if (src.Size() < entry.m_dataSize)
+      {
+        LOG(LWARNING, ("Glyphs cache is truncated."));
+        return false;
+      }
+
+      entry.m_dataOffset = src.Pos();
+      src.Skip(entry.m_dataSize);
+      m_index.emplace(key, std::move(entry));
+    }
+    m_fileSize = m_fileReader->Size();
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read glyphs cache", m_filePath, e.Msg()));
+    return false;
+  }
+  return true;
+}
+
+void GlyphDiskCache::Reset()
+{
+  try
+  {
+    FileWriter writer(m_filePath, FileWriter::OP_WRITE_TRUNCATE);
+    WriteToSink(writer, kMagic);
+    WriteToSink(writer, kFileVersion);
+    WriteToSink(writer, m_rasterizerVersion);
+    m_fileSize = kHeaderSize;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't create glyphs cache", m_filePath, e.Msg()));
+    m_isWritable = false;
+  }
+}
+
+void GlyphDiskCache::Write()
+{
+  {
+    std::lock_guard lock(m_mutex);
+    m_writeScheduled = false;
+    if (m_pending.empty())
+      return;
+    ASSERT(m_writing.empty(), ());
+    m_writing.swap(m_pending);
+  }
+
+  // Glyphs are read only on the writer thread, they are not changed until |m_writing| is cleared.
+  bool isWritable = true;
+  // Offsets of images of the written glyphs.
+  std::map<Key, uint64_t> written;
+  try
+  {
+    FileWriter writer(m_filePath, FileWriter::OP_APPEND);
+    for (auto const & [key, entry] : m_writing)
+    {
+      if (m_fileSize + kRecordHeaderSize + entry.m_dataSize > kMaxFileSize)
+      {
+        LOG(LINFO, ("Glyphs cache is full."));
+        isWritable = false;
+        break;
+      }
+
+      WriteToSink(writer, key.m_fontId);
+      WriteToSink(writer, static_cast<uint32_t>(key.m_code));
+      WriteToSink(writer, key.m_pixelSize);
+      WriteToSink(writer, FloatToBits(entry.m_metrics.m_xAdvance));
+      WriteToSink(writer, FloatToBits(entry.m_metrics.m_yAdvance));
+      WriteToSink(writer, FloatToBits(entry.m_metrics.m_xOffset));
+      WriteToSink(writer, FloatToBits(entry.m_metrics.m_yOffset));
+      WriteToSink(writer, entry.m_width);
+      WriteToSink(writer, entry.m_height);
+      WriteToSink(writer, entry.m_dataSize);
+      writer.Write(entry.m_data.data(), entry.m_data.size());
+      written.emplace(key, m_fileSize + kRecordHeaderSize);
+      m_fileSize += kRecordHeaderSize + entry.m_dataSize;
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't write glyphs cache", m_filePath, e.Msg()));
+    isWritable = false;
+    written.clear();
+  }
+
+  // The file is mapped again to find the written glyphs in it.
+  std::unique_ptr<MmapReader> fileReader;
+  if (!written.empty())
+  {
+    try
+    {
+      fileReader = std::make_unique<MmapReader>(m_filePath, MmapReader::Advice::Random);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't map glyphs cache", m_filePath, e.Msg()));
+      written.clear();
+    }
+  }
+
+  std::lock_guard lock(m_mutex);
+  if (fileReader)
+    m_fileReader = std::move(fileReader);
+
+  // Glyphs which are not written are kept in memory, so they are not rasterized and put again.
+  for (auto & [key, entry] : m_writing)
+  {
+    if (auto const it = written.find(key); it != written.end())
+    {
+      entry.m_dataOffset = it->second;
+      entry.m_data = {};
+    }
+    m_index.emplace(key, std::move(entry));
+  }
+  m_writing.clear();
+  if (!isWritable)
+    m_isWritable = false;
+}
+}  // namespace dp
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "drape/glyph.hpp"
+
+#include "base/string_utils.hpp"
+#include "base/thread_pool_delayed.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class MmapReader;
+
+namespace dp
+{
+/// Persistent cache of rasterized SDF glyphs, so glyphs are not rasterized by FreeType again
+/// after the application restart or the font textures reset.
+/// Glyphs of the previous runs are read from the memory mapped file, new glyphs are appended
+/// to the file on a background thread. The file is recreated if its version or the rasterizer
+/// version differs. The cache is thread-safe.
+class GlyphDiskCache
+{
+public:
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+
+    uint64_t m_fontId = 0;
+    strings::UniChar m_code = 0;
+    uint32_t m_pixelSize = 0;
+  };
+
+  /// @param rasterizerVersion Version of glyphs rasterization (FreeType version, SDF spread),
+  /// glyphs of other versions are dropped.
+  GlyphDiskCache(std::string const & filePath, uint32_t rasterizerVersion);
+  /// Writes all put glyphs.
+  ~GlyphDiskCache();
+
+  /// @return Stable id of the font, which changes with the font file.
+  static uint64_t MakeFontId(std::string const & fontName, uint64_t fontFileSize);
+
+  bool Find(Key const & key, Glyph & glyph) const;
+  void Put(Key const & key, Glyph const & glyph);
+  /// Writes put glyphs without the delay and waits for the writing.
+  void Flush();
+
+  size_t GetGlyphsCount() const;
+
+private:
+  struct Entry
+  {
+    GlyphMetrics m_metrics;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    // Offset and size of the image in the mapped file or in |m_data| if it is not empty.
+    uint64_t m_dataOffset = 0;
+    uint32_t m_dataSize = 0;
+    std::vector<uint8_t> m_data;
+  };
+
+  bool Load();
+  void Reset();
+  void Write();
+
+  std::string const m_filePath;
+  uint32_t const m_rasterizerVersion;
+
+  mutable std::mutex m_mutex;
+  std::unique_ptr<MmapReader> m_fileReader;
+  // Glyphs from the mapped file and glyphs which couldn't be written.
+  std::map<Key, Entry> m_index;
+  // Glyphs which are not written yet or are being written.
+  std::map<Key, Entry> m_pending;
+  std::map<Key, Entry> m_writing;
+  uint64_t m_fileSize = 0;
+  bool m_writeScheduled = false;
+  bool m_isWritable = true;
+
+  base::thread_pool::delayed::ThreadPool m_writer;
+};
+}  // namespace dp
@@ -2,6 +2,7 @@
 
 #include "drape/font_constants.hpp"
 #include "drape/glyph.hpp"
+#include "drape/glyph_disk_cache.hpp"
 
 #include "platform/platform.hpp"
 
@@ -141,6 +142,8 @@ public:
 
   bool IsValid() const { return m_fontFace && m_fontFace->num_glyphs > 0; }
 
+  uint64_t GetFileSize() const { return m_fontReader.Size(); }
+
   bool HasGlyph(strings::UniChar unicodePoint) const { return FT_Get_Char_Index(m_fontFace, unicodePoint) != 0; }
 
   Glyph GetGlyph(strings::UniChar unicodePoint, uint32_t glyphHeight) const
@@ -278,6 +281,7 @@ struct GlyphManager::Impl
 
   ~Impl()
   {
+    m_diskCache.reset();
     m_fonts.clear();
     if (m_library)
       FREETYPE_CHECK(FT_Done_FreeType(m_library));
@@ -287,6 +291,9 @@ struct GlyphManager::Impl
   TUniBlocks m_blocks;
   TUniBlockIter m_lastUsedBlock;
   std::vector<std::unique_ptr<Font>> m_fonts;
+  // Ids of |m_fonts| in |m_diskCache|.
+  std::vector<uint64_t> m_fontIds;
+  std::unique_ptr<GlyphDiskCache> m_diskCache;
 };
 
 // Destructor is defined where pimpl's destructor is already known.
@@ -319,6 +326,7 @@ GlyphManager::GlyphManager(Params const & params)
   });
 
   m_impl->m_fonts.reserve(params.m_fonts.size());
+  m_impl->m_fontIds.reserve(params.m_fonts.size());
 
   FREETYPE_CHECK(FT_Init_FreeType(&m_impl->m_library));
 
@@ -344,6 +352,7 @@ GlyphManager::GlyphManager(Params const & params)
     {
       m_impl->m_fonts.emplace_back(std::make_unique<Font>(GetPlatform().GetReader(fontName), m_impl->m_library));
       m_impl->m_fonts.back()->GetCharcodes(charCodes);
+      m_impl->m_fontIds.push_back(GlyphDiskCache::MakeFontId(fontName, m_impl->m_fonts.back()->GetFileSize()));
     }
     catch(RootException const & e)
     {
@@ -443,7 +452,14 @@ GlyphManager::GlyphManager(Params const & params)
     }
   }
 
-
+  if (!params.m_sdfCachePath.empty())
+  {
+    // Cached glyphs are dropped when FreeType or SDF parameters are changed.
+    FT_Int major, minor, patch;
+    FT_Library_Version(m_impl->m_library, &major, &minor, &patch);
+    auto const rasterizerVersion = static_cast<uint32_t>((major << 24) | (minor << 16) | (patch << 8) | kSdfBorder);
+    m_impl->m_diskCache = std::make_unique<GlyphDiskCache>(params.m_sdfCachePath, rasterizerVersion);
+  }
 }
 
 int GlyphManager::GetFontIndex(strings::UniChar unicodePoint)
@@ -509,9 +525,26 @@ Glyph GlyphManager::GetGlyph(strings::UniChar unicodePoint)
   if (fontIndex == kInvalidFont)
     return GetInvalidGlyph();
 
+  GlyphDiskCache::Key key;
+  if (m_impl->m_diskCache)
+  {
+    key.m_fontId = m_impl->m_fontIds[fontIndex];
+    key.m_code = unicodePoint;
+    key.m_pixelSize = kBaseFontSizePixels;
+
+    Glyph glyph;
+    if (m_impl->m_diskCache->Find(key, glyph))
+    {
+      glyph.m_fontIndex = fontIndex;
+      return glyph;
+    }
+  }
+
   auto const & f = m_impl->m_fonts[fontIndex];
   Glyph glyph = f->GetGlyph(unicodePoint, kBaseFontSizePixels);
   glyph.m_fontIndex = fontIndex;
+  if (m_impl->m_diskCache)
+    m_impl->m_diskCache->Put(key, glyph);
   return glyph;
 }
 
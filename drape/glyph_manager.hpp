@@ -24,6 +24,9 @@ public:
     std::string m_blacklist;
 
     std::vector<std::string> m_fonts;
+
+    // Full path of the persistent cache of rasterized glyphs, the cache is disabled if it's empty.
+    std::string m_sdfCachePath;
   };
 
   explicit GlyphManager(Params const & params);
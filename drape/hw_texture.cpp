@@ -261,6 +261,18 @@ void OpenGLHWTextureAllocator::Flush()
   GLFunctions::glFlush();
 }
 
+void NullHWTexture::Create(ref_ptr<dp::GraphicsContext> context, Params const & params,
+                           ref_ptr<void> data)
+{
+  Base::Create(context, params, data);
+}
+
+drape_ptr<HWTexture> NullHWTextureAllocator::CreateTexture(ref_ptr<dp::GraphicsContext> context)
+{
+  UNUSED_VALUE(context);
+  return make_unique_dp<NullHWTexture>();
+}
+
 drape_ptr<HWTextureAllocator> CreateAllocator(ref_ptr<dp::GraphicsContext> context)
 {
   CHECK(context != nullptr, ());
@@ -277,6 +289,9 @@ drape_ptr<HWTextureAllocator> CreateAllocator(ref_ptr<dp::GraphicsContext> conte
   if (apiVersion == dp::ApiVersion::Vulkan)
     return CreateVulkanAllocator();
 
+  if (apiVersion == dp::ApiVersion::Invalid)
+    return make_unique_dp<NullHWTextureAllocator>();
+
   if (apiVersion == dp::ApiVersion::OpenGLES3)
     return make_unique_dp<OpenGLHWTextureAllocator>();
 
@@ -303,6 +318,12 @@ ref_ptr<HWTextureAllocator> GetDefaultAllocator(ref_ptr<dp::GraphicsContext> con
   if (apiVersion == dp::ApiVersion::Vulkan)
     return GetDefaultVulkanAllocator();
 
+  if (apiVersion == dp::ApiVersion::Invalid)
+  {
+    static NullHWTextureAllocator s_nullAllocator;
+    return make_ref<HWTextureAllocator>(&s_nullAllocator);
+  }
+
   static OpenGLHWTextureAllocator s_allocator;
   return make_ref<HWTextureAllocator>(&s_allocator);
 }
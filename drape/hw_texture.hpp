@@ -101,6 +101,29 @@ public:
   void Flush() override;
 };
 
+// Texture without any GPU resource, it is used by NullGraphicsContext for headless
+// geometry generation. Uploaded data is ignored.
+class NullHWTexture : public HWTexture
+{
+  using Base = HWTexture;
+
+public:
+  void Create(ref_ptr<dp::GraphicsContext> context, Params const & params,
+              ref_ptr<void> data) override;
+  void UploadData(ref_ptr<dp::GraphicsContext> context, uint32_t x, uint32_t y,
+                  uint32_t width, uint32_t height, ref_ptr<void> data) override {}
+  void Bind(ref_ptr<dp::GraphicsContext> context) const override {}
+  void SetFilter(TextureFilter filter) override { m_params.m_filter = filter; }
+  bool Validate() const override { return true; }
+};
+
+class NullHWTextureAllocator : public HWTextureAllocator
+{
+public:
+  drape_ptr<HWTexture> CreateTexture(ref_ptr<dp::GraphicsContext> context) override;
+  void Flush() override {}
+};
+
 ref_ptr<HWTextureAllocator> GetDefaultAllocator(ref_ptr<dp::GraphicsContext> context);
 drape_ptr<HWTextureAllocator> CreateAllocator(ref_ptr<dp::GraphicsContext> context);
 
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "drape/graphics_context.hpp"
+
+namespace dp
+{
+// Graphics context without any graphics API. It reports ApiVersion::Invalid, so textures
+// and buffers are never moved to GPU. It allows to generate geometry without GPU,
+// e.g. in benchmarks.
+class NullGraphicsContext : public GraphicsContext
+{
+public:
+  void Present() override {}
+  void MakeCurrent() override {}
+  void SetFramebuffer(ref_ptr<BaseFramebuffer> framebuffer) override {}
+  void ForgetFramebuffer(ref_ptr<BaseFramebuffer> framebuffer) override {}
+  void ApplyFramebuffer(std::string const & framebufferLabel) override {}
+
+  void Init(ApiVersion apiVersion) override {}
+  ApiVersion GetApiVersion() const override { return ApiVersion::Invalid; }
+  std::string GetRendererName() const override { return "Null"; }
+  std::string GetRendererVersion() const override { return {}; }
+
+  void PushDebugLabel(std::string const & label) override {}
+  void PopDebugLabel() override {}
+
+  void SetClearColor(Color const & color) override {}
+  void Clear(uint32_t clearBits, uint32_t storeBits) override {}
+  void Flush() override {}
+  void SetViewport(uint32_t x, uint32_t y, uint32_t w, uint32_t h) override {}
+  void SetDepthTestEnabled(bool enabled) override {}
+  void SetDepthTestFunction(TestFunction depthFunction) override {}
+  void SetStencilTestEnabled(bool enabled) override {}
+  void SetStencilFunction(StencilFace face, TestFunction stencilFunction) override {}
+  void SetStencilActions(StencilFace face, StencilAction stencilFailAction,
+                         StencilAction depthFailAction, StencilAction passAction) override {}
+  void SetStencilReferenceValue(uint32_t stencilReferenceValue) override {}
+};
+}  // namespace dp
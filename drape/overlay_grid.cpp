@@ -0,0 +1,124 @@
+#include "drape/overlay_grid.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dp
+{
+namespace
+{
+// Limits memory and time of clearing for huge screens or tiny cells.
+uint32_t constexpr kMaxCellsCount = 128;
+}  // namespace
+
+void OverlayGrid::Reset(m2::RectD const & rect, double cellSize)
+{
+  ASSERT_GREATER(cellSize, 0.0, ());
+  Clear();
+
+  auto const getCellsCount = [cellSize](double size)
+  {
+    return static_cast<uint32_t>(std::clamp(std::ceil(size / cellSize), 1.0, static_cast<double>(kMaxCellsCount)));
+  };
+
+  m_origin = rect.LeftBottom();
+  m_width = getCellsCount(rect.SizeX());
+  m_height = getCellsCount(rect.SizeY());
+  m_invCellSizeX = rect.SizeX() > 0.0 ? m_width / rect.SizeX() : 0.0;
+  m_invCellSizeY = rect.SizeY() > 0.0 ? m_height / rect.SizeY() : 0.0;
+
+  // Cells are cleared, not reallocated, if the grid size is not changed.
+  m_cells.resize(m_width * m_height);
+}
+
+void OverlayGrid::Clear()
+{
+  if (m_items.empty())
+    return;
+
+  for (auto & cell : m_cells)
+    cell.clear();
+  m_items.clear();
+  m_indices.clear();
+  m_queryStamps.clear();
+  m_handlesCount = 0;
+}
+
+void OverlayGrid::Shift(m2::PointD const & offset)
+{
+  if (m_handlesCount == 0 || offset.IsAlmostZero())
+    return;
+
+  m_shiftedItems.clear();
+  for (auto const & item : m_items)
+  {
+    if (item.m_handle == nullptr)
+      continue;
+    m_shiftedItems.push_back(item);
+    m_shiftedItems.back().m_rect.Offset(offset);
+  }
+
+  Clear();
+  for (auto const & item : m_shiftedItems)
+    Add(item.m_handle, item.m_rect);
+}
+
+void OverlayGrid::Add(ref_ptr<OverlayHandle> const & handle, m2::RectD const & rect)
+{
+  ASSERT(handle != nullptr, ());
+  auto const index = static_cast<uint32_t>(m_items.size());
+  auto const [_, isInserted] = m_indices.emplace(handle.get(), index);
+  CHECK(isInserted, ("Overlay handle is added twice."));
+
+  m_items.push_back({handle, rect});
+  m_queryStamps.push_back(0);
+  ++m_handlesCount;
+
+  CellsRect const cells = GetCells(rect);
+  for (uint32_t y = cells.m_minY; y <= cells.m_maxY; ++y)
+  {
+    for (uint32_t x = cells.m_minX; x <= cells.m_maxX; ++x)
+      m_cells[y * m_width + x].push_back(index);
+  }
+}
+
+void OverlayGrid::Erase(ref_ptr<OverlayHandle> const & handle)
+{
+  auto const it = m_indices.find(handle.get());
+  if (it == m_indices.end())
+    return;
+
+  // Indices in cells are kept, erased items are skipped on queries.
+  m_items[it->second].m_handle = nullptr;
+  m_indices.erase(it);
+  --m_handlesCount;
+}
+
+OverlayGrid::CellsRect OverlayGrid::GetCells(m2::RectD const & rect) const
+{
+  return {GetCell(rect.minX(), m_origin.x, m_invCellSizeX, m_width),
+          GetCell(rect.minY(), m_origin.y, m_invCellSizeY, m_height),
+          GetCell(rect.maxX(), m_origin.x, m_invCellSizeX, m_width),
+          GetCell(rect.maxY(), m_origin.y, m_invCellSizeY, m_height)};
+}
+
+uint32_t OverlayGrid::GetCell(double coord, double origin, double invCellSize, uint32_t cellsCount) const
+{
+  double const cell = std::floor((coord - origin) * invCellSize);
+  if (!(cell > 0.0))
+    return 0;
+  return std::min(static_cast<uint32_t>(std::min(cell, static_cast<double>(cellsCount))), cellsCount - 1);
+}
+
+void OverlayGrid::NextQueryStamp() const
+{
+  ++m_queryStamp;
+  if (m_queryStamp == 0)
+  {
+    std::fill(m_queryStamps.begin(), m_queryStamps.end(), 0);
+    m_queryStamp = 1;
+  }
+}
+}  // namespace dp
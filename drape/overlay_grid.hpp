@@ -0,0 +1,102 @@
+#pragma once
+
+#include "drape/overlay_handle.hpp"
+#include "drape/pointers.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace dp
+{
+// Spatial index of the placed overlays. It's a uniform grid over the screen, handles outside
+// of the screen are put to the border cells. Handles and cells are stored in flat arrays,
+// their storage is reused between placements, so a placement doesn't allocate memory
+// when the screen is moved slightly.
+class OverlayGrid
+{
+public:
+  // Splits |rect| into cells of about |cellSize| and removes all handles.
+  void Reset(m2::RectD const & rect, double cellSize);
+  void Clear();
+  // Moves all handles by |offset| keeping the cells.
+  void Shift(m2::PointD const & offset);
+
+  void Add(ref_ptr<OverlayHandle> const & handle, m2::RectD const & rect);
+  void Erase(ref_ptr<OverlayHandle> const & handle);
+
+  bool IsEmpty() const { return m_handlesCount == 0; }
+  size_t GetSize() const { return m_handlesCount; }
+
+  // Calls |toDo| once for every handle which rect intersects |rect|.
+  template <typename ToDo>
+  void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    if (m_handlesCount == 0)
+      return;
+
+    NextQueryStamp();
+    CellsRect const cells = GetCells(rect);
+    for (uint32_t y = cells.m_minY; y <= cells.m_maxY; ++y)
+    {
+      for (uint32_t x = cells.m_minX; x <= cells.m_maxX; ++x)
+      {
+        for (uint32_t const index : m_cells[y * m_width + x])
+        {
+          Item const & item = m_items[index];
+          if (item.m_handle == nullptr || m_queryStamps[index] == m_queryStamp)
+            continue;
+
+          m_queryStamps[index] = m_queryStamp;
+          if (IsIntersect(item.m_rect, rect))
+            toDo(item.m_handle);
+        }
+      }
+    }
+  }
+
+private:
+  struct Item
+  {
+    ref_ptr<OverlayHandle> m_handle;
+    m2::RectD m_rect;
+  };
+
+  struct CellsRect
+  {
+    uint32_t m_minX;
+    uint32_t m_minY;
+    uint32_t m_maxX;
+    uint32_t m_maxY;
+  };
+
+  // The same check as in m4::Tree, touching rects don't intersect.
+  static bool IsIntersect(m2::RectD const & r1, m2::RectD const & r2)
+  {
+    return !(r1.maxX() <= r2.minX() || r1.minX() >= r2.maxX() ||
+             r1.maxY() <= r2.minY() || r1.minY() >= r2.maxY());
+  }
+
+  CellsRect GetCells(m2::RectD const & rect) const;
+  uint32_t GetCell(double coord, double origin, double invCellSize, uint32_t cellsCount) const;
+  void NextQueryStamp() const;
+
+  m2::PointD m_origin = m2::PointD::Zero();
+  double m_invCellSizeX = 1.0;
+  double m_invCellSizeY = 1.0;
+  uint32_t m_width = 1;
+  uint32_t m_height = 1;
+
+  std::vector<std::vector<uint32_t>> m_cells = std::vector<std::vector<uint32_t>>(1);
+  std::vector<Item> m_items;
+  std::vector<Item> m_shiftedItems;
+  std::unordered_map<OverlayHandle const *, uint32_t> m_indices;
+  size_t m_handlesCount = 0;
+
+  // Every handle may be found in several cells, query stamps filter out duplicates.
+  mutable std::vector<uint32_t> m_queryStamps;
+  mutable uint32_t m_queryStamp = 0;
+};
+}  // namespace dp
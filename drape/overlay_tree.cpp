@@ -3,7 +3,10 @@
 #include "drape/constants.hpp"
 #include "drape/debug_renderer.hpp"
 
+#include "base/math.hpp"
+
 #include <algorithm>
+#include <cmath>
 
 namespace dp
 {
@@ -15,6 +18,17 @@ uint32_t const kMaxHandlesCount = 1000;
 
 size_t const kAverageHandlesCount[dp::OverlayRanksCount] = { 300, 200, 50 };
 int const kInvalidFrame = -1;
+// Size of overlays grid cells in pixels, it's about the size of a short caption.
+double const kGridCellSize = 48.0;
+
+// Handles which are moved less than this distance in pixels are not placed again.
+double const kChangedRectThreshold = 2.0;
+// It's cheaper to place all handles again if there are too many changes.
+size_t const kMaxDirtyRectsCount = 128;
+// A displaced handle frees a place for other handles, such chains are followed for several steps.
+int const kMaxIncrementalSteps = 3;
+// Chains of changes are cut, so placings from scratch are interleaved with the incremental ones.
+uint32_t const kMaxIncrementalPlacingsCount = 20;
 
 namespace
 {
@@ -73,6 +87,35 @@ public:
 private:
   bool m_enableMask;
 };
+
+bool GetScreenShift(ScreenBase const & from, ScreenBase const & to, m2::PointD & shift)
+{
+  if (from.PixelRectIn3d() != to.PixelRectIn3d() || from.isPerspective() != to.isPerspective())
+    return false;
+
+  // Perspective projection is not shift invariant.
+  if (from.isPerspective())
+  {
+    shift = m2::PointD::Zero();
+    return from == to && from.GetRotationAngle() == to.GetRotationAngle();
+  }
+
+  double constexpr kEps = 1e-9;
+  if (!base::AlmostEqualRel(from.GetScale(), to.GetScale(), kEps) ||
+      !base::AlmostEqualAbs(from.GetAngle(), to.GetAngle(), kEps))
+  {
+    return false;
+  }
+
+  shift = to.GtoP(from.GetOrg()) - from.GtoP(from.GetOrg());
+  return true;
+}
+
+bool IsRectChanged(m2::RectD const & r1, m2::RectD const & r2, double threshold)
+{
+  return std::abs(r1.minX() - r2.minX()) > threshold || std::abs(r1.minY() - r2.minY()) > threshold ||
+         std::abs(r1.maxX() - r2.maxX()) > threshold || std::abs(r1.maxY() - r2.maxY()) > threshold;
+}
 }  // namespace
 
 OverlayTree::OverlayTree(double visualScale)
@@ -88,18 +131,23 @@ OverlayTree::OverlayTree(double visualScale)
 void OverlayTree::SetVisualScale(double visualScale)
 {
   m_traits.SetVisualScale(visualScale);
+  m_canPlaceIncrementally = false;
   InvalidateOnNextFrame();
 }
 
 void OverlayTree::Clear()
 {
   InvalidateOnNextFrame();
-  TBase::Clear();
+  m_grid.Clear();
   m_handlesCache.clear();
   m_overlayIdCache.clear();
   for (auto & handles : m_handles)
     handles.clear();
   m_displacers.clear();
+  m_prevCandidates.clear();
+  m_candidates.clear();
+  m_removedRects.clear();
+  m_canPlaceIncrementally = false;
 }
 
 bool OverlayTree::Frame()
@@ -139,19 +187,65 @@ void OverlayTree::InvalidateOnNextFrame()
 void OverlayTree::StartOverlayPlacing(ScreenBase const & screen, uint8_t zoomLevel)
 {
   ASSERT(IsNeedUpdate(), ());
-  TBase::Clear();
-  m_handlesCache.clear();
-  m_overlayIdCache.clear();
+  m_isIncrementalPlacing = m_canPlaceIncrementally && zoomLevel == m_zoomLevel &&
+                           m_incrementalPlacingsCount < kMaxIncrementalPlacingsCount &&
+                           GetScreenShift(GetModelView(), screen, m_screenShift);
+
   m_traits.SetModelView(screen);
   m_displacementInfo.clear();
   m_zoomLevel = zoomLevel;
+
+  if (m_isIncrementalPlacing)
+  {
+    m_grid.Shift(m_screenShift);
+  }
+  else
+  {
+    ResetPlacing();
+    m_grid.Reset(m_traits.GetExtendedScreenRect(), kGridCellSize * m_traits.GetVisualScale());
+  }
+}
+
+void OverlayTree::ResetPlacing()
+{
+  m_grid.Clear();
+  m_handlesCache.clear();
+  m_overlayIdCache.clear();
+  m_prevCandidates.clear();
+  m_removedRects.clear();
+  m_deletedHandles.clear();
+  m_canPlaceIncrementally = false;
+  m_isIncrementalPlacing = false;
+  m_incrementalPlacingsCount = 0;
 }
 
 bool OverlayTree::Remove(ref_ptr<OverlayHandle> handle)
 {
+  // The placing is kept, so removed handles must be deleted one by one.
+  if (m_canPlaceIncrementally)
+  {
+    auto const it = m_prevCandidates.find(handle);
+    if (it != m_prevCandidates.end())
+    {
+      m_removedRects.push_back(it->second);
+      m_prevCandidates.erase(it);
+    }
+    m_displacers.erase(handle);
+
+    if (IsInCache(handle))
+    {
+      DeleteHandle(handle);
+      m_dirtyRects.clear();
+      DeleteOrphans();
+      m_removedRects.insert(m_removedRects.end(), m_dirtyRects.begin(), m_dirtyRects.end());
+      InvalidateOnNextFrame();
+    }
+    return false;
+  }
+
   if (m_frameCounter == kInvalidFrame)
   {
-    if (!IsEmpty())
+    if (!m_grid.IsEmpty())
       Clear();
     return true;
   }
@@ -179,10 +273,6 @@ void OverlayTree::Add(ref_ptr<OverlayHandle> handle)
 
   handle->EnableCaching(true);
 
-  // Skip duplicates.
-  if (IsInCache(handle))
-    return;
-
   // Skip not-ready handles.
   if (!handle->Update(modelView))
   {
@@ -206,6 +296,10 @@ void OverlayTree::Add(ref_ptr<OverlayHandle> handle)
     return;
   }
 
+  // Skip duplicates.
+  if (!m_candidates.emplace(handle, pixelRect).second)
+    return;
+
   ASSERT_GREATER_OR_EQUAL(handle->GetOverlayRank(), 0, ());
   size_t const rank = static_cast<size_t>(handle->GetOverlayRank());
   ASSERT_LESS(rank, m_handles.size(), ());
@@ -233,7 +327,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
   {
     m_handlesCache.insert(handle);
     m_overlayIdCache[handle->GetOverlayID()].push_back(handle);
-    TBase::Add(handle, pixelRect);
+    m_grid.Add(handle, pixelRect);
     return;
   }
 
@@ -242,7 +336,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
 
   // Find elements that already on OverlayTree and it's pixel rect
   // intersect with handle pixel rect ("Intersected elements").
-  ForEachInRect(pixelRect, [&] (ref_ptr<OverlayHandle> const & h)
+  m_grid.ForEachInRect(pixelRect, [&] (ref_ptr<OverlayHandle> const & h)
   {
     bool const isParent = (h == parentOverlay) ||
                           (h->GetOverlayID() == handle->GetOverlayID() &&
@@ -328,31 +422,25 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
 
   m_handlesCache.insert(handle);
   m_overlayIdCache[handle->GetOverlayID()].push_back(handle);
-  TBase::Add(handle, pixelRect);
+  m_grid.Add(handle, pixelRect);
 }
 
 void OverlayTree::EndOverlayPlacing()
 {
   ASSERT(IsNeedUpdate(), ());
 
-  m_displacers.clear();
-
 #ifdef DEBUG_OVERLAYS_OUTPUT
   LOG(LINFO, ("- BEGIN OVERLAYS PLACING"));
 #endif
 
-  HandleComparator comparator(false /* enableMask */);
-
-  for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+  if (m_isIncrementalPlacing && PlaceChangedHandles())
   {
-    std::sort(m_handles[rank].begin(), m_handles[rank].end(), comparator);
-
-    for (auto const & handle : m_handles[rank])
-    {
-      ref_ptr<OverlayHandle> parentOverlay;
-      if (CheckHandle(handle, rank, parentOverlay))
-        InsertHandle(handle, rank, parentOverlay);
-    }
+    ++m_incrementalPlacingsCount;
+  }
+  else
+  {
+    ResetPlacing();
+    PlaceAllHandles();
   }
 
   for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
@@ -369,6 +457,11 @@ void OverlayTree::EndOverlayPlacing()
     handle->EnableCaching(false);
   }
 
+  m_prevCandidates.swap(m_candidates);
+  m_candidates.clear();
+  m_removedRects.clear();
+  m_isIncrementalPlacing = false;
+  m_canPlaceIncrementally = true;
   m_frameCounter = 0;
 
 #ifdef DEBUG_OVERLAYS_OUTPUT
@@ -376,6 +469,155 @@ void OverlayTree::EndOverlayPlacing()
 #endif
 }
 
+void OverlayTree::PlaceAllHandles()
+{
+  m_displacers.clear();
+
+  HandleComparator comparator(false /* enableMask */);
+
+  for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+  {
+    std::sort(m_handles[rank].begin(), m_handles[rank].end(), comparator);
+
+    for (auto const & handle : m_handles[rank])
+    {
+      ref_ptr<OverlayHandle> parentOverlay;
+      if (CheckHandle(handle, rank, parentOverlay))
+        InsertHandle(handle, rank, parentOverlay);
+    }
+  }
+}
+
+bool OverlayTree::PlaceChangedHandles()
+{
+  ScreenBase const & modelView = GetModelView();
+  double const threshold = kChangedRectThreshold * m_traits.GetVisualScale();
+
+  // Find rects where the placing may change. Handles of the previous placing are moved
+  // with the screen, so only the handles moved relative to the map are changed.
+  m_dirtyRects.clear();
+  for (auto rect : m_removedRects)
+  {
+    rect.Offset(m_screenShift);
+    m_dirtyRects.push_back(rect);
+  }
+
+  buffer_vector<ref_ptr<OverlayHandle>, 16> changedHandles;
+  for (auto const & [handle, rect] : m_prevCandidates)
+  {
+    if (m_candidates.find(handle) != m_candidates.end())
+      continue;
+
+    // Handle is out of the screen or is not ready.
+    m_dirtyRects.push_back(rect);
+    m_dirtyRects.back().Offset(m_screenShift);
+    if (IsInCache(handle))
+      changedHandles.push_back(handle);
+  }
+
+  for (auto const & [handle, rect] : m_candidates)
+  {
+    auto const it = m_prevCandidates.find(handle);
+    if (it == m_prevCandidates.end())
+    {
+      m_dirtyRects.push_back(rect);
+      continue;
+    }
+
+    m2::RectD prevRect = it->second;
+    prevRect.Offset(m_screenShift);
+    if (IsRectChanged(prevRect, rect, threshold))
+    {
+      m_dirtyRects.push_back(prevRect);
+      m_dirtyRects.push_back(rect);
+      if (IsInCache(handle))
+        changedHandles.push_back(handle);
+    }
+  }
+
+  if (m_dirtyRects.size() > kMaxDirtyRectsCount)
+    return false;
+
+  for (auto const & handle : changedHandles)
+    DeleteHandle(handle);
+  DeleteOrphans();
+
+  HandleComparator comparator(false /* enableMask */);
+  std::array<std::vector<ref_ptr<OverlayHandle>>, dp::OverlayRanksCount> handlesToPlace;
+  for (int step = 0; step < kMaxIncrementalSteps && !m_dirtyRects.empty(); ++step)
+  {
+    bool hasHandlesToPlace = false;
+    for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+    {
+      auto & handles = handlesToPlace[rank];
+      handles.clear();
+      for (auto const & handle : m_handles[rank])
+      {
+        if (IsInCache(handle))
+          continue;
+
+        m2::RectD const pixelRect = handle->GetExtendedPixelRect(modelView);
+        for (auto const & rect : m_dirtyRects)
+        {
+          if (rect.IsIntersect(pixelRect))
+          {
+            handles.push_back(handle);
+            break;
+          }
+        }
+      }
+      hasHandlesToPlace |= !handles.empty();
+    }
+    m_dirtyRects.clear();
+
+    if (!hasHandlesToPlace)
+      break;
+
+    for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+    {
+      std::sort(handlesToPlace[rank].begin(), handlesToPlace[rank].end(), comparator);
+      for (auto const & handle : handlesToPlace[rank])
+      {
+        ref_ptr<OverlayHandle> parentOverlay;
+        if (CheckHandle(handle, rank, parentOverlay))
+          InsertHandle(handle, rank, parentOverlay);
+      }
+    }
+
+    // Places of displaced handles are checked on the next step.
+    DeleteOrphans();
+  }
+
+  return true;
+}
+
+void OverlayTree::DeleteOrphans()
+{
+  // Children of deleted handles are deleted too, their rects become dirty.
+  // Deleted children are appended, so the loop goes through all generations.
+  for (size_t i = 0; i < m_deletedHandles.size(); ++i)
+  {
+    auto const handle = m_deletedHandles[i];
+    m_dirtyRects.push_back(handle->GetExtendedPixelRect(GetModelView()));
+
+    auto const it = m_overlayIdCache.find(handle->GetOverlayID());
+    if (it == m_overlayIdCache.end())
+      continue;
+
+    buffer_vector<ref_ptr<OverlayHandle>, 4> orphans;
+    for (auto const & h : it->second)
+    {
+      int const rank = h->GetOverlayRank();
+      if (rank > handle->GetOverlayRank() && FindParent(h, rank - 1) == nullptr)
+        orphans.push_back(h);
+    }
+
+    for (auto const & h : orphans)
+      DeleteHandle(h);
+  }
+  m_deletedHandles.clear();
+}
+
 bool OverlayTree::CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                               ref_ptr<OverlayHandle> & parentOverlay) const
 {
@@ -405,7 +647,9 @@ bool OverlayTree::DeleteHandleImpl(ref_ptr<OverlayHandle> handle)
 {
   if (m_handlesCache.erase(handle) > 0)
   {
-    Erase(handle);
+    m_grid.Erase(handle);
+    if (m_canPlaceIncrementally || m_isIncrementalPlacing)
+      m_deletedHandles.push_back(handle);
     return true;
   }
   return false;
@@ -491,7 +735,7 @@ void OverlayTree::Select(m2::PointD const & glbPoint, TOverlayContainer & result
 void OverlayTree::Select(m2::RectD const & rect, TOverlayContainer & result) const
 {
   ScreenBase screen = GetModelView();
-  ForEachInRect(rect, [&](ref_ptr<OverlayHandle> const & h)
+  m_grid.ForEachInRect(rect, [&](ref_ptr<OverlayHandle> const & h)
   {
     ASSERT(h->GetOverlayID().IsValid(), ());
 
@@ -516,12 +760,16 @@ void OverlayTree::SetDisplacementEnabled(bool enabled)
   if (m_isDisplacementEnabled == enabled)
     return;
   m_isDisplacementEnabled = enabled;
+  m_canPlaceIncrementally = false;
   InvalidateOnNextFrame();
 }
 
 void OverlayTree::SetSelectedFeature(FeatureID const & featureID)
 {
+  if (m_selectedFeatureID == featureID)
+    return;
   m_selectedFeatureID = featureID;
+  m_canPlaceIncrementally = false;
 }
 
 OverlayTree::TDisplacementInfo const & OverlayTree::GetDisplacementInfo() const
@@ -1,15 +1,17 @@
 #pragma once
 
 #include "drape/drape_diagnostics.hpp"
+#include "drape/overlay_grid.hpp"
 #include "drape/overlay_handle.hpp"
 
 #include "geometry/screenbase.hpp"
-#include "geometry/tree4d.hpp"
 
 #include "base/buffer_vector.hpp"
 
 #include <array>
+#include <map>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -20,13 +22,10 @@ namespace detail
 class OverlayTraits
 {
 public:
-  m2::RectD const LimitRect(ref_ptr<OverlayHandle> const & handle)
-  {
-    return handle->GetExtendedPixelRect(m_modelView);
-  }
   ScreenBase const & GetModelView() const { return m_modelView; }
   m2::RectD const & GetExtendedScreenRect() const { return m_extendedScreenRect; }
   m2::RectD const & GetDisplacersFreeRect() const { return m_displacersFreeRect; }
+  double GetVisualScale() const { return m_visualScale; }
 
   void SetVisualScale(double visualScale);
   void SetModelView(ScreenBase const & modelView);
@@ -53,10 +52,11 @@ class DebugRenderer;
 
 using TOverlayContainer = buffer_vector<ref_ptr<OverlayHandle>, 8>;
 
-class OverlayTree : public m4::Tree<ref_ptr<OverlayHandle>, detail::OverlayTraits>
+// Placement of overlays with displacement by priorities. If the screen is only moved without
+// changing of zoom level, the previous placement is kept and only changed handles and handles
+// around them are placed again.
+class OverlayTree
 {
-  using TBase = m4::Tree<ref_ptr<OverlayHandle>, detail::OverlayTraits>;
-
 public:
   using HandlesCache = std::unordered_set<ref_ptr<OverlayHandle>, detail::OverlayHasher>;
 
@@ -101,7 +101,14 @@ public:
   void SetDebugRectRenderer(ref_ptr<DebugRenderer> debugRectRenderer);
 
 private:
+  using HandlesRects = std::unordered_map<ref_ptr<OverlayHandle>, m2::RectD, detail::OverlayHasher>;
+
   ScreenBase const & GetModelView() const { return m_traits.GetModelView(); }
+  void ResetPlacing();
+  void PlaceAllHandles();
+  //! \return false if there are too many changes and all handles must be placed again.
+  bool PlaceChangedHandles();
+  void DeleteOrphans();
   void InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                     ref_ptr<OverlayHandle> const & parentOverlay);
   bool CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
@@ -117,6 +124,9 @@ private:
 
   bool IsInCache(ref_ptr<OverlayHandle> const & handle) const;
 
+  detail::OverlayTraits m_traits;
+  OverlayGrid m_grid;
+
   int m_frameCounter;
   std::array<std::vector<ref_ptr<OverlayHandle>>, dp::OverlayRanksCount> m_handles;
 
@@ -139,5 +149,18 @@ private:
   HandlesCache m_displacers;
   uint32_t m_frameUpdatePeriod;
   uint8_t m_zoomLevel = 1;
+
+  // Handles which were added on the previous and the current placing and their rects.
+  HandlesRects m_prevCandidates;
+  HandlesRects m_candidates;
+  // Rects of the handles removed after the previous placing.
+  std::vector<m2::RectD> m_removedRects;
+  bool m_canPlaceIncrementally = false;
+  bool m_isIncrementalPlacing = false;
+  uint32_t m_incrementalPlacingsCount = 0;
+  // Offset of the previous placing in pixels.
+  m2::PointD m_screenShift;
+  std::vector<m2::RectD> m_dirtyRects;
+  std::vector<ref_ptr<OverlayHandle>> m_deletedHandles;
 };
 }  // namespace dp
@@ -1,5 +1,9 @@
 #include "drape/utils/vertex_decl.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace gpu
 {
 namespace
@@ -33,11 +37,13 @@ typedef dp::BindingInfo (*TInitFunction)();
 dp::BindingInfo AreaBindingInit()
 {
   static_assert(sizeof(AreaVertex) == (sizeof(AreaVertex::TPosition) +
-                                       sizeof(AreaVertex::TTexCoord)), "");
+                                       sizeof(AreaVertex::TPackedTexCoord)), "");
 
   dp::BindingFiller<AreaVertex> filler(2);
   filler.FillDecl<AreaVertex::TPosition>("a_position");
-  filler.FillDecl<AreaVertex::TTexCoord>("a_colorTexCoords");
+  filler.FillPackedDecl<AreaVertex::TPackedTexCoord>("a_colorTexCoords", 2 /* componentCount */,
+                                                     gl_const::GLUnsignedShortType,
+                                                     true /* normalized */);
 
   return filler.m_info;
 }
@@ -138,11 +144,13 @@ dp::BindingInfo LineBindingInit()
 {
   static_assert(sizeof(LineVertex) == sizeof(LineVertex::TPosition) +
                                       sizeof(LineVertex::TNormal) +
-                                      sizeof(LineVertex::TTexCoord), "");
+                                      sizeof(LineVertex::TPackedTexCoord), "");
   dp::BindingFiller<LineVertex> filler(3);
   filler.FillDecl<LineVertex::TPosition>("a_position");
   filler.FillDecl<LineVertex::TNormal>("a_normal");
-  filler.FillDecl<LineVertex::TTexCoord>("a_colorTexCoord");
+  filler.FillPackedDecl<LineVertex::TPackedTexCoord>("a_colorTexCoord", 2 /* componentCount */,
+                                                     gl_const::GLUnsignedShortType,
+                                                     true /* normalized */);
 
   return filler.m_info;
 }
@@ -238,7 +246,22 @@ dp::BindingInfo const & GetBinding(VertexType type)
 }
 }  // namespace
 
+// static
+BaseVertex::TPackedTexCoord BaseVertex::PackTexCoord(TTexCoord const & texCoord)
+{
+  auto const pack = [](float v)
+  {
+    float constexpr kMax = std::numeric_limits<uint16_t>::max();
+    return static_cast<uint16_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * kMax));
+  };
+  return {pack(texCoord.x), pack(texCoord.y)};
+}
+
 AreaVertex::AreaVertex(TPosition const & position, TTexCoord const & colorTexCoord)
+  : AreaVertex(position, PackTexCoord(colorTexCoord))
+{}
+
+AreaVertex::AreaVertex(TPosition const & position, TPackedTexCoord const & colorTexCoord)
   : m_position(position)
   , m_colorTexCoord(colorTexCoord)
 {}
@@ -326,6 +349,11 @@ uint32_t TextDynamicVertex::GetDynamicStreamID()
 }
 
 LineVertex::LineVertex(TPosition const & position, TNormal const & normal, TTexCoord const & color)
+  : LineVertex(position, normal, PackTexCoord(color))
+{}
+
+LineVertex::LineVertex(TPosition const & position, TNormal const & normal,
+                       TPackedTexCoord const & color)
   : m_position(position)
   , m_normal(normal)
   , m_colorTexCoord(color)
@@ -5,6 +5,9 @@
 
 #include "base/buffer_vector.hpp"
 
+#include <array>
+#include <cstdint>
+
 namespace gpu
 {
 
@@ -15,6 +18,11 @@ struct BaseVertex
   using TNormal = glsl::vec2;
   using TNormal3d = glsl::vec3;
   using TTexCoord = glsl::vec2;
+  // Texture coordinates in [0, 1] packed into normalized 16-bit integers. They are unpacked
+  // by vertex fetch, so shaders take them as usual floats.
+  using TPackedTexCoord = std::array<uint16_t, 2>;
+
+  static TPackedTexCoord PackTexCoord(TTexCoord const & texCoord);
 };
 
 template <class T> using VBUnknownSizeT = buffer_vector<T, 128>;
@@ -24,9 +32,15 @@ struct AreaVertex : BaseVertex
 {
   AreaVertex() = default;
   AreaVertex(TPosition const & position, TTexCoord const & colorTexCoord);
+  AreaVertex(TPosition const & position, TPackedTexCoord const & colorTexCoord);
 
+  // Positions are not packed yet. Packing them needs three things:
+  // - xy as 16-bit integers relative to the tile with the tile size in a uniform, because local
+  //   coordinates (kShapeCoordScalar) of all tiles share one scale;
+  // - depth as a separate float attribute, so new programs for GL, Metal and Vulkan;
+  // - a regenerated data/vulkan_shaders pack.
   TPosition m_position;
-  TTexCoord m_colorTexCoord;
+  TPackedTexCoord m_colorTexCoord;
 
   static dp::BindingInfo const & GetBindingInfo();
 };
@@ -128,14 +142,15 @@ using TTextDynamicVertexBuffer = VBReservedSizeT<TextDynamicVertex>;
 
 struct LineVertex : BaseVertex
 {
-  using TNormal = glsl::vec3;
-
   LineVertex() = default;
   LineVertex(TPosition const & position, TNormal const & normal, TTexCoord const & color);
+  LineVertex(TPosition const & position, TNormal const & normal, TPackedTexCoord const & color);
 
+  // Not packed, see AreaVertex::m_position.
   TPosition m_position;
+  // Line shaders use only xy of a_normal, so z is not stored.
   TNormal m_normal;
-  TTexCoord m_colorTexCoord;
+  TPackedTexCoord m_colorTexCoord;
 
   static dp::BindingInfo const & GetBindingInfo();
 };
@@ -98,8 +98,8 @@ public:
         assert(attributeLocation != -1);
         GLFunctions::glEnableVertexAttribute(attributeLocation);
         GLFunctions::glVertexAttributePointer(attributeLocation, decl.m_componentCount,
-                                              decl.m_componentType, false, decl.m_stride,
-                                              decl.m_offset);
+                                              decl.m_componentType, decl.m_normalized,
+                                              decl.m_stride, decl.m_offset);
       }
     }
   }
@@ -351,6 +351,17 @@ uint32_t VertexArrayBuffer::GetDynamicBufferOffset(BindingInfo const & bindingIn
 
 uint32_t VertexArrayBuffer::GetIndexCount() const { return GetIndexBuffer()->GetCurrentSize(); }
 
+uint32_t VertexArrayBuffer::GetVertexDataSize() const
+{
+  uint32_t size = 0;
+  for (auto const * buffers : {&m_staticBuffers, &m_dynamicBuffers})
+  {
+    for (auto const & [bindingInfo, buffer] : *buffers)
+      size += buffer->GetBuffer()->GetCurrentSize() * bindingInfo.GetElementSize();
+  }
+  return size;
+}
+
 void VertexArrayBuffer::UploadIndices(ref_ptr<GraphicsContext> context, void const * data,
                                       uint32_t count)
 {
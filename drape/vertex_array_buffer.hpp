@@ -73,6 +73,8 @@ public:
   uint32_t GetStartIndexValue() const;
   uint32_t GetDynamicBufferOffset(BindingInfo const & bindingInfo);
   uint32_t GetIndexCount() const;
+  // Size of vertices of all streams in bytes.
+  uint32_t GetVertexDataSize() const;
 
   void UploadData(ref_ptr<GraphicsContext> context, BindingInfo const & bindingInfo,
                   void const * data, uint32_t count);
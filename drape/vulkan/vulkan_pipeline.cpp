@@ -67,8 +67,55 @@ VkStencilOp DecodeStencilAction(uint8_t stencilActionByte)
   UNREACHABLE();
 }
 
-VkFormat GetAttributeFormat(uint8_t componentCount, glConst componentType)
+VkFormat GetAttributeFormat(uint8_t componentCount, glConst componentType, bool normalized)
 {
+  if (normalized)
+  {
+    if (componentType == gl_const::GLByteType)
+    {
+      switch (componentCount)
+      {
+      case 1: return VK_FORMAT_R8_SNORM;
+      case 2: return VK_FORMAT_R8G8_SNORM;
+      case 3: return VK_FORMAT_R8G8B8_SNORM;
+      case 4: return VK_FORMAT_R8G8B8A8_SNORM;
+      }
+    }
+    else if (componentType == gl_const::GLUnsignedByteType)
+    {
+      switch (componentCount)
+      {
+      case 1: return VK_FORMAT_R8_UNORM;
+      case 2: return VK_FORMAT_R8G8_UNORM;
+      case 3: return VK_FORMAT_R8G8B8_UNORM;
+      case 4: return VK_FORMAT_R8G8B8A8_UNORM;
+      }
+    }
+    else if (componentType == gl_const::GLShortType)
+    {
+      switch (componentCount)
+      {
+      case 1: return VK_FORMAT_R16_SNORM;
+      case 2: return VK_FORMAT_R16G16_SNORM;
+      case 3: return VK_FORMAT_R16G16B16_SNORM;
+      case 4: return VK_FORMAT_R16G16B16A16_SNORM;
+      }
+    }
+    else if (componentType == gl_const::GLUnsignedShortType)
+    {
+      switch (componentCount)
+      {
+      case 1: return VK_FORMAT_R16_UNORM;
+      case 2: return VK_FORMAT_R16G16_UNORM;
+      case 3: return VK_FORMAT_R16G16B16_UNORM;
+      case 4: return VK_FORMAT_R16G16B16A16_UNORM;
+      }
+    }
+
+    CHECK(false, ("Unsupported normalized attribute format.", componentCount, componentType));
+    return VK_FORMAT_UNDEFINED;
+  }
+
   if (componentType == gl_const::GLFloatType)
   {
     switch (componentCount)
@@ -356,7 +403,8 @@ VkPipeline VulkanPipeline::GetPipeline(VkDevice device, PipelineKey const & key)
       attributeDescriptions[bindingCounter].location = bindingCounter;
       attributeDescriptions[bindingCounter].binding = static_cast<uint32_t>(i);
       attributeDescriptions[bindingCounter].format = GetAttributeFormat(bindingDecl.m_componentCount,
-                                                                        bindingDecl.m_componentType);
+                                                                        bindingDecl.m_componentType,
+                                                                        bindingDecl.m_normalized);
       attributeDescriptions[bindingCounter].offset = bindingDecl.m_offset;
 
       bindingCounter++;
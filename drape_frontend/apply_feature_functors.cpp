@@ -772,14 +772,21 @@ void ApplyAreaFeature::ProcessRule(AreaRuleProto const & areaRule, double areaDe
 
 ApplyLineFeatureGeometry::ApplyLineFeatureGeometry(TileKey const & tileKey, TInsertShapeFn const & insertShape,
                                                    FeatureType & f, double currentScaleGtoP)
+  : ApplyLineFeatureGeometry(tileKey, insertShape, f, currentScaleGtoP, m2::SharedSpline())
+{
+  m_spline.Reset(new m2::Spline(f.GetPointsCount()));
+}
+
+ApplyLineFeatureGeometry::ApplyLineFeatureGeometry(TileKey const & tileKey, TInsertShapeFn const & insertShape,
+                                                   FeatureType & f, double currentScaleGtoP,
+                                                   m2::SharedSpline const & spline)
   : TBase(tileKey, insertShape, f, CaptionDescription())
+  , m_spline(spline)
   , m_currentScaleGtoP(currentScaleGtoP)
   // TODO(pastk) : calculate just once in the RuleDrawer.
   , m_minSegmentSqrLength(base::Pow2(4.0 * df::VisualParams::Instance().GetVisualScale() / currentScaleGtoP))
   , m_simplify(tileKey.m_zoomLevel >= 10 && tileKey.m_zoomLevel <= 12)
-{
-  m_spline.Reset(new m2::Spline(f.GetPointsCount()));
-}
+{}
 
 void ApplyLineFeatureGeometry::operator() (m2::PointD const & point)
 {
@@ -1017,7 +1024,8 @@ void ApplyLineFeatureAdditional::ProcessAdditionalLineRules(PathTextRuleProto co
                                                             ShieldRuleProto const * shieldRule,
                                                             ref_ptr<dp::TextureManager> texMng,
                                                             ftypes::RoadShieldsSetT const & roadShields,
-                                                            GeneratedRoadShields & generatedRoadShields)
+                                                            GeneratedRoadShields & generatedRoadShields,
+                                                            std::mutex & generatedRoadShieldsMutex)
 {
   ASSERT(pathtextRule || shieldRule, ());
 
@@ -1106,12 +1114,15 @@ void ApplyLineFeatureAdditional::ProcessAdditionalLineRules(PathTextRuleProto co
     GetRoadShieldsViewParams(texMng, shield, shieldIndex, static_cast<uint8_t>(roadShields.size()),
                              textParams, symbolParams, poiParams, shieldPixelSize);
 
-    auto & generatedShieldRects = generatedRoadShields[shield];
-    generatedShieldRects.reserve(10);
     for (auto const & shieldPos : shieldPositions)
     {
-      if (!CheckShieldsNearby(shieldPos, shieldPixelSize, scaledMinDistance, generatedShieldRects))
-        continue;
+      {
+        std::lock_guard lock(generatedRoadShieldsMutex);
+        auto & generatedShieldRects = generatedRoadShields[shield];
+        generatedShieldRects.reserve(10);
+        if (!CheckShieldsNearby(shieldPos, shieldPixelSize, scaledMinDistance, generatedShieldRects))
+          continue;
+      }
 
       m_insertShape(make_unique_dp<TextShape>(shieldPos, textParams, m_tileKey,
                                               m2::PointF(0.0f, 0.0f) /* symbolSize */,
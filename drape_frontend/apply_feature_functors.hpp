@@ -15,6 +15,7 @@
 #include "geometry/spline.hpp"
 
 #include <functional>
+#include <mutex>
 #include <vector>
 
 class CaptionDefProto;
@@ -144,11 +145,15 @@ class ApplyLineFeatureGeometry : public BaseApplyFeature
 public:
   ApplyLineFeatureGeometry(TileKey const & tileKey, TInsertShapeFn const & insertShape,
                            FeatureType & f, double currentScaleGtoP);
+  // Uses already decoded and simplified |spline| of the feature, points must not be added.
+  ApplyLineFeatureGeometry(TileKey const & tileKey, TInsertShapeFn const & insertShape,
+                           FeatureType & f, double currentScaleGtoP, m2::SharedSpline const & spline);
 
   void operator() (m2::PointD const & point);
   bool HasGeometry() const { return m_spline->IsValid(); }
   void ProcessLineRules(Stylist::LineRulesT const & lineRules);
 
+  m2::SharedSpline const & GetSpline() const { return m_spline; }
   std::vector<m2::SharedSpline> const & GetClippedSplines() const { return m_clippedSplines; }
 
 private:
@@ -176,9 +181,12 @@ public:
                              FeatureType & f, double currentScaleGtoP, CaptionDescription const & captions,
                              std::vector<m2::SharedSpline> && clippedSplines);
 
+  /// @param generatedRoadShieldsMutex Guards |generatedRoadShields|, which may be shared by
+  /// features of the same tile processed in parallel.
   void ProcessAdditionalLineRules(PathTextRuleProto const * pathtextRule, ShieldRuleProto const * shieldRule,
                                   ref_ptr<dp::TextureManager> texMng, ftypes::RoadShieldsSetT const & roadShields,
-                                  GeneratedRoadShields & generatedRoadShields);
+                                  GeneratedRoadShields & generatedRoadShields,
+                                  std::mutex & generatedRoadShieldsMutex);
 
 private:
   void GetRoadShieldsViewParams(ref_ptr<dp::TextureManager> texMng,
@@ -22,6 +22,14 @@ AreaShape::AreaShape(std::vector<m2::PointD> triangleList, BuildingOutline && bu
   , m_params(params)
 {}
 
+size_t AreaShape::GetMemorySize() const
+{
+  return sizeof(AreaShape) + m_vertexes.size() * sizeof(m2::PointD) +
+         m_buildingOutline.m_vertices.size() * sizeof(m2::PointD) +
+         m_buildingOutline.m_indices.size() * sizeof(int) +
+         m_buildingOutline.m_normals.size() * sizeof(m2::PointD);
+}
+
 void AreaShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
                      ref_ptr<dp::TextureManager> textures) const
 {
@@ -49,7 +57,7 @@ void AreaShape::DrawArea(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batch
                          m2::PointD const & colorUv, m2::PointD const & outlineUv,
                          ref_ptr<dp::Texture> texture) const
 {
-  glsl::vec2 const uv = glsl::ToVec2(colorUv);
+  auto const uv = gpu::AreaVertex::PackTexCoord(glsl::ToVec2(colorUv));
 
   gpu::VBReservedSizeT<gpu::AreaVertex> vertexes;
   vertexes.reserve(m_vertexes.size());
@@ -68,7 +76,7 @@ void AreaShape::DrawArea(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batch
   // Generate outline.
   if (m_buildingOutline.m_generateOutline && !m_buildingOutline.m_indices.empty())
   {
-    glsl::vec2 const ouv = glsl::ToVec2(outlineUv);
+    auto const ouv = gpu::AreaVertex::PackTexCoord(glsl::ToVec2(outlineUv));
 
     gpu::VBReservedSizeT<gpu::AreaVertex> vertices;
     vertices.reserve(m_buildingOutline.m_vertices.size());
@@ -165,7 +173,7 @@ void AreaShape::DrawArea3D(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Bat
   // Generate outline.
   if (m_buildingOutline.m_generateOutline)
   {
-    glsl::vec2 const ouv = glsl::ToVec2(outlineUv);
+    auto const ouv = gpu::AreaVertex::PackTexCoord(glsl::ToVec2(outlineUv));
 
     auto outlineState = CreateRenderState(gpu::Program::Area3dOutline, DepthLayer::Geometry3dLayer);
     outlineState.SetDepthTestEnabled(m_params.m_depthTestEnabled);
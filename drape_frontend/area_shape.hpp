@@ -29,6 +29,7 @@ public:
 
   void Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
             ref_ptr<dp::TextureManager> textures) const override;
+  size_t GetMemorySize() const override;
 
 private:
   glsl::vec2 ToShapeVertex2(m2::PointD const & vertex) const
@@ -35,7 +35,7 @@ BackendRenderer::BackendRenderer(Params && params)
   , m_model(params.m_model)
   , m_readManager(make_unique_dp<ReadManager>(params.m_commutator, m_model,
                                               params.m_allow3dBuildings, params.m_trafficEnabled,
-                                              params.m_isolinesEnabled))
+                                              params.m_isolinesEnabled, params.m_shapesCacheSizeBytes))
   , m_transitBuilder(make_unique_dp<TransitSchemeBuilder>(
         std::bind(&BackendRenderer::FlushTransitRenderData, this, _1)))
   , m_trafficGenerator(make_unique_dp<TrafficGenerator>(
@@ -235,7 +235,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().StartShapesGeneration();
 #endif
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
+        for (auto const & shape : msg->GetShapes())
         {
           batcher->SetFeatureMinZoom(shape->GetFeatureMinZoom());
           shape->Draw(m_context, batcher, m_texMng);
@@ -260,7 +260,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
         DrapeMeasurer::Instance().StartOverlayShapesGeneration();
 #endif
         OverlayBatcher batcher(tileKey);
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
+        for (auto const & shape : msg->GetShapes())
           batcher.Batch(m_context, shape, m_texMng);
 
         TOverlaysRenderData renderData;
@@ -743,9 +743,9 @@ void BackendRenderer::InitContextDependentResources()
   // Increase this value for big features.
   uint32_t constexpr kBatchSize = 5000;
 
-  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(kReadingThreadsCount,
-                                               std::bind(&BackendRenderer::FlushGeometry, this, _1, _2, _3),
-                                               kBatchSize, kBatchSize);
+  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(
+      static_cast<int>(GetReadingThreadsCount()), std::bind(&BackendRenderer::FlushGeometry, this, _1, _2, _3),
+      kBatchSize, kBatchSize);
   m_trafficGenerator->Init();
 
   dp::TextureManager::Params params;
@@ -762,6 +762,7 @@ void BackendRenderer::InitContextDependentResources()
   params.m_glyphMngParams.m_whitelist = "fonts_whitelist.txt";
   params.m_glyphMngParams.m_blacklist = "fonts_blacklist.txt";
   GetPlatform().GetFontNames(params.m_glyphMngParams.m_fonts);
+  params.m_glyphMngParams.m_sdfCachePath = GetPlatform().TmpPathForFile("glyphs.sdfcache");
   if (m_arrow3dCustomDecl.has_value())
   {
     params.m_arrowTexturePath = m_arrow3dCustomDecl->m_arrowMeshTexturePath;
@@ -44,7 +44,7 @@ public:
            MapDataProvider const & model, TUpdateCurrentCountryFn const & updateCurrentCountryFn,
            ref_ptr<RequestedTiles> requestedTiles, bool allow3dBuildings, bool trafficEnabled,
            bool isolinesEnabled, bool simplifiedTrafficColors,
-           std::optional<Arrow3dCustomDecl> arrow3dCustomDecl,
+           std::optional<Arrow3dCustomDecl> arrow3dCustomDecl, size_t shapesCacheSizeBytes,
            OnGraphicsContextInitialized const & onGraphicsContextInitialized)
       : BaseRenderer::Params(apiVersion, commutator, factory, texMng, onGraphicsContextInitialized)
       , m_model(model)
@@ -55,6 +55,7 @@ public:
       , m_isolinesEnabled(isolinesEnabled)
       , m_simplifiedTrafficColors(simplifiedTrafficColors)
       , m_arrow3dCustomDecl(std::move(arrow3dCustomDecl))
+      , m_shapesCacheSizeBytes(shapesCacheSizeBytes)
     {}
 
     MapDataProvider const & m_model;
@@ -65,6 +66,7 @@ public:
     bool m_isolinesEnabled;
     bool m_simplifiedTrafficColors;
     std::optional<Arrow3dCustomDecl> m_arrow3dCustomDecl;
+    size_t m_shapesCacheSizeBytes;
   };
 
   explicit BackendRenderer(Params && params);
@@ -92,6 +92,11 @@ ColoredSymbolShape::ColoredSymbolShape(m2::PointD const & mercatorPt,
   , m_overlaySizes(overlaySizes)
 {}
 
+size_t ColoredSymbolShape::GetMemorySize() const
+{
+  return sizeof(ColoredSymbolShape) + m_overlaySizes.size() * sizeof(m2::PointF);
+}
+
 void ColoredSymbolShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
                               ref_ptr<dp::TextureManager> textures) const
 {
@@ -18,6 +18,7 @@ public:
 
   void Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
             ref_ptr<dp::TextureManager> textures) const override;
+  size_t GetMemorySize() const override;
   MapShapeType GetType() const override { return MapShapeType::OverlayType; }
 
 private:
@@ -20,6 +20,10 @@ namespace
 {
 std::string const kLocationStateMode = "LastLocationStateMode";
 std::string const kLastEnterBackground = "LastEnterBackground";
+std::string const kTileShapesCacheSizeMB = "TileShapesCacheSizeMB";
+
+// About a dozen of dense city tiles.
+uint32_t constexpr kDefaultTileShapesCacheSizeMB = 32;
 }
 
 DrapeEngine::DrapeEngine(Params && params)
@@ -52,6 +56,10 @@ DrapeEngine::DrapeEngine(Params && params)
   if (!settings::Get(kLastEnterBackground, m_startBackgroundTime))
     m_startBackgroundTime = base::Timer::LocalTime();
 
+  // Shapes of read tiles are cached unless the setting is 0.
+  uint32_t shapesCacheSizeMB = kDefaultTileShapesCacheSizeMB;
+  settings::TryGet(kTileShapesCacheSizeMB, shapesCacheSizeMB);
+
   std::vector<PostprocessRenderer::Effect> effects;
 
 //  bool enabledAntialiasing;
@@ -94,7 +102,7 @@ DrapeEngine::DrapeEngine(Params && params)
       params.m_model, params.m_model.UpdateCurrentCountryFn(), make_ref(m_requestedTiles),
       params.m_allow3dBuildings, params.m_trafficEnabled, params.m_isolinesEnabled,
       params.m_simplifiedTrafficColors, std::move(params.m_arrow3dCustomDecl),
-      params.m_onGraphicsContextInitialized);
+      size_t(shapesCacheSizeMB) << 20, params.m_onGraphicsContextInitialized);
 
   m_backend = make_unique_dp<BackendRenderer>(std::move(brParams));
   m_frontend = make_unique_dp<FrontendRenderer>(std::move(frParams));
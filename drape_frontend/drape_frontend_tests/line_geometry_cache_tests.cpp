@@ -0,0 +1,81 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/line_geometry_cache.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace line_geometry_cache_tests
+{
+using namespace df;
+
+std::shared_ptr<LineGeometry const> MakeGeometry(m2::PointD const & start, size_t pointsCount)
+{
+  std::vector<m2::PointD> path;
+  for (size_t i = 0; i < pointsCount; ++i)
+    path.emplace_back(start.x + i, start.y);
+
+  auto geometry = std::make_shared<LineGeometry>();
+  geometry->m_spline = m2::SharedSpline(std::move(path));
+  for (auto const & p : geometry->m_spline->GetPath())
+    geometry->m_limitRect.Add(p);
+  return geometry;
+}
+
+LineGeometryCache::Key MakeKey(uint32_t index, int zoom)
+{
+  LineGeometryCache::Key key;
+  key.m_featureId = FeatureID(MwmSet::MwmId(), index);
+  key.m_zoomLevel = static_cast<uint8_t>(zoom);
+  return key;
+}
+
+UNIT_TEST(LineGeometryCache_Lru)
+{
+  LineGeometryCache cache(10 /* maxPointsCount */);
+
+  auto const river = MakeGeometry({0.0, 0.0}, 4);
+  cache.Put(MakeKey(1, 10), river);
+  cache.Put(MakeKey(2, 10), MakeGeometry({0.0, 10.0}, 4));
+  TEST_EQUAL(cache.GetStats().m_points, 8, ());
+
+  // Zoom level is a part of the key.
+  TEST(cache.Find(MakeKey(1, 11)) == nullptr, ());
+  TEST_EQUAL(cache.Find(MakeKey(1, 10)), river, ());
+
+  // The second feature is the least recently used one.
+  cache.Put(MakeKey(3, 10), MakeGeometry({0.0, 20.0}, 4));
+  TEST(cache.Find(MakeKey(2, 10)) == nullptr, ());
+  TEST_EQUAL(cache.Find(MakeKey(1, 10)), river, ());
+  TEST(cache.Find(MakeKey(3, 10)) != nullptr, ());
+
+  // Too long lines are not cached.
+  cache.Put(MakeKey(4, 10), MakeGeometry({0.0, 30.0}, 11));
+  TEST(cache.Find(MakeKey(4, 10)) == nullptr, ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 3, ());
+  TEST_EQUAL(stats.m_misses, 3, ());
+  TEST_EQUAL(stats.m_features, 2, ());
+  TEST_EQUAL(stats.m_points, 8, ());
+}
+
+UNIT_TEST(LineGeometryCache_Invalidate)
+{
+  LineGeometryCache cache(100 /* maxPointsCount */);
+  cache.Put(MakeKey(1, 10), MakeGeometry({0.0, 0.0}, 10));
+  cache.Put(MakeKey(1, 11), MakeGeometry({0.0, 0.0}, 10));
+  cache.Put(MakeKey(2, 10), MakeGeometry({0.0, 50.0}, 10));
+
+  // Geometry of all zooms in the rect is removed.
+  cache.Invalidate(m2::RectD(5.0, -1.0, 6.0, 1.0));
+  TEST(cache.Find(MakeKey(1, 10)) == nullptr, ());
+  TEST(cache.Find(MakeKey(1, 11)) == nullptr, ());
+  TEST(cache.Find(MakeKey(2, 10)) != nullptr, ());
+  TEST_EQUAL(cache.GetStats().m_points, 10, ());
+
+  cache.Clear();
+  TEST(cache.Find(MakeKey(2, 10)) == nullptr, ());
+  TEST_EQUAL(cache.GetStats().m_features, 0, ());
+}
+}  // namespace line_geometry_cache_tests
@@ -0,0 +1,99 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/shaped_text_cache.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace shaped_text_cache_tests
+{
+using namespace df;
+
+ShapedTextCache::Key MakeKey(std::string const & text, bool isSplitAllowed = false)
+{
+  return {strings::MakeUniString(text), isSplitAllowed};
+}
+
+ShapedText MakeShapedText(std::string const & text)
+{
+  ShapedText shaped;
+  shaped.m_text = strings::MakeUniString(text);
+  shaped.m_delimIndexes.push_back(shaped.m_text.size());
+  return shaped;
+}
+
+UNIT_TEST(ShapedTextCache_Lru)
+{
+  ShapedTextCache cache(2 /* maxTextsCount */);
+  int shapesCount = 0;
+  auto const get = [&](std::string const & text, bool isSplitAllowed = false)
+  {
+    return cache.Get(MakeKey(text, isSplitAllowed), [&]()
+    {
+      ++shapesCount;
+      return MakeShapedText(text);
+    });
+  };
+
+  auto const street = get("Main Street");
+  TEST_EQUAL(street->m_text, strings::MakeUniString("Main Street"), ());
+  TEST_EQUAL(get("Main Street"), street, ());
+  TEST_EQUAL(shapesCount, 1, ());
+
+  // Split mode is a part of the key.
+  TEST(get("Main Street", true /* isSplitAllowed */) != street, ());
+  TEST_EQUAL(shapesCount, 2, ());
+
+  // "Main Street" was used before the split one, so it's evicted.
+  get("Park");
+  TEST_EQUAL(shapesCount, 3, ());
+  get("Main Street", true /* isSplitAllowed */);
+  TEST_EQUAL(shapesCount, 3, ());
+  get("Main Street");
+  TEST_EQUAL(shapesCount, 4, ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 2, ());
+  TEST_EQUAL(stats.m_misses, 4, ());
+
+  cache.Clear();
+  get("Main Street");
+  TEST_EQUAL(shapesCount, 5, ());
+}
+
+UNIT_TEST(ShapedTextCache_Concurrent)
+{
+  size_t constexpr kTextsCount = 100;
+  ShapedTextCache cache(kTextsCount);
+
+  std::atomic<int> shapesCount = 0;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&cache, &shapesCount]()
+    {
+      for (size_t j = 0; j < 10 * kTextsCount; ++j)
+      {
+        auto const text = std::to_string(j % kTextsCount);
+        auto const shaped = cache.Get(MakeKey(text), [&]()
+        {
+          ++shapesCount;
+          return MakeShapedText(text);
+        });
+        TEST_EQUAL(shaped->m_text, strings::MakeUniString(text), ());
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits + stats.m_misses, 4 * 10 * kTextsCount, ());
+  TEST_EQUAL(stats.m_misses, shapesCount, ());
+  // Texts may be shaped concurrently, but only a few times.
+  TEST_GREATER_OR_EQUAL(shapesCount, static_cast<int>(kTextsCount), ());
+  TEST_LESS_OR_EQUAL(shapesCount, static_cast<int>(4 * kTextsCount), ());
+}
+}  // namespace shaped_text_cache_tests
@@ -0,0 +1,114 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include <memory>
+
+namespace tile_shapes_cache_tests
+{
+using namespace df;
+
+class TestShape : public MapShape
+{
+public:
+  void Draw(ref_ptr<dp::GraphicsContext>, ref_ptr<dp::Batcher>, ref_ptr<dp::TextureManager>) const override {}
+  size_t GetMemorySize() const override { return 1000; }
+};
+
+std::shared_ptr<TileShapes const> MakeShapes(size_t count)
+{
+  auto shapes = std::make_shared<TileShapes>();
+  for (size_t i = 0; i < count; ++i)
+    shapes->m_geometry.push_back(std::make_shared<TestShape>());
+  return shapes;
+}
+
+TileShapesCache::Key MakeKey(int x, int y, int zoom, bool traffic = false)
+{
+  TileShapesCache::Key key;
+  key.m_tileKey = TileKey(x, y, static_cast<uint8_t>(zoom));
+  key.m_traffic = traffic;
+  return key;
+}
+
+UNIT_TEST(TileShapesCache_Lru)
+{
+  auto const shapes = MakeShapes(4);
+  size_t const tileBytes = shapes->GetMemorySize();
+  TEST_GREATER(tileBytes, 4 * 1000, ());
+  TileShapesCache cache(2 * tileBytes + tileBytes / 2 /* maxBytes */);
+
+  cache.Put(MakeKey(0, 0, 10), shapes, cache.GetGeneration());
+  cache.Put(MakeKey(1, 0, 10), MakeShapes(4), cache.GetGeneration());
+  TEST_EQUAL(cache.GetMemorySize(), 2 * tileBytes, ());
+  TEST_EQUAL(cache.Find(MakeKey(0, 0, 10)), shapes, ());
+
+  // Generations are not the part of the key.
+  auto key = MakeKey(0, 0, 10);
+  key.m_tileKey.m_generation = 5;
+  TEST_EQUAL(cache.Find(key), shapes, ());
+  TEST(!cache.Find(MakeKey(0, 0, 10, true /* traffic */)), ());
+
+  // (1, 0) is the least recently used.
+  cache.Put(MakeKey(2, 0, 10), MakeShapes(4), cache.GetGeneration());
+  TEST(!cache.Find(MakeKey(1, 0, 10)), ());
+  TEST(cache.Find(MakeKey(0, 0, 10)), ());
+  TEST(cache.Find(MakeKey(2, 0, 10)), ());
+  TEST_EQUAL(cache.GetMemorySize(), 2 * tileBytes, ());
+
+  // Too big tiles are not cached.
+  cache.Put(MakeKey(3, 0, 10), MakeShapes(11), cache.GetGeneration());
+  TEST(!cache.Find(MakeKey(3, 0, 10)), ());
+  TEST_EQUAL(cache.GetMemorySize(), 2 * tileBytes, ());
+
+  // The least recently used tile is evicted to fit a smaller one too.
+  cache.Put(MakeKey(4, 0, 10), MakeShapes(3), cache.GetGeneration());
+  TEST(cache.Find(MakeKey(4, 0, 10)), ());
+  TEST(!cache.Find(MakeKey(0, 0, 10)), ());
+
+  cache.Clear();
+  TEST(!cache.Find(MakeKey(2, 0, 10)), ());
+  TEST_EQUAL(cache.GetMemorySize(), 0, ());
+}
+
+UNIT_TEST(TileShapesCache_Invalidate)
+{
+  TileShapesCache cache(1000000 /* maxBytes */);
+  cache.Put(MakeKey(0, 0, 10), MakeShapes(1), cache.GetGeneration());
+  cache.Put(MakeKey(0, 0, 10, true /* traffic */), MakeShapes(1), cache.GetGeneration());
+  cache.Put(MakeKey(0, 0, 9), MakeShapes(1), cache.GetGeneration());
+  cache.Put(MakeKey(100, 100, 10), MakeShapes(1), cache.GetGeneration());
+
+  auto rect = MakeKey(0, 0, 10).m_tileKey.GetGlobalRect();
+  rect.Inflate(-rect.SizeX() / 4, -rect.SizeY() / 4);
+  cache.Invalidate(rect);
+
+  TEST(!cache.Find(MakeKey(0, 0, 10)), ());
+  TEST(!cache.Find(MakeKey(0, 0, 10, true /* traffic */)), ());
+  TEST(!cache.Find(MakeKey(0, 0, 9)), ());
+  TEST(cache.Find(MakeKey(100, 100, 10)), ());
+  TEST_EQUAL(cache.GetMemorySize(), MakeShapes(1)->GetMemorySize(), ());
+}
+
+UNIT_TEST(TileShapesCache_ForcedUpdate)
+{
+  TileShapesCache cache(1000000 /* maxBytes */);
+  cache.Put(MakeKey(0, 0, 10), MakeShapes(1), cache.GetGeneration());
+  TEST(cache.Find(MakeKey(0, 0, 10)), ());
+
+  // A tile is being read while the scene is forcibly updated (e.g. metalines are changed),
+  // the tile and the viewport rect are the same.
+  auto const generation = cache.GetGeneration();
+  cache.Clear();
+  TEST(!cache.Find(MakeKey(0, 0, 10)), ());
+
+  // Shapes of the outdated reading are not cached.
+  cache.Put(MakeKey(0, 0, 10), MakeShapes(1), generation);
+  TEST(!cache.Find(MakeKey(0, 0, 10)), ());
+  TEST_EQUAL(cache.GetMemorySize(), 0, ());
+
+  auto const shapes = MakeShapes(1);
+  cache.Put(MakeKey(0, 0, 10), shapes, cache.GetGeneration());
+  TEST_EQUAL(cache.Find(MakeKey(0, 0, 10)), shapes, ());
+}
+}  // namespace tile_shapes_cache_tests
@@ -5,6 +5,7 @@
 #include "geometry/mercator.hpp"
 
 
+#include <algorithm>
 #include <iomanip>
 
 namespace df
@@ -42,6 +43,8 @@ void DrapeMeasurer::Start()
   {
     std::lock_guard<std::mutex> lock(m_tilesMutex);
     m_tilesReadInfo.clear();
+    m_tileReadyLatencies.clear();
+    m_cancelledTilesCount = 0;
   }
 #endif
 
@@ -341,6 +344,10 @@ std::string DrapeMeasurer::TileStatistic::ToString() const
   ss << " ----- Tiles read statistic report ----- \n";
   ss << " Tile read time, ms = " << m_tileReadTimeInMs << "\n";
   ss << " Tiles count = " << m_totalTilesCount << "\n";
+  ss << " Tile ready latency, ms: p50 = " << m_readyLatencyP50InMs << ", p90 = " << m_readyLatencyP90InMs
+     << ", p99 = " << m_readyLatencyP99InMs << "\n";
+  ss << " Ready tiles count = " << m_readyTilesCount << "\n";
+  ss << " Cancelled tiles count = " << m_cancelledTilesCount << "\n";
   ss << " ----- Tiles read statistic report ----- \n";
 
   return ss.str();
@@ -394,6 +401,24 @@ void DrapeMeasurer::EndTileReading()
   ++tileInfo->m_totalTilesCount;
 }
 
+void DrapeMeasurer::TileReady(std::chrono::steady_clock::duration latency)
+{
+  if (!m_isEnabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_tilesMutex);
+  m_tileReadyLatencies.push_back(latency);
+}
+
+void DrapeMeasurer::TileCancelled()
+{
+  if (!m_isEnabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_tilesMutex);
+  ++m_cancelledTilesCount;
+}
+
 DrapeMeasurer::TileStatistic DrapeMeasurer::GetTileStatistic()
 {
   using namespace std::chrono;
@@ -406,6 +431,21 @@ DrapeMeasurer::TileStatistic DrapeMeasurer::GetTileStatistic()
           static_cast<uint32_t>(duration_cast<milliseconds>(it.second->m_totalTileReadTime).count());
       statistic.m_totalTilesCount += it.second->m_totalTilesCount;
     }
+
+    auto latencies = m_tileReadyLatencies;
+    std::sort(latencies.begin(), latencies.end());
+    auto const percentile = [&latencies](size_t p)
+    {
+      if (latencies.empty())
+        return uint32_t(0);
+      auto const index = std::min(latencies.size() * p / 100, latencies.size() - 1);
+      return static_cast<uint32_t>(duration_cast<milliseconds>(latencies[index]).count());
+    };
+    statistic.m_readyTilesCount = static_cast<uint32_t>(latencies.size());
+    statistic.m_readyLatencyP50InMs = percentile(50);
+    statistic.m_readyLatencyP90InMs = percentile(90);
+    statistic.m_readyLatencyP99InMs = percentile(99);
+    statistic.m_cancelledTilesCount = m_cancelledTilesCount;
   }
   if (statistic.m_totalTilesCount > 0)
     statistic.m_tileReadTimeInMs /= statistic.m_totalTilesCount;
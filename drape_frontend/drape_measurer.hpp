@@ -55,11 +55,21 @@ public:
 
     uint32_t m_totalTilesCount = 0;
     uint32_t m_tileReadTimeInMs = 0;
+
+    // Time from a tile read request to the end of reading, including waiting in the queue.
+    uint32_t m_readyTilesCount = 0;
+    uint32_t m_readyLatencyP50InMs = 0;
+    uint32_t m_readyLatencyP90InMs = 0;
+    uint32_t m_readyLatencyP99InMs = 0;
+    uint32_t m_cancelledTilesCount = 0;
   };
 
   void StartTileReading();
   void EndTileReading();
 
+  void TileReady(std::chrono::steady_clock::duration latency);
+  void TileCancelled();
+
   TileStatistic GetTileStatistic();
 #endif
 
@@ -161,6 +171,8 @@ private:
     uint32_t m_totalTilesCount = 0;
   };
   std::map<threads::ThreadID, std::shared_ptr<TileReadInfo>> m_tilesReadInfo;
+  std::vector<std::chrono::steady_clock::duration> m_tileReadyLatencies;
+  uint32_t m_cancelledTilesCount = 0;
   std::mutex m_tilesMutex;
 #endif
 
@@ -3,6 +3,9 @@
 #include "drape_frontend/message_subclasses.hpp"
 #include "drape/texture_manager.hpp"
 
+#include "base/thread_pool_computational.hpp"
+
+#include <algorithm>
 #include <utility>
 
 namespace df
@@ -11,6 +14,10 @@ EngineContext::EngineContext(TileKey tileKey,
                              ref_ptr<ThreadsCommutator> commutator,
                              ref_ptr<dp::TextureManager> texMng,
                              ref_ptr<MetalineManager> metalineMng,
+                             ref_ptr<TileShapesCache> shapesCache,
+                             ref_ptr<LineGeometryCache> lineGeometryCache,
+                             ref_ptr<base::thread_pool::computational::ThreadPool> shapesPool,
+                             ref_ptr<std::atomic<size_t> const> freeShapesThreadsCount,
                              CustomFeaturesContextWeakPtr customFeaturesContext,
                              bool is3dBuildingsEnabled,
                              bool isTrafficEnabled,
@@ -19,6 +26,10 @@ EngineContext::EngineContext(TileKey tileKey,
   , m_commutator(commutator)
   , m_texMng(texMng)
   , m_metalineMng(metalineMng)
+  , m_shapesCache(shapesCache)
+  , m_lineGeometryCache(lineGeometryCache)
+  , m_shapesPool(shapesPool)
+  , m_freeShapesThreadsCount(freeShapesThreadsCount)
   , m_customFeaturesContext(customFeaturesContext)
   , m_3dBuildingsEnabled(is3dBuildingsEnabled)
   , m_trafficEnabled(isTrafficEnabled)
@@ -35,6 +46,16 @@ ref_ptr<MetalineManager> EngineContext::GetMetalineManager() const
   return m_metalineMng;
 }
 
+size_t EngineContext::GetFreeShapesThreadsCount() const
+{
+  if (m_shapesPool == nullptr)
+    return 0;
+  size_t const threadsCount = m_shapesPool->GetThreadsCount();
+  if (m_freeShapesThreadsCount == nullptr)
+    return threadsCount;
+  return std::min(m_freeShapesThreadsCount->load(), threadsCount);
+}
+
 void EngineContext::BeginReadTile()
 {
   PostMessage(make_unique_dp<TileReadStartMessage>(m_tileKey));
@@ -42,16 +63,22 @@ void EngineContext::BeginReadTile()
 
 void EngineContext::Flush(TMapShapes && shapes)
 {
+  if (m_recordedShapes)
+    m_recordedShapes->m_geometry.insert(m_recordedShapes->m_geometry.end(), shapes.begin(), shapes.end());
   PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, std::move(shapes)));
 }
 
 void EngineContext::FlushOverlays(TMapShapes && shapes)
 {
+  if (m_recordedShapes)
+    m_recordedShapes->m_overlays.insert(m_recordedShapes->m_overlays.end(), shapes.begin(), shapes.end());
   PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, std::move(shapes)));
 }
 
 void EngineContext::FlushTrafficGeometry(TrafficSegmentsGeometry && geometry)
 {
+  if (m_recordedShapes)
+    m_recordedShapes->m_trafficGeometry = geometry;
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                             make_unique_dp<FlushTrafficGeometryMessage>(m_tileKey, std::move(geometry)),
                             MessagePriority::Low);
@@ -62,6 +89,26 @@ void EngineContext::EndReadTile()
   PostMessage(make_unique_dp<TileReadEndMessage>(m_tileKey));
 }
 
+void EngineContext::StartRecording()
+{
+  m_recordedShapes = std::make_shared<TileShapes>();
+}
+
+std::shared_ptr<TileShapes> EngineContext::FinishRecording()
+{
+  return std::move(m_recordedShapes);
+}
+
+void EngineContext::FlushCached(TileShapes const & shapes)
+{
+  if (!shapes.m_geometry.empty())
+    Flush(TMapShapes(shapes.m_geometry));
+  if (!shapes.m_overlays.empty())
+    FlushOverlays(TMapShapes(shapes.m_overlays));
+  if (!shapes.m_trafficGeometry.empty())
+    FlushTrafficGeometry(TrafficSegmentsGeometry(shapes.m_trafficGeometry));
+}
+
 void EngineContext::PostMessage(drape_ptr<Message> && message)
 {
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread, std::move(message),
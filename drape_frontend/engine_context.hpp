@@ -1,7 +1,9 @@
 #pragma once
 
 #include "drape_frontend/custom_features_context.hpp"
+#include "drape_frontend/line_geometry_cache.hpp"
 #include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/tile_utils.hpp"
 #include "drape_frontend/threads_commutator.hpp"
 #include "drape_frontend/traffic_generator.hpp"
@@ -9,7 +11,20 @@
 #include "drape/constants.hpp"
 #include "drape/pointers.hpp"
 
+#include <atomic>
 #include <functional>
+#include <memory>
+
+namespace base
+{
+namespace thread_pool
+{
+namespace computational
+{
+class ThreadPool;
+}  // namespace computational
+}  // namespace thread_pool
+}  // namespace base
 
 namespace dp
 {
@@ -28,6 +43,10 @@ public:
                 ref_ptr<ThreadsCommutator> commutator,
                 ref_ptr<dp::TextureManager> texMng,
                 ref_ptr<MetalineManager> metalineMng,
+                ref_ptr<TileShapesCache> shapesCache,
+                ref_ptr<LineGeometryCache> lineGeometryCache,
+                ref_ptr<base::thread_pool::computational::ThreadPool> shapesPool,
+                ref_ptr<std::atomic<size_t> const> freeShapesThreadsCount,
                 CustomFeaturesContextWeakPtr customFeaturesContext,
                 bool is3dBuildingsEnabled,
                 bool isTrafficEnabled,
@@ -40,6 +59,15 @@ public:
   CustomFeaturesContextWeakPtr GetCustomFeaturesContext() const { return m_customFeaturesContext; }
   ref_ptr<dp::TextureManager> GetTextureManager() const;
   ref_ptr<MetalineManager> GetMetalineManager() const;
+  /// @return nullptr if shapes caching is disabled.
+  ref_ptr<TileShapesCache> GetShapesCache() const { return m_shapesCache; }
+  /// @return nullptr if line geometry caching is disabled.
+  ref_ptr<LineGeometryCache> GetLineGeometryCache() const { return m_lineGeometryCache; }
+  /// @return nullptr if features of a tile are processed sequentially.
+  ref_ptr<base::thread_pool::computational::ThreadPool> GetShapesPool() const { return m_shapesPool; }
+  /// @return Count of threads of the shapes pool which may help with the tile now, 0 if there is
+  /// no pool or readers are busy with other tiles.
+  size_t GetFreeShapesThreadsCount() const;
 
   void BeginReadTile();
   void Flush(TMapShapes && shapes);
@@ -47,6 +75,12 @@ public:
   void FlushTrafficGeometry(TrafficSegmentsGeometry && geometry);
   void EndReadTile();
 
+  /// Flushed shapes are kept until FinishRecording() to put them into the cache.
+  void StartRecording();
+  std::shared_ptr<TileShapes> FinishRecording();
+  /// Flushes shapes of a cached tile as if they were read.
+  void FlushCached(TileShapes const & shapes);
+
 private:
   void PostMessage(drape_ptr<Message> && message);
 
@@ -54,6 +88,12 @@ private:
   ref_ptr<ThreadsCommutator> m_commutator;
   ref_ptr<dp::TextureManager> m_texMng;
   ref_ptr<MetalineManager> m_metalineMng;
+  ref_ptr<TileShapesCache> m_shapesCache;
+  ref_ptr<LineGeometryCache> m_lineGeometryCache;
+  ref_ptr<base::thread_pool::computational::ThreadPool> m_shapesPool;
+  // nullptr if all threads of the pool are available.
+  ref_ptr<std::atomic<size_t> const> m_freeShapesThreadsCount;
+  std::shared_ptr<TileShapes> m_recordedShapes;
   CustomFeaturesContextWeakPtr m_customFeaturesContext;
   bool m_3dBuildingsEnabled;
   bool m_trafficEnabled;
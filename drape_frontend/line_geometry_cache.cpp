@@ -0,0 +1,116 @@
+#include "drape_frontend/line_geometry_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <iterator>
+#include <sstream>
+
+namespace df
+{
+namespace
+{
+size_t GetPointsCount(LineGeometry const & geometry)
+{
+  return geometry.m_spline->GetSize();
+}
+}  // namespace
+
+// About 16 MB of points.
+size_t const LineGeometryCache::kDefaultMaxPointsCount = 1000000;
+
+bool LineGeometryCache::Key::operator<(Key const & rhs) const
+{
+  if (m_zoomLevel != rhs.m_zoomLevel)
+    return m_zoomLevel < rhs.m_zoomLevel;
+  return m_featureId < rhs.m_featureId;
+}
+
+LineGeometryCache::LineGeometryCache(size_t maxPointsCount) : m_maxPointsCount(maxPointsCount)
+{
+  CHECK_GREATER(m_maxPointsCount, 0, ());
+}
+
+std::shared_ptr<LineGeometry const> LineGeometryCache::Find(Key const & key)
+{
+  std::lock_guard lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it == m_index.end())
+  {
+    ++m_misses;
+    return {};
+  }
+
+  ++m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->second;
+}
+
+void LineGeometryCache::Put(Key const & key, std::shared_ptr<LineGeometry const> geometry)
+{
+  CHECK(geometry && !geometry->m_spline.IsNull(), ());
+  auto const pointsCount = GetPointsCount(*geometry);
+
+  std::lock_guard lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it != m_index.end())
+    Erase(it->second);
+
+  if (pointsCount > m_maxPointsCount)
+    return;
+
+  while (m_pointsCount + pointsCount > m_maxPointsCount)
+    Erase(std::prev(m_entries.end()));
+
+  m_entries.emplace_front(key, std::move(geometry));
+  m_index.emplace(key, m_entries.begin());
+  m_pointsCount += pointsCount;
+}
+
+void LineGeometryCache::Invalidate(m2::RectD const & rect)
+{
+  std::lock_guard lock(m_mutex);
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    auto const next = std::next(it);
+    if (it->second->m_limitRect.IsIntersect(rect))
+      Erase(it);
+    it = next;
+  }
+}
+
+void LineGeometryCache::Clear()
+{
+  std::lock_guard lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+  m_pointsCount = 0;
+}
+
+LineGeometryCache::Stats LineGeometryCache::GetStats() const
+{
+  std::lock_guard lock(m_mutex);
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  stats.m_features = m_entries.size();
+  stats.m_points = m_pointsCount;
+  return stats;
+}
+
+void LineGeometryCache::Erase(Entries::iterator it)
+{
+  auto const pointsCount = GetPointsCount(*it->second);
+  ASSERT_GREATER_OR_EQUAL(m_pointsCount, pointsCount, ());
+  m_pointsCount -= pointsCount;
+  m_index.erase(it->first);
+  m_entries.erase(it);
+}
+
+std::string DebugPrint(LineGeometryCache::Stats const & stats)
+{
+  std::ostringstream out;
+  out << "LineGeometryCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", features: " << stats.m_features << ", points: " << stats.m_points << " ]";
+  return out.str();
+}
+}  // namespace df
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "indexer/feature_decl.hpp"
+
+#include "geometry/rect2d.hpp"
+#include "geometry/spline.hpp"
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace df
+{
+/// Decoded and simplified geometry of a line feature on a zoom level.
+/// The spline is not changed after caching, so it's shared with shapes of several tiles.
+struct LineGeometry
+{
+  m2::RectD m_limitRect;
+  m2::SharedSpline m_spline;
+};
+
+/// LRU cache of geometry of long line features (rivers, coastlines, motorways) which cross
+/// several tiles. Neighboring tiles of a zoom level reuse the decoded and simplified spline,
+/// so geometry of such a feature is read once per zoom level instead of once per tile.
+/// The cache is thread-safe.
+class LineGeometryCache
+{
+public:
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+
+    FeatureID m_featureId;
+    uint8_t m_zoomLevel = 0;
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_features = 0;
+    uint64_t m_points = 0;
+  };
+
+  static size_t const kDefaultMaxPointsCount;
+
+  /// @param maxPointsCount Limit of points count of all cached features.
+  explicit LineGeometryCache(size_t maxPointsCount);
+
+  std::shared_ptr<LineGeometry const> Find(Key const & key);
+  void Put(Key const & key, std::shared_ptr<LineGeometry const> geometry);
+
+  /// Removes geometry of features of all zooms which intersect |rect|.
+  void Invalidate(m2::RectD const & rect);
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  using Entries = std::list<std::pair<Key, std::shared_ptr<LineGeometry const>>>;
+
+  void Erase(Entries::iterator it);
+
+  size_t const m_maxPointsCount;
+
+  mutable std::mutex m_mutex;
+  // Most recently used entries are at the front.
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+  size_t m_pointsCount = 0;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+};
+
+std::string DebugPrint(LineGeometryCache::Stats const & stats);
+}  // namespace df
@@ -138,12 +138,11 @@ protected:
 class SolidLineBuilder : public BaseLineBuilder<gpu::LineVertex>
 {
   using TBase = BaseLineBuilder<gpu::LineVertex>;
-  using TNormal = gpu::LineVertex::TNormal;
 
   struct CapVertex
   {
     using TPosition = gpu::LineVertex::TPosition;
-    using TNormal = gpu::LineVertex::TNormal;
+    using TNormal = glsl::vec3;
     using TTexCoord = gpu::LineVertex::TTexCoord;
 
     CapVertex() {}
@@ -165,6 +164,7 @@ public:
 
   SolidLineBuilder(BuilderParams const & params, size_t pointsInSpline)
     : TBase(params, pointsInSpline * 2, (pointsInSpline - 2) * 8)
+    , m_packedColorCoord(gpu::LineVertex::PackTexCoord(m_colorCoord))
   {}
 
   dp::RenderState GetState() override
@@ -214,10 +214,9 @@ public:
     return static_cast<uint32_t>(m_capGeometry.size());
   }
 
-  void SubmitVertex(glsl::vec3 const & pivot, glsl::vec2 const & normal, bool isLeft)
+  void SubmitVertex(glsl::vec3 const & pivot, glsl::vec2 const & normal)
   {
-    float const halfWidth = GetHalfWidth();
-    m_geometry.emplace_back(pivot, TNormal(halfWidth * normal, halfWidth * GetSide(isLeft)), m_colorCoord);
+    m_geometry.emplace_back(pivot, GetHalfWidth() * normal, m_packedColorCoord);
   }
 
   void SubmitJoin(glsl::vec2 const & pos)
@@ -251,6 +250,7 @@ private:
   }
 
 private:
+  gpu::LineVertex::TPackedTexCoord const m_packedColorCoord;
   TCapBuffer m_capGeometry;
 };
 
@@ -263,6 +263,7 @@ public:
 
   SimpleSolidLineBuilder(BuilderParams const & params, size_t pointsInSpline, int lineWidth)
     : TBase(params, pointsInSpline, 0)
+    , m_packedColorCoord(gpu::AreaVertex::PackTexCoord(m_colorCoord))
     , m_lineWidth(lineWidth)
   {}
 
@@ -278,17 +279,18 @@ public:
 
   void SubmitVertex(glsl::vec3 const & pivot)
   {
-    m_geometry.emplace_back(pivot, m_colorCoord);
+    m_geometry.emplace_back(pivot, m_packedColorCoord);
   }
 
 private:
+  gpu::AreaVertex::TPackedTexCoord const m_packedColorCoord;
   int m_lineWidth;
 };
 
 class DashedLineBuilder : public BaseLineBuilder<gpu::DashedLineVertex>
 {
   using TBase = BaseLineBuilder<gpu::DashedLineVertex>;
-  using TNormal = gpu::LineVertex::TNormal;
+  using TNormal = gpu::DashedLineVertex::TNormal;
 
 public:
   struct BuilderParams : BaseBuilderParams
@@ -446,10 +448,10 @@ void LineShape::Construct<SolidLineBuilder>(SolidLineBuilder & builder) const
                            glsl::vec2 const & leftNormal, glsl::vec2 const & rightNormal,
                            int flag)
   {
-    builder.SubmitVertex({p1, m_params.m_depth}, rightNormal, false /* isLeft */);
-    builder.SubmitVertex({p1, m_params.m_depth}, leftNormal, true /* isLeft */);
-    builder.SubmitVertex({p2, m_params.m_depth}, rightNormal, false /* isLeft */);
-    builder.SubmitVertex({p2, m_params.m_depth}, leftNormal, true /* isLeft */);
+    builder.SubmitVertex({p1, m_params.m_depth}, rightNormal);
+    builder.SubmitVertex({p1, m_params.m_depth}, leftNormal);
+    builder.SubmitVertex({p2, m_params.m_depth}, rightNormal);
+    builder.SubmitVertex({p2, m_params.m_depth}, leftNormal);
 
     // Generate joins.
     if (flag & 0x1)   // p1 - first point
@@ -545,6 +547,12 @@ void LineShape::Prepare(ref_ptr<dp::TextureManager> textures) const
   }
 }
 
+size_t LineShape::GetMemorySize() const
+{
+  // The spline may be shared with captions, it's counted for every shape.
+  return sizeof(LineShape) + m_spline->GetPath().size() * sizeof(m2::PointD);
+}
+
 void LineShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
                      ref_ptr<dp::TextureManager> textures) const
 {
@@ -8,6 +8,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <memory>
 #include <vector>
 
 namespace dp
@@ -34,6 +35,8 @@ public:
   virtual void Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
                     ref_ptr<dp::TextureManager> textures) const = 0;
   virtual MapShapeType GetType() const { return MapShapeType::GeometryType; }
+  /// Approximate size of the shape data in bytes, it's used to bound the cache of read tiles.
+  virtual size_t GetMemorySize() const { return sizeof(MapShape); }
 
   void SetFeatureMinZoom(int minZoom) { m_minZoom = minZoom; }
   int GetFeatureMinZoom() const { return m_minZoom; }
@@ -47,7 +50,8 @@ private:
   int m_minZoom = 0;
 };
 
-using TMapShapes = std::vector<drape_ptr<MapShape>>;
+// Shapes are shared, because read tiles are cached (see TileShapesCache).
+using TMapShapes = std::vector<std::shared_ptr<MapShape>>;
 
 class MapShapeMessage : public Message
 {
@@ -6,6 +6,7 @@
 #include "drape/batcher.hpp"
 #include "drape/pointers.hpp"
 
+#include <memory>
 #include <vector>
 #include <utility>
 
@@ -37,7 +38,7 @@ class OverlayBatcher
 {
 public:
   explicit OverlayBatcher(TileKey const & key);
-  void Batch(ref_ptr<dp::GraphicsContext> context, drape_ptr<MapShape> const & shape,
+  void Batch(ref_ptr<dp::GraphicsContext> context, std::shared_ptr<MapShape> const & shape,
              ref_ptr<dp::TextureManager> texMng);
   void Finish(ref_ptr<dp::GraphicsContext> context, TOverlaysRenderData & data);
 
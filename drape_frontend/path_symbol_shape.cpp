@@ -20,6 +20,11 @@ PathSymbolShape::PathSymbolShape(m2::SharedSpline const & spline,
   , m_spline(spline)
 {}
 
+size_t PathSymbolShape::GetMemorySize() const
+{
+  return sizeof(PathSymbolShape) + m_spline->GetPath().size() * sizeof(m2::PointD);
+}
+
 void PathSymbolShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
                            ref_ptr<dp::TextureManager> textures) const
 {
@@ -13,6 +13,7 @@ public:
   PathSymbolShape(m2::SharedSpline const & spline, PathSymbolViewParams const & params);
   void Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
             ref_ptr<dp::TextureManager> textures) const override;
+  size_t GetMemorySize() const override;
 
 private:
   PathSymbolViewParams m_params;
@@ -154,6 +154,12 @@ drape_ptr<dp::OverlayHandle> PathTextShape::CreateOverlayHandle(uint32_t textInd
                                           textures, m_params.m_minVisibleScale, true /* isBillboard */);
 }
 
+size_t PathTextShape::GetMemorySize() const
+{
+  return sizeof(PathTextShape) + m_spline->GetPath().size() * sizeof(m2::PointD) +
+         m_params.m_mainText.size() + m_params.m_auxText.size();
+}
+
 void PathTextShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
                          ref_ptr<dp::TextureManager> textures) const
 {
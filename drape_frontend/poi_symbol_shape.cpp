@@ -166,6 +166,11 @@ PoiSymbolShape::PoiSymbolShape(m2::PointD const & mercatorPt, PoiSymbolViewParam
   , m_textIndex(textIndex)
 {}
 
+size_t PoiSymbolShape::GetMemorySize() const
+{
+  return sizeof(PoiSymbolShape);
+}
+
 void PoiSymbolShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
                           ref_ptr<dp::TextureManager> textures) const
 {
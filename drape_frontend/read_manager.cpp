@@ -1,13 +1,19 @@
 #include "drape_frontend/read_manager.hpp"
+#include "drape_frontend/drape_measurer.hpp"
 #include "drape_frontend/message_subclasses.hpp"
 #include "drape_frontend/metaline_manager.hpp"
+#include "drape_frontend/shaped_text_cache.hpp"
 #include "drape_frontend/visual_params.hpp"
 
 #include "base/buffer_vector.hpp"
+#include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
+#include <thread>
+#include <utility>
 
 namespace df
 {
@@ -35,6 +41,30 @@ struct LessCoverageCell
 };
 }  // namespace
 
+size_t GetReadingThreadsCount()
+{
+  // The pool size is the upper bound of readers, the workload is adapted in ReadManager:
+  // readers which are idle because of few pending tiles help with heavy tiles via the shapes pool.
+  // Frontend, backend and UI threads.
+  size_t constexpr kBusyThreadsCount = 3;
+  size_t constexpr kMinThreadsCount = 2;
+  size_t constexpr kMaxThreadsCount = 6;
+
+  size_t const cores = std::thread::hardware_concurrency();
+  if (cores <= kBusyThreadsCount + kMinThreadsCount)
+    return kMinThreadsCount;
+  return std::min(cores - kBusyThreadsCount, kMaxThreadsCount);
+}
+
+size_t GetShapesThreadsCount()
+{
+  // Readers are not idle on devices with few cores, so splitting of tiles does not help there.
+  size_t constexpr kMinCoresCount = 6;
+  if (std::thread::hardware_concurrency() < kMinCoresCount)
+    return 0;
+  return GetReadingThreadsCount() - 1;
+}
+
 bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l,
                                              std::shared_ptr<TileInfo> const & r) const
 {
@@ -42,7 +72,8 @@ bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l
 }
 
 ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
-                         bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled)
+                         bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled,
+                         size_t shapesCacheSizeBytes)
   : m_commutator(commutator)
   , m_model(model)
   , m_have3dBuildings(false)
@@ -51,6 +82,8 @@ ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider
   , m_isolinesEnabled(isolinesEnabled)
   , m_modeChanged(false)
   , m_tasksPool(64, ReadMWMTaskFactory(m_model))
+  , m_shapesCache(shapesCacheSizeBytes > 0 ? make_unique_dp<TileShapesCache>(shapesCacheSizeBytes) : nullptr)
+  , m_lineGeometryCache(LineGeometryCache::kDefaultMaxPointsCount)
   , m_counter(0)
   , m_generationCounter(0)
   , m_userMarksGenerationCounter(0)
@@ -65,8 +98,13 @@ void ReadManager::Start()
 
   ASSERT_EQUAL(m_counter, 0, ());
 
-  m_pool = make_unique_dp<base::thread_pool::routine::ThreadPool>(kReadingThreadsCount,
+  m_readingThreadsCount = GetReadingThreadsCount();
+  UpdateFreeShapesThreadsCount();
+  m_pool = make_unique_dp<base::thread_pool::routine::ThreadPool>(m_readingThreadsCount,
                               std::bind(&ReadManager::OnTaskFinished, this, std::placeholders::_1));
+
+  if (auto const shapesThreadsCount = GetShapesThreadsCount(); shapesThreadsCount > 0)
+    m_shapesPool = make_unique_dp<base::thread_pool::computational::ThreadPool>(shapesThreadsCount);
 }
 
 void ReadManager::Stop()
@@ -75,6 +113,14 @@ void ReadManager::Stop()
   if (m_pool != nullptr)
     m_pool->Stop();
   m_pool.reset();
+
+  // Readers are stopped, so nobody waits for the shapes pool.
+  if (m_shapesPool != nullptr)
+    m_shapesPool->Stop();
+  m_shapesPool.reset();
+
+  LOG(LINFO, (ShapedTextCache::Instance().GetStats()));
+  LOG(LINFO, (m_lineGeometryCache.GetStats()));
 }
 
 void ReadManager::Restart()
@@ -100,6 +146,7 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
                                 make_unique_dp<FinishReadingMessage>(),
                                 MessagePriority::Normal);
     }
+    UpdateFreeShapesThreadsCount();
 
     auto const & key = t->GetTileKey();
     if (!task->IsCancelled())
@@ -120,6 +167,13 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
     }
   }
 
+#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
+  if (!task->IsCancelled())
+    DrapeMeasurer::Instance().TileReady(std::chrono::steady_clock::now() - t->GetInitTime());
+  else if (!t->IsStarted())
+    DrapeMeasurer::Instance().TileCancelled();
+#endif
+
   t->Reset();
   m_tasksPool.Return(t);
 }
@@ -137,6 +191,10 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
   {
     m_modeChanged = false;
 
+    // Forced updates rebuild shapes which depend on data out of the cache key (e.g. metalines).
+    if (forceUpdate)
+      ClearShapesCache();
+
     for (auto const & info : m_tileInfos)
       CancelTileInfo(info);
     m_tileInfos.clear();
@@ -145,8 +203,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     ++m_generationCounter;
     ++m_userMarksGenerationCounter;
 
-    for (auto const & tileKey : tiles)
-      PushTaskBackForTileKey(tileKey, texMng, metalineMng);
+    PushTasks(screen, TTileKeysCollection(tiles.begin(), tiles.end()), texMng, metalineMng);
   }
   else
   {
@@ -160,7 +217,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
       ClearTileInfo(info);
 
     // Find rects that go in into viewport.
-    buffer_vector<TileKey, 8> newTiles;
+    TTileKeysCollection newTiles;
     std::set_difference(tiles.begin(), tiles.end(),
                         m_tileInfos.begin(), m_tileInfos.end(),
                         std::back_inserter(newTiles), LessCoverageCell());
@@ -177,8 +234,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
       ++m_userMarksGenerationCounter;
     CheckFinishedTiles(readyTiles, forceUpdateUserMarks);
 
-    for (auto const & tileKey : newTiles)
-      PushTaskBackForTileKey(tileKey, texMng, metalineMng);
+    PushTasks(screen, std::move(newTiles), texMng, metalineMng);
   }
 
   m_currentViewport = screen;
@@ -186,6 +242,13 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
 
 void ReadManager::Invalidate(TTilesCollection const & keyStorage)
 {
+  m2::RectD rect;
+  for (auto const & tileKey : keyStorage)
+    rect.Add(tileKey.GetGlobalRect());
+  if (m_shapesCache != nullptr)
+    m_shapesCache->Invalidate(rect);
+  m_lineGeometryCache.Invalidate(rect);
+
   TTileSet tilesToErase;
   for (auto const & info : m_tileInfos)
   {
@@ -202,6 +265,10 @@ void ReadManager::Invalidate(TTilesCollection const & keyStorage)
 
 void ReadManager::InvalidateAll()
 {
+  // Textures may be recreated after, so cached shapes are not valid anymore.
+  ClearShapesCache();
+  m_lineGeometryCache.Clear();
+
   for (auto const & info : m_tileInfos)
     CancelTileInfo(info);
   m_tileInfos.clear();
@@ -226,6 +293,30 @@ bool ReadManager::MustDropAllTiles(ScreenBase const & screen) const
   return (oldScale != newScale) || !m_currentViewport.GlobalRect().IsIntersect(screen.GlobalRect());
 }
 
+void ReadManager::PushTasks(ScreenBase const & screen, TTileKeysCollection && tileKeys,
+                            ref_ptr<dp::TextureManager> texMng, ref_ptr<MetalineManager> metalineMng)
+{
+  // Tiles of other zooms (e.g. during scaling) are read after the tiles of the current zoom.
+  int const zoom = GetDrawTileScale(screen);
+  m2::PointD const center = screen.GlobalRect().GlobalCenter();
+
+  buffer_vector<std::pair<std::pair<int, double>, size_t>, 8> priorities;
+  priorities.reserve(tileKeys.size());
+  for (size_t i = 0; i < tileKeys.size(); ++i)
+  {
+    auto const & key = tileKeys[i];
+    priorities.emplace_back(std::make_pair(std::abs(key.m_zoomLevel - zoom),
+                                           key.GetGlobalRect().Center().SquaredLength(center)),
+                            i);
+  }
+  std::sort(priorities.begin(), priorities.end());
+
+  // Tasks of tiles which go out from viewport before reading are cancelled in ClearTileInfo
+  // and skipped by the pool.
+  for (auto const & p : priorities)
+    PushTaskBackForTileKey(tileKeys[p.second], texMng, metalineMng);
+}
+
 void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
                                          ref_ptr<dp::TextureManager> texMng,
                                          ref_ptr<MetalineManager> metalineMng)
@@ -234,6 +325,9 @@ void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
   auto context = make_unique_dp<EngineContext>(TileKey(tileKey, m_generationCounter,
                                                        m_userMarksGenerationCounter),
                                                m_commutator, texMng, metalineMng,
+                                               make_ref(m_shapesCache), make_ref(&m_lineGeometryCache),
+                                               make_ref(m_shapesPool),
+                                               make_ref(&m_freeShapesThreadsCount),
                                                m_customFeaturesContext,
                                                m_have3dBuildings && m_allow3dBuildings,
                                                m_trafficEnabled, m_isolinesEnabled);
@@ -302,6 +396,12 @@ void ReadManager::ClearTileInfo(std::shared_ptr<TileInfo> const & tileToClear)
   m_tileInfos.erase(tileToClear);
 }
 
+void ReadManager::ClearShapesCache()
+{
+  if (m_shapesCache != nullptr)
+    m_shapesCache->Clear();
+}
+
 void ReadManager::IncreaseCounter(size_t value)
 {
   if (value == 0)
@@ -311,6 +411,16 @@ void ReadManager::IncreaseCounter(size_t value)
 
   ASSERT_GREATER_OR_EQUAL(m_counter, 0, ());
   m_counter += value;
+  UpdateFreeShapesThreadsCount();
+}
+
+void ReadManager::UpdateFreeShapesThreadsCount()
+{
+  // Every pending tile takes a reader, a tile which is being read is among them. Spare readers
+  // are idle, so their cores can process batches of heavy tiles. When tiles are queued after
+  // a fast pan or zoom, all readers are busy and tiles are not split.
+  auto const pending = static_cast<size_t>(m_counter);
+  m_freeShapesThreadsCount = pending < m_readingThreadsCount ? m_readingThreadsCount - pending : 0;
 }
 
 void ReadManager::Allow3dBuildings(bool allow3dBuildings)
@@ -343,6 +453,7 @@ void ReadManager::SetIsolinesEnabled(bool isolinesEnabled)
 void ReadManager::SetCustomFeatures(CustomFeatures && ids)
 {
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(ids));
+  ClearShapesCache();
 }
 
 std::vector<FeatureID> ReadManager::GetCustomFeaturesArray() const
@@ -371,6 +482,7 @@ bool ReadManager::RemoveCustomFeatures(MwmSet::MwmId const & mwmId)
     return false;
 
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(features));
+  ClearShapesCache();
   return true;
 }
 
@@ -380,6 +492,7 @@ bool ReadManager::RemoveAllCustomFeatures()
     return false;
 
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(CustomFeatures());
+  ClearShapesCache();
   return true;
 }
 
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "drape_frontend/engine_context.hpp"
+#include "drape_frontend/line_geometry_cache.hpp"
 #include "drape_frontend/read_mwm_task.hpp"
 #include "drape_frontend/tile_info.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/tile_utils.hpp"
 
 #include "geometry/screenbase.hpp"
@@ -10,8 +12,11 @@
 #include "drape/object_pool.hpp"
 #include "drape/pointers.hpp"
 
+#include "base/buffer_vector.hpp"
 #include "base/thread_pool.hpp"
+#include "base/thread_pool_computational.hpp"
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -27,13 +32,19 @@ namespace df
 class MapDataProvider;
 class MetalineManager;
 
-uint8_t constexpr kReadingThreadsCount = 2;
+/// Readers take the cores which are not busy with rendering and UI, but not less than 2.
+size_t GetReadingThreadsCount();
+/// Threads which help readers to process features of heavy tiles, 0 if there are not enough cores.
+/// Only threads of idle readers are used, see ReadManager::UpdateFreeShapesThreadsCount().
+size_t GetShapesThreadsCount();
 
 class ReadManager
 {
 public:
+  /// @param shapesCacheSizeBytes Limit of the cache of read tiles, 0 disables the cache.
   ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
-              bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled);
+              bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled,
+              size_t shapesCacheSizeBytes);
 
   void Start();
   void Stop();
@@ -67,6 +78,12 @@ private:
   void OnTaskFinished(threads::IRoutine * task);
   bool MustDropAllTiles(ScreenBase const & screen) const;
 
+  using TTileKeysCollection = buffer_vector<TileKey, 8>;
+
+  // Pushes tasks ordered by distance from the screen center, so the visible part of the map
+  // is ready first.
+  void PushTasks(ScreenBase const & screen, TTileKeysCollection && tileKeys,
+                 ref_ptr<dp::TextureManager> texMng, ref_ptr<MetalineManager> metalineMng);
   void PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
                               ref_ptr<MetalineManager> metalineMng);
 
@@ -75,6 +92,8 @@ private:
   MapDataProvider & m_model;
 
   drape_ptr<base::thread_pool::routine::ThreadPool> m_pool;
+  // Processes batches of features of heavy tiles, nullptr if it's disabled.
+  drape_ptr<base::thread_pool::computational::ThreadPool> m_shapesPool;
 
   ScreenBase m_currentViewport;
   bool m_have3dBuildings;
@@ -94,8 +113,15 @@ private:
 
   dp::ObjectPool<ReadMWMTask, ReadMWMTaskFactory> m_tasksPool;
 
+  // nullptr if the cache is disabled.
+  drape_ptr<TileShapesCache> m_shapesCache;
+  LineGeometryCache m_lineGeometryCache;
+
   int m_counter;
   std::mutex m_finishedTilesMutex;
+  size_t m_readingThreadsCount = 0;
+  // Readers which are not needed for pending tiles, is updated with m_counter.
+  std::atomic<size_t> m_freeShapesThreadsCount = 0;
   uint64_t m_generationCounter;
   uint64_t m_userMarksGenerationCounter;
 
@@ -106,7 +132,10 @@ private:
 
   void CancelTileInfo(std::shared_ptr<TileInfo> const & tileToCancel);
   void ClearTileInfo(std::shared_ptr<TileInfo> const & tileToClear);
+  void ClearShapesCache();
   void IncreaseCounter(size_t value);
+  // Should be called under m_finishedTilesMutex.
+  void UpdateFreeShapesThreadsCount();
   void CheckFinishedTiles(TTileInfoCollection const & requestedTiles, bool forceUpdateUserMarks);
 };
 }  // namespace df
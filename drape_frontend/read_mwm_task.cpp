@@ -14,6 +14,8 @@ void ReadMWMTask::Init(std::shared_ptr<TileInfo> const & tileInfo)
 {
   m_tileInfo = tileInfo;
   m_tileKey = tileInfo->GetTileKey();
+  m_initTime = std::chrono::steady_clock::now();
+  m_isStarted = false;
 #ifdef DEBUG
   m_checker = true;
 #endif
@@ -46,6 +48,7 @@ void ReadMWMTask::Do()
   std::shared_ptr<TileInfo> tile = m_tileInfo.lock();
   if (tile == nullptr)
     return;
+  m_isStarted = true;
   try
   {
     tile->ReadFeatures(m_model);
@@ -4,6 +4,7 @@
 
 #include "base/thread.hpp"
 
+#include <chrono>
 #include <memory>
 
 namespace df
@@ -19,10 +20,15 @@ public:
   void Reset() override;
   bool IsCancelled() const override;
   TileKey const & GetTileKey() const { return m_tileKey; }
+  /// @return False if the tile was cancelled before reading was started.
+  bool IsStarted() const { return m_isStarted; }
+  std::chrono::steady_clock::time_point GetInitTime() const { return m_initTime; }
 
 private:
   std::weak_ptr<TileInfo> m_tileInfo;
   TileKey m_tileKey;
+  std::chrono::steady_clock::time_point m_initTime;
+  bool m_isStarted = false;
   MapDataProvider & m_model;
 
 #ifdef DEBUG
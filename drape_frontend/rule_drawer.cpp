@@ -29,6 +29,9 @@
 
 #include <array>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <vector>
 
 namespace df
@@ -159,11 +162,20 @@ void ExtractTrafficGeometry(FeatureType const & f, df::RoadClass const & roadCla
 RuleDrawer::RuleDrawer(TCheckCancelledCallback const & checkCancelled,
                        TIsCountryLoadedByNameFn const & isLoadedFn,
                        ref_ptr<EngineContext> engineContext, int8_t deviceLang)
+  : RuleDrawer(checkCancelled, isLoadedFn, engineContext, deviceLang, nullptr /* sharedState */)
+{}
+
+RuleDrawer::RuleDrawer(TCheckCancelledCallback const & checkCancelled,
+                       TIsCountryLoadedByNameFn const & isLoadedFn,
+                       ref_ptr<EngineContext> engineContext, int8_t deviceLang,
+                       ref_ptr<SharedState> sharedState)
   : m_checkCancelled(checkCancelled)
   , m_isLoadedFn(isLoadedFn)
   , m_context(engineContext)
   , m_customFeaturesContext(engineContext->GetCustomFeaturesContext().lock())
   , m_deviceLang(deviceLang)
+  , m_sharedState(sharedState != nullptr ? sharedState : make_ref(&m_ownState))
+  , m_deferFlush(sharedState != nullptr)
 {
   ASSERT(m_checkCancelled != nullptr, ());
 
@@ -192,7 +204,7 @@ RuleDrawer::RuleDrawer(TCheckCancelledCallback const & checkCancelled,
 
 RuleDrawer::~RuleDrawer()
 {
-  if (m_wasCancelled)
+  if (m_wasCancelled || m_deferFlush)
     return;
 
   for (auto const & shape : m_mapShapes[df::OverlayType])
@@ -208,6 +220,21 @@ RuleDrawer::~RuleDrawer()
   m_context->FlushTrafficGeometry(std::move(m_trafficGeometry));
 }
 
+RuleDrawer::Shapes RuleDrawer::TakeShapes()
+{
+  ASSERT(m_deferFlush, ());
+
+  for (auto const & shape : m_mapShapes[df::OverlayType])
+    shape->Prepare(m_context->GetTextureManager());
+
+  Shapes shapes;
+  shapes.m_geometry.swap(m_deferredGeometry);
+  shapes.m_overlays.swap(m_mapShapes[df::OverlayType]);
+  shapes.m_trafficGeometry.swap(m_trafficGeometry);
+  shapes.m_metalineOverlays.swap(m_metalineOverlays);
+  return shapes;
+}
+
 bool RuleDrawer::CheckCancelled()
 {
   m_wasCancelled = m_checkCancelled();
@@ -316,10 +343,29 @@ void RuleDrawer::ProcessAreaAndPointStyle(FeatureType & f, Stylist const & s, TI
   }
 }
 
-void RuleDrawer::ProcessLineStyle(FeatureType & f, Stylist const & s, TInsertShapeFn const & insertShape)
+void RuleDrawer::ProcessLineStyle(FeatureType & f, Stylist const & s, TInsertShapeFn const & insertShape,
+                                  m2::RectD const & limitRect,
+                                  std::shared_ptr<LineGeometry const> const & cachedGeometry)
 {
-  ApplyLineFeatureGeometry applyGeom(m_context->GetTileKey(), insertShape, f, m_currentScaleGtoP);
-  f.ForEachPoint(applyGeom, m_zoomLevel);
+  std::optional<ApplyLineFeatureGeometry> applyGeomHolder;
+  if (cachedGeometry != nullptr)
+  {
+    applyGeomHolder.emplace(m_context->GetTileKey(), insertShape, f, m_currentScaleGtoP, cachedGeometry->m_spline);
+  }
+  else
+  {
+    applyGeomHolder.emplace(m_context->GetTileKey(), insertShape, f, m_currentScaleGtoP);
+    f.ForEachPoint(*applyGeomHolder, m_zoomLevel);
+
+    // Lines which are inside the tile are not met in other tiles.
+    auto const lineGeometryCache = m_context->GetLineGeometryCache();
+    if (lineGeometryCache != nullptr && applyGeomHolder->HasGeometry() && !m_globalRect.IsRectInside(limitRect))
+    {
+      LineGeometry geometry{limitRect, applyGeomHolder->GetSpline()};
+      lineGeometryCache->Put({f.GetID(), m_zoomLevel}, std::make_shared<LineGeometry const>(std::move(geometry)));
+    }
+  }
+  auto & applyGeom = *applyGeomHolder;
 
   if (applyGeom.HasGeometry())
     applyGeom.ProcessLineRules(s.m_lineRules);
@@ -342,11 +388,18 @@ void RuleDrawer::ProcessLineStyle(FeatureType & f, Stylist const & s, TInsertSha
 
     if (!clippedSplines.empty())
     {
+      auto const overlaysBegin = m_mapShapes[df::OverlayType].size();
       ApplyLineFeatureAdditional applyAdditional(m_context->GetTileKey(), insertShape, f, m_currentScaleGtoP,
                                                  s.GetCaptionDescription(), std::move(clippedSplines));
       applyAdditional.ProcessAdditionalLineRules(s.m_pathtextRule, s.m_shieldRule,
                                                  m_context->GetTextureManager(), s.m_roadShields,
-                                                 m_generatedRoadShields);
+                                                 m_sharedState->m_generatedRoadShields, m_sharedState->m_mutex);
+
+      // Features are sorted, so in a tile which is processed sequentially the metaline is claimed
+      // by the feature with the lowest index. Batches keep the ranges to do the same on merging.
+      auto const overlaysEnd = m_mapShapes[df::OverlayType].size();
+      if (m_deferFlush && !metalineSpline.IsNull() && overlaysEnd != overlaysBegin)
+        m_metalineOverlays.push_back({metalineSpline.Get(), overlaysBegin, overlaysEnd});
     }
   }
 
@@ -431,9 +484,16 @@ void RuleDrawer::operator()(FeatureType & f)
   ASSERT(!hasLineAdd || hasLine, ("Pathtext/shield without a line drule", f.DebugString()));
 #endif
 
+  // Geometry of a long line may be decoded already for a neighboring tile.
+  feature::GeomType const geomType = f.GetGeomType();
+  std::shared_ptr<LineGeometry const> lineGeometry;
+  auto const lineGeometryCache = m_context->GetLineGeometryCache();
+  if (lineGeometryCache != nullptr && geomType == feature::GeomType::Line && !s.m_lineRules.empty())
+    lineGeometry = lineGeometryCache->Find({f.GetID(), m_zoomLevel});
+
   // FeatureType::GetLimitRect call invokes full geometry reading and decoding.
   // That's why this code follows after all lightweight return options.
-  m2::RectD const limitRect = f.GetLimitRect(m_zoomLevel);
+  m2::RectD const limitRect = lineGeometry != nullptr ? lineGeometry->m_limitRect : f.GetLimitRect(m_zoomLevel);
   if (!m_globalRect.IsIntersect(limitRect))
     return;
 
@@ -448,7 +508,6 @@ void RuleDrawer::operator()(FeatureType & f)
     m_mapShapes[index].push_back(std::move(shape));
   };
 
-  feature::GeomType const geomType = f.GetGeomType();
   if (geomType == feature::GeomType::Area)
   {
     ProcessAreaAndPointStyle(f, s, insertShape);
@@ -456,7 +515,7 @@ void RuleDrawer::operator()(FeatureType & f)
   else if (!s.m_lineRules.empty())
   {
     ASSERT(geomType == feature::GeomType::Line, ());
-    ProcessLineStyle(f, s, insertShape);
+    ProcessLineStyle(f, s, insertShape, limitRect, lineGeometry);
   }
   else
   {
@@ -473,6 +532,15 @@ void RuleDrawer::operator()(FeatureType & f)
 
   if (!m_mapShapes[df::GeometryType].empty())
   {
+    if (m_deferFlush)
+    {
+      auto & geomShapes = m_mapShapes[df::GeometryType];
+      m_deferredGeometry.insert(m_deferredGeometry.end(), std::make_move_iterator(geomShapes.begin()),
+                                std::make_move_iterator(geomShapes.end()));
+      geomShapes.clear();
+      return;
+    }
+
     TMapShapes geomShapes;
     geomShapes.swap(m_mapShapes[df::GeometryType]);
     m_context->Flush(std::move(geomShapes));
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "drape_frontend/custom_features_context.hpp"
+#include "drape_frontend/line_geometry_cache.hpp"
 #include "drape_frontend/map_shape.hpp"
 #include "drape_frontend/metaline_manager.hpp"
 #include "drape_frontend/tile_key.hpp"
@@ -16,8 +17,11 @@
 #include <array>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 class FeatureType;
 
@@ -33,6 +37,9 @@ class Stylist;
  * which create corresponding MapShape objects (which might in turn create OverlayHandles).
  * The RuleDrawer flushes geometry MapShapes immediately for each feature,
  * while overlay MapShapes are flushed altogether after all features are processed.
+ * Features of a tile can be split into batches which are processed by several RuleDrawers
+ * in parallel. Such drawers do not flush shapes, they are taken by TakeShapes() and flushed
+ * in the original order.
  */
 class RuleDrawer
 {
@@ -41,20 +48,56 @@ public:
   using TIsCountryLoadedByNameFn = std::function<bool(std::string_view)>;
   using TInsertShapeFn = std::function<void(drape_ptr<MapShape> && shape)>;
 
+  // Road shields of a tile are not generated too close to each other, so drawers of the same
+  // tile share them.
+  struct SharedState
+  {
+    std::mutex m_mutex;
+    GeneratedRoadShields m_generatedRoadShields;
+  };
+
+  // Captions and shields of a metaline, [m_begin, m_end) range of Shapes::m_overlays.
+  struct MetalineOverlays
+  {
+    m2::Spline const * m_spline = nullptr;
+    size_t m_begin = 0;
+    size_t m_end = 0;
+  };
+
+  struct Shapes
+  {
+    TMapShapes m_geometry;
+    TMapShapes m_overlays;
+    TrafficSegmentsGeometry m_trafficGeometry;
+    // A metaline is generated once per drawer. When it's met in several batches, only overlays
+    // of the first batch should be flushed.
+    std::vector<MetalineOverlays> m_metalineOverlays;
+  };
+
   RuleDrawer(TCheckCancelledCallback const & checkCancelled,
              TIsCountryLoadedByNameFn const & isLoadedFn,
              ref_ptr<EngineContext> engineContext, int8_t deviceLang);
+  // Shapes of this drawer are not flushed to the engine context, see TakeShapes().
+  RuleDrawer(TCheckCancelledCallback const & checkCancelled,
+             TIsCountryLoadedByNameFn const & isLoadedFn,
+             ref_ptr<EngineContext> engineContext, int8_t deviceLang,
+             ref_ptr<SharedState> sharedState);
   ~RuleDrawer();
 
   void operator()(FeatureType & f);
 
+  // Returns all prepared shapes of processed features. Only for drawers with a shared state.
+  Shapes TakeShapes();
+
 #ifdef DRAW_TILE_NET
   void DrawTileNet();
 #endif
 
 private:
   void ProcessAreaAndPointStyle(FeatureType & f, Stylist const & s, TInsertShapeFn const & insertShape);
-  void ProcessLineStyle(FeatureType & f, Stylist const & s, TInsertShapeFn const & insertShape);
+  // |cachedGeometry| is decoded geometry of the feature on the current zoom level, if any.
+  void ProcessLineStyle(FeatureType & f, Stylist const & s, TInsertShapeFn const & insertShape,
+                        m2::RectD const & limitRect, std::shared_ptr<LineGeometry const> const & cachedGeometry);
   void ProcessPointStyle(FeatureType & f, Stylist const & s, TInsertShapeFn const & insertShape);
 
   bool CheckCoastlines(FeatureType & f);
@@ -69,6 +112,12 @@ private:
   ref_ptr<EngineContext> m_context;
   CustomFeaturesContextPtr m_customFeaturesContext;
   int8_t m_deviceLang;
+
+  SharedState m_ownState;
+  ref_ptr<SharedState> m_sharedState;
+  bool const m_deferFlush;
+  TMapShapes m_deferredGeometry;
+  std::vector<MetalineOverlays> m_metalineOverlays;
   std::unordered_set<m2::Spline const *> m_usedMetalines;
 
   m2::RectD m_globalRect;
@@ -79,8 +128,6 @@ private:
 
   std::array<TMapShapes, df::MapShapeTypeCount> m_mapShapes;
 
-  GeneratedRoadShields m_generatedRoadShields;
-
   uint8_t m_zoomLevel = 0;
   bool m_wasCancelled = false;
 };
@@ -0,0 +1,59 @@
+#include "drape_frontend/shaped_text_cache.hpp"
+
+#include <sstream>
+
+namespace std
+{
+size_t hash<df::ShapedTextKey>::operator()(df::ShapedTextKey const & key) const
+{
+  // FNV-1a over characters.
+  uint64_t hash = 14695981039346656037ULL;
+  for (auto const c : key.m_text)
+  {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  hash ^= static_cast<uint64_t>(key.m_isSplitAllowed);
+  hash *= 1099511628211ULL;
+  return static_cast<size_t>(hash);
+}
+}  // namespace std
+
+namespace df
+{
+// Names of a few dozens of dense city tiles.
+size_t const ShapedTextCache::kDefaultMaxTextsCount = 20000;
+
+// static
+ShapedTextCache & ShapedTextCache::Instance()
+{
+  static ShapedTextCache cache(kDefaultMaxTextsCount);
+  return cache;
+}
+
+ShapedTextCache::ShapedTextCache(size_t maxTextsCount) : m_cache(maxTextsCount) {}
+
+void ShapedTextCache::Clear()
+{
+  std::lock_guard lock(m_mutex);
+  m_cache.Clear();
+}
+
+ShapedTextCache::Stats ShapedTextCache::GetStats() const
+{
+  std::lock_guard lock(m_mutex);
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  return stats;
+}
+
+std::string DebugPrint(ShapedTextCache::Stats const & stats)
+{
+  auto const requests = stats.m_hits + stats.m_misses;
+  std::ostringstream out;
+  out << "ShapedTextCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", hit rate: " << (requests == 0 ? 0.0 : static_cast<double>(stats.m_hits) / requests) << " ]";
+  return out.str();
+}
+}  // namespace df
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "base/buffer_vector.hpp"
+#include "base/lru_cache.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace df
+{
+/// Visual (bidi reordered and shaped) text of a label split into lines.
+struct ShapedText
+{
+  strings::UniString m_text;
+  // End indexes of lines in |m_text|.
+  buffer_vector<size_t, 2> m_delimIndexes;
+};
+
+struct ShapedTextKey
+{
+  bool operator==(ShapedTextKey const & rhs) const
+  {
+    return m_isSplitAllowed == rhs.m_isSplitAllowed && m_text == rhs.m_text;
+  }
+
+  strings::UniString m_text;
+  bool m_isSplitAllowed = false;
+};
+}  // namespace df
+
+namespace std
+{
+template <>
+struct hash<df::ShapedTextKey>
+{
+  size_t operator()(df::ShapedTextKey const & key) const;
+};
+}  // namespace std
+
+namespace df
+{
+/// LRU cache of shaped texts. The same street and POI names are met in many tiles and on many
+/// zoom levels, so they are shaped once. Shaping doesn't depend on font size and textures,
+/// so the cache is never invalidated. The cache is thread-safe and is shared by reader threads.
+class ShapedTextCache
+{
+public:
+  using Key = ShapedTextKey;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  static size_t const kDefaultMaxTextsCount;
+
+  static ShapedTextCache & Instance();
+
+  /// @param maxTextsCount Limit of cached texts count.
+  explicit ShapedTextCache(size_t maxTextsCount);
+
+  /// @returns Cached text or the result of |shape| call, which is cached.
+  /// |shape| is called without the lock, so a text may be shaped twice by concurrent readers.
+  template <typename ShapeFn>
+  std::shared_ptr<ShapedText const> Get(Key const & key, ShapeFn && shape)
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      bool found;
+      // A missing text is added as an empty value, which is filled after shaping.
+      auto const & text = m_cache.Find(key, found);
+      if (text)
+      {
+        ++m_hits;
+        return text;
+      }
+      ++m_misses;
+    }
+
+    auto shaped = std::make_shared<ShapedText const>(shape());
+
+    std::lock_guard lock(m_mutex);
+    bool found;
+    // The text may be shaped concurrently by another reader or evicted while shaping.
+    auto & text = m_cache.Find(key, found);
+    if (!text)
+      text = std::move(shaped);
+    return text;
+  }
+
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  mutable std::mutex m_mutex;
+  LruCache<Key, std::shared_ptr<ShapedText const>> m_cache;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+};
+
+std::string DebugPrint(ShapedTextCache::Stats const & stats);
+}  // namespace df
@@ -179,7 +179,7 @@ Stylist::Stylist(FeatureType & f, uint8_t zoomLevel, int8_t deviceLang)
   for (uint32_t t : types)
   {
     drule::KeysT typeKeys;
-    cl.GetObject(t)->GetSuitable(zoomLevel, geomType, typeKeys);
+    cl.GetSuitable(t, zoomLevel, geomType, typeKeys);
     bool const hasHatching = hatchingChecker(t);
 
     for (auto & k : typeKeys)
@@ -241,7 +241,7 @@ Stylist::Stylist(FeatureType & f, uint8_t zoomLevel, int8_t deviceLang)
         else
         {
           drule::KeysT addressKeys;
-          cl.GetObject(addressType)->GetSuitable(zoomLevel, geomType, addressKeys);
+          cl.GetSuitable(addressType, zoomLevel, geomType, addressKeys);
           if (!addressKeys.empty())
           {
             // A caption drule exists for this zoom level.
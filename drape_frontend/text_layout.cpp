@@ -1,5 +1,6 @@
 #include "drape_frontend/text_layout.hpp"
 #include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/shaped_text_cache.hpp"
 #include "drape_frontend/visual_params.hpp"
 
 #include "drape/bidi.hpp"
@@ -7,6 +8,7 @@
 
 #include <algorithm>
 #include <iterator>  // std::reverse_iterator
+#include <memory>
 #include <numeric>
 
 namespace df
@@ -283,6 +285,20 @@ void CalculateOffsets(dp::Anchor anchor, float textRatio,
   pixelSize = m2::PointF(maxLength, summaryHeight);
 }
 
+std::shared_ptr<ShapedText const> GetShapedText(strings::UniString const & text, bool isSplitAllowed)
+{
+  return ShapedTextCache::Instance().Get({text, isSplitAllowed}, [&text, isSplitAllowed]()
+  {
+    ShapedText shaped;
+    shaped.m_text = bidi::log2vis(text);
+    if (shaped.m_text == text && isSplitAllowed)
+      SplitText(shaped.m_text, shaped.m_delimIndexes);
+    else
+      shaped.m_delimIndexes.push_back(shaped.m_text.size());
+    return shaped;
+  });
+}
+
 double GetTextMinPeriod(double pixelTextLength)
 {
   double const vs = df::VisualParams::Instance().GetVisualScale();
@@ -341,19 +357,14 @@ strings::UniString const & TextLayout::GetText() const
 StraightTextLayout::StraightTextLayout(strings::UniString const & text, float fontSize,
                                        ref_ptr<dp::TextureManager> textures, dp::Anchor anchor, bool forceNoWrap)
 {
-  strings::UniString visibleText = bidi::log2vis(text);
+  auto const shapedText = GetShapedText(text, !forceNoWrap /* isSplitAllowed */);
   // Possible if name has strange symbols only.
-  if (visibleText.empty())
+  if (shapedText->m_text.empty())
     return;
 
-  buffer_vector<size_t, 2> delimIndexes;
-  if (visibleText == text && !forceNoWrap)
-    SplitText(visibleText, delimIndexes);
-  else
-    delimIndexes.push_back(visibleText.size());
-
-  TBase::Init(std::move(visibleText), fontSize, textures);
-  CalculateOffsets(anchor, m_textSizeRatio, m_metrics, delimIndexes, m_offsets, m_pixelSize, m_rowsCount);
+  TBase::Init(strings::UniString(shapedText->m_text), fontSize, textures);
+  CalculateOffsets(anchor, m_textSizeRatio, m_metrics, shapedText->m_delimIndexes, m_offsets, m_pixelSize,
+                   m_rowsCount);
 }
 
 m2::PointF StraightTextLayout::GetSymbolBasedTextOffset(m2::PointF const & symbolSize, dp::Anchor textAnchor,
@@ -425,7 +436,7 @@ PathTextLayout::PathTextLayout(m2::PointD const & tileCenter, strings::UniString
                                float fontSize, ref_ptr<dp::TextureManager> textures)
   : m_tileCenter(tileCenter)
 {
-  Init(bidi::log2vis(text), fontSize, textures);
+  Init(strings::UniString(GetShapedText(text, false /* isSplitAllowed */)->m_text), fontSize, textures);
 }
 
 void PathTextLayout::CacheStaticGeometry(dp::TextureManager::ColorRegion const & colorRegion,
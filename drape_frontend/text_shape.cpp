@@ -230,6 +230,12 @@ void CalculateTextOffsets(dp::TitleDecl const titleDecl, m2::PointF const & prim
   }
 }
 
+size_t TextShape::GetMemorySize() const
+{
+  return sizeof(TextShape) + m_params.m_titleDecl.m_primaryText.size() +
+         m_params.m_titleDecl.m_secondaryText.size() + m_symbolSizes.size() * sizeof(m2::PointF);
+}
+
 void TextShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
                      ref_ptr<dp::TextureManager> textures) const
 {
@@ -20,8 +20,11 @@ public:
     ResourceUploadThread
   };
 
+  virtual ~ThreadsCommutator() = default;
+
   void RegisterThread(ThreadName name, BaseRenderer * acceptor);
-  void PostMessage(ThreadName name, drape_ptr<Message> && message, MessagePriority priority);
+  // Virtual to intercept messages without renderers, e.g. in benchmarks.
+  virtual void PostMessage(ThreadName name, drape_ptr<Message> && message, MessagePriority priority);
 
 private:
   using TAcceptorsMap = std::map<ThreadName, BaseRenderer *>;
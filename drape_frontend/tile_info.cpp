@@ -12,14 +12,24 @@
 
 #include "base/scope_guard.hpp"
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
 #include <functional>
+#include <future>
+#include <iterator>
+#include <unordered_set>
 
 using namespace std::placeholders;
 
 namespace df
 {
+namespace
+{
+// Small batches are not worth of synchronization.
+size_t constexpr kMinFeaturesInBatch = 1000;
+}  // namespace
+
 TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext)
   : m_context(std::move(engineContext))
   , m_isCanceled(false)
@@ -57,12 +67,36 @@ void TileInfo::ReadFeatures(MapDataProvider const & model)
 {
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
   DrapeMeasurer::Instance().StartTileReading();
+  // Tiles from the cache are measured too.
+  SCOPE_GUARD(EndTileReading, [] { DrapeMeasurer::Instance().EndTileReading(); });
 #endif
   m_context->BeginReadTile();
 
   // Reading can be interrupted by exception throwing
   SCOPE_GUARD(ReleaseReadTile, std::bind(&EngineContext::EndReadTile, m_context.get()));
 
+  auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
+  auto const shapesCache = m_context->GetShapesCache();
+  TileShapesCache::Key cacheKey;
+  uint64_t cacheGeneration = 0;
+  if (shapesCache != nullptr)
+  {
+    cacheGeneration = shapesCache->GetGeneration();
+    cacheKey.m_tileKey = GetTileKey();
+    cacheKey.m_3dBuildings = m_context->Is3dBuildingsEnabled();
+    cacheKey.m_traffic = m_context->IsTrafficEnabled();
+    cacheKey.m_isolines = m_context->IsolinesEnabled();
+    cacheKey.m_deviceLang = deviceLang;
+
+    if (auto const shapes = shapesCache->Find(cacheKey))
+    {
+      m_context->GetMetalineManager()->Update(shapes->m_mwms);
+      m_context->FlushCached(*shapes);
+      return;
+    }
+    m_context->StartRecording();
+  }
+
   ReadFeatureIndex(model);
   ThrowIfCancelled();
 
@@ -71,17 +105,138 @@ void TileInfo::ReadFeatures(MapDataProvider const & model)
   if (!m_featureInfo.empty())
   {
     std::sort(m_featureInfo.begin(), m_featureInfo.end());
-    auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
-    RuleDrawer drawer(std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
-                      make_ref(m_context), deviceLang);
-    model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
+#ifndef DRAW_TILE_NET
+    if (m_context->GetFreeShapesThreadsCount() != 0 && m_featureInfo.size() >= 2 * kMinFeaturesInBatch)
+    {
+      ProcessFeaturesInParallel(model, deviceLang);
+    }
+    else
+#endif
+    {
+      RuleDrawer drawer(std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
+                        make_ref(m_context), deviceLang);
+      model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
 #ifdef DRAW_TILE_NET
-    drawer.DrawTileNet();
+      drawer.DrawTileNet();
 #endif
+    }
   }
-#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
-  DrapeMeasurer::Instance().EndTileReading();
-#endif
+
+  // Overlays are flushed on the drawer destruction, so the tile is completely read here.
+  // Partially read tiles are not cached.
+  if (shapesCache != nullptr && !IsCancelled())
+  {
+    auto shapes = m_context->FinishRecording();
+    shapes->m_mwms = m_mwms;
+    shapesCache->Put(cacheKey, std::move(shapes), cacheGeneration);
+  }
+}
+
+void TileInfo::ProcessFeaturesInParallel(MapDataProvider const & model, int8_t deviceLang)
+{
+  auto const pool = m_context->GetShapesPool();
+  size_t const batchesCount = std::min(m_featureInfo.size() / kMinFeaturesInBatch,
+                                       m_context->GetFreeShapesThreadsCount() + 1);
+  size_t const batchSize = (m_featureInfo.size() + batchesCount - 1) / batchesCount;
+
+  RuleDrawer::SharedState sharedState;
+  std::vector<RuleDrawer::Shapes> batchesShapes(batchesCount);
+  auto const processBatch = [&](size_t batchIndex)
+  {
+    auto const begin = m_featureInfo.begin() + batchIndex * batchSize;
+    auto const end = m_featureInfo.begin() + std::min((batchIndex + 1) * batchSize, m_featureInfo.size());
+    RuleDrawer drawer(std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
+                      make_ref(m_context), deviceLang, make_ref(&sharedState));
+    model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), std::vector<FeatureID>(begin, end));
+    batchesShapes[batchIndex] = drawer.TakeShapes();
+  };
+
+  // The first batch is processed on the current thread, so the tile is read even if the pool
+  // is busy or stopped.
+  std::vector<std::future<void>> results;
+  results.reserve(batchesCount - 1);
+  for (size_t i = 1; i < batchesCount; ++i)
+    results.push_back(pool->Submit(processBatch, i));
+
+  std::exception_ptr exception;
+  try
+  {
+    processBatch(0);
+  }
+  catch (...)
+  {
+    exception = std::current_exception();
+  }
+
+  // All batches must be finished before leaving, they refer to the local state.
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    if (!results[i].valid())
+    {
+      // The pool is stopped.
+      Cancel();
+      continue;
+    }
+
+    try
+    {
+      results[i].get();
+    }
+    catch (std::future_error const &)
+    {
+      // The pool is stopped before the batch processing.
+      Cancel();
+    }
+    catch (...)
+    {
+      if (!exception)
+        exception = std::current_exception();
+    }
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+
+  if (IsCancelled())
+    return;
+
+  // Flush in the features order, so shapes are batched as if they were processed sequentially.
+  RuleDrawer::Shapes tileShapes;
+  std::unordered_set<m2::Spline const *> usedMetalines;
+  for (auto & shapes : batchesShapes)
+  {
+    if (!shapes.m_geometry.empty())
+      m_context->Flush(std::move(shapes.m_geometry));
+
+    // A metaline belongs to the feature with the lowest index, as in the sequential processing.
+    auto & overlays = shapes.m_overlays;
+    size_t pos = 0;
+    auto const moveOverlays = [&](size_t end)
+    {
+      tileShapes.m_overlays.insert(tileShapes.m_overlays.end(), std::make_move_iterator(overlays.begin() + pos),
+                                   std::make_move_iterator(overlays.begin() + end));
+      pos = end;
+    };
+    for (auto const & metaline : shapes.m_metalineOverlays)
+    {
+      moveOverlays(metaline.m_begin);
+      if (usedMetalines.insert(metaline.m_spline).second)
+        moveOverlays(metaline.m_end);
+      pos = metaline.m_end;
+    }
+    moveOverlays(overlays.size());
+
+    for (auto & [mwmId, segments] : shapes.m_trafficGeometry)
+    {
+      auto & tileSegments = tileShapes.m_trafficGeometry[mwmId];
+      tileSegments.insert(tileSegments.end(), std::make_move_iterator(segments.begin()),
+                          std::make_move_iterator(segments.end()));
+    }
+  }
+
+  if (!tileShapes.m_overlays.empty())
+    m_context->FlushOverlays(std::move(tileShapes.m_overlays));
+  m_context->FlushTrafficGeometry(std::move(tileShapes.m_trafficGeometry));
 }
 
 void TileInfo::Cancel()
@@ -37,6 +37,9 @@ public:
 
 private:
   void ReadFeatureIndex(MapDataProvider const & model);
+  // Splits sorted features into batches which are processed on the shapes pool and the current
+  // thread. Shapes of the batches are flushed in the original order.
+  void ProcessFeaturesInParallel(MapDataProvider const & model, int8_t deviceLang);
   void ThrowIfCancelled() const;
   bool DoNeedReadIndex() const;
 
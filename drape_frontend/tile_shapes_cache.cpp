@@ -0,0 +1,118 @@
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <functional>
+#include <iterator>
+#include <tuple>
+
+namespace df
+{
+size_t TileShapes::GetMemorySize() const
+{
+  size_t bytes = sizeof(TileShapes);
+  for (auto const & shapes : {std::cref(m_geometry), std::cref(m_overlays)})
+  {
+    for (auto const & shape : shapes.get())
+      bytes += sizeof(shape) + shape->GetMemorySize();
+  }
+  for (auto const & [mwmId, segments] : m_trafficGeometry)
+  {
+    for (auto const & segment : segments)
+      bytes += sizeof(segment) + segment.second.m_polyline.GetSize() * sizeof(m2::PointD);
+  }
+  return bytes;
+}
+
+bool TileShapesCache::Key::operator<(Key const & rhs) const
+{
+  if (!(m_tileKey == rhs.m_tileKey))
+    return m_tileKey < rhs.m_tileKey;
+
+  return std::tie(m_3dBuildings, m_traffic, m_isolines, m_deviceLang) <
+         std::tie(rhs.m_3dBuildings, rhs.m_traffic, rhs.m_isolines, rhs.m_deviceLang);
+}
+
+TileShapesCache::TileShapesCache(size_t maxBytes) : m_maxBytes(maxBytes)
+{
+  CHECK_GREATER(m_maxBytes, 0, ());
+}
+
+uint64_t TileShapesCache::GetGeneration() const
+{
+  std::lock_guard lock(m_mutex);
+  return m_generation;
+}
+
+std::shared_ptr<TileShapes const> TileShapesCache::Find(Key const & key)
+{
+  std::lock_guard lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it == m_index.end())
+    return {};
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->m_shapes;
+}
+
+void TileShapesCache::Put(Key const & key, std::shared_ptr<TileShapes const> shapes,
+                          uint64_t generation)
+{
+  CHECK(shapes, ());
+  auto const bytes = shapes->GetMemorySize();
+
+  std::lock_guard lock(m_mutex);
+  if (generation != m_generation)
+    return;
+
+  auto const it = m_index.find(key);
+  if (it != m_index.end())
+    Erase(it->second);
+
+  if (bytes > m_maxBytes)
+    return;
+
+  while (m_bytes + bytes > m_maxBytes)
+    Erase(std::prev(m_entries.end()));
+
+  m_entries.push_front({key, std::move(shapes), bytes});
+  m_index.emplace(key, m_entries.begin());
+  m_bytes += bytes;
+}
+
+void TileShapesCache::Invalidate(m2::RectD const & rect)
+{
+  std::lock_guard lock(m_mutex);
+  ++m_generation;
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    auto const next = std::next(it);
+    if (it->m_key.m_tileKey.GetGlobalRect().IsIntersect(rect))
+      Erase(it);
+    it = next;
+  }
+}
+
+void TileShapesCache::Clear()
+{
+  std::lock_guard lock(m_mutex);
+  ++m_generation;
+  m_entries.clear();
+  m_index.clear();
+  m_bytes = 0;
+}
+
+size_t TileShapesCache::GetMemorySize() const
+{
+  std::lock_guard lock(m_mutex);
+  return m_bytes;
+}
+
+void TileShapesCache::Erase(Entries::iterator it)
+{
+  ASSERT_GREATER_OR_EQUAL(m_bytes, it->m_bytes, ());
+  m_bytes -= it->m_bytes;
+  m_index.erase(it->m_key);
+  m_entries.erase(it);
+}
+}  // namespace df
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/traffic_generator.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace df
+{
+/// Result of a tile reading. Shapes are not changed after reading, so they are shared between
+/// the cache and messages to the backend renderer.
+struct TileShapes
+{
+  /// Approximate size of the shapes data in bytes.
+  size_t GetMemorySize() const;
+
+  std::set<MwmSet::MwmId> m_mwms;
+  TMapShapes m_geometry;
+  TMapShapes m_overlays;
+  TrafficSegmentsGeometry m_trafficGeometry;
+};
+
+/// LRU cache of tiles shapes, so a tile which is requested again (zoom out and in, returning to
+/// an area) is not read from mwms and its shapes are not generated again.
+/// Prepared shapes refer to texture regions, so the cache must be cleared on textures invalidation.
+/// Shapes also depend on data out of the key (e.g. metalines), so the cache is cleared on forced
+/// scene updates too.
+/// The cache is thread-safe.
+class TileShapesCache
+{
+public:
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+
+    // Only coordinates and zoom of the tile key are compared.
+    TileKey m_tileKey;
+    bool m_3dBuildings = false;
+    bool m_traffic = false;
+    bool m_isolines = false;
+    int8_t m_deviceLang = 0;
+  };
+
+  /// @param maxBytes Limit of the memory size of all cached tiles (see TileShapes::GetMemorySize()).
+  explicit TileShapesCache(size_t maxBytes);
+
+  /// @return Generation which should be passed to Put() for shapes which are read after the call.
+  uint64_t GetGeneration() const;
+
+  std::shared_ptr<TileShapes const> Find(Key const & key);
+  /// Shapes are not cached if the cache is invalidated after |generation| is taken,
+  /// because they may be read from outdated data.
+  void Put(Key const & key, std::shared_ptr<TileShapes const> shapes, uint64_t generation);
+
+  /// Removes shapes of tiles of all zooms and modes which intersect |rect|.
+  void Invalidate(m2::RectD const & rect);
+  void Clear();
+
+  size_t GetMemorySize() const;
+
+private:
+  struct Entry
+  {
+    Key m_key;
+    std::shared_ptr<TileShapes const> m_shapes;
+    // Shapes are not changed, so the size is calculated once.
+    size_t m_bytes = 0;
+  };
+
+  using Entries = std::list<Entry>;
+
+  void Erase(Entries::iterator it);
+
+  size_t const m_maxBytes;
+
+  mutable std::mutex m_mutex;
+  // Most recently used entries are at the front.
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+  size_t m_bytes = 0;
+  uint64_t m_generation = 0;
+};
+}  // namespace df
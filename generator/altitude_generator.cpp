@@ -1,5 +1,4 @@
 #include "generator/altitude_generator.hpp"
-#include "generator/srtm_parser.hpp"
 
 #include "routing/routing_helpers.hpp"
 
@@ -24,10 +23,12 @@
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include "defines.hpp"
 
 #include <algorithm>
+#include <future>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -42,21 +43,6 @@ namespace
 {
 using namespace routing;
 
-class SrtmGetter : public AltitudeGetter
-{
-public:
-  explicit SrtmGetter(std::string const & srtmDir) : m_srtmManager(srtmDir) {}
-
-  // AltitudeGetter overrides:
-  geometry::Altitude GetAltitude(m2::PointD const & p) override
-  {
-    return m_srtmManager.GetHeight(mercator::ToLatLon(p));
-  }
-
-private:
-  generator::SrtmTileManager m_srtmManager;
-};
-
 class Processor
 {
 public:
@@ -72,14 +58,17 @@ public:
     Altitudes m_altitudes;
   };
 
-  using TFeatureAltitudes = std::vector<FeatureAltitude>;
-
-  explicit Processor(AltitudeGetter & altitudeGetter)
-    : m_altitudeGetter(altitudeGetter), m_minAltitude(geometry::kInvalidAltitude)
+  struct RoadGeometry
   {
-  }
+    uint32_t m_featureId = 0;
+    std::vector<m2::PointD> m_points;
+  };
+
+  using TFeatureAltitudes = std::vector<FeatureAltitude>;
+  using TRoads = std::vector<RoadGeometry>;
 
   TFeatureAltitudes const & GetFeatureAltitudes() const { return m_featureAltitudes; }
+  TRoads const & GetRoads() const { return m_roads; }
 
   succinct::bit_vector_builder & GetAltitudeAvailabilityBuilder()
   {
@@ -88,18 +77,17 @@ public:
 
   geometry::Altitude GetMinAltitude() const { return m_minAltitude; }
 
+  // Collects geometry of road features. Altitudes are calculated later in CalculateAltitudes()
+  // to be able to do it in parallel.
   void operator()(FeatureType & f, uint32_t const & id)
   {
-    if (id != m_altitudeAvailabilityBuilder.size())
+    if (id != m_featuresCount)
     {
       LOG(LERROR, ("There's a gap in feature id order."));
       return;
     }
 
-    bool hasAltitude = false;
-    SCOPE_GUARD(altitudeAvailabilityBuilding,
-                [&]() { m_altitudeAvailabilityBuilder.push_back(hasAltitude); });
-
+    ++m_featuresCount;
     if (!routing::IsRoad(feature::TypesHolder(f)))
       return;
 
@@ -108,32 +96,77 @@ public:
     if (pointsCount == 0)
       return;
 
-    geometry::Altitudes altitudes;
-    geometry::Altitude minFeatureAltitude = geometry::kInvalidAltitude;
+    RoadGeometry road;
+    road.m_featureId = id;
+    road.m_points.reserve(pointsCount);
     for (size_t i = 0; i < pointsCount; ++i)
+      road.m_points.push_back(f.GetPoint(i));
+    m_roads.push_back(std::move(road));
+  }
+
+  /// @param getAltitude is called concurrently from |threadsCount| threads.
+  template <typename GetAltitudeFn>
+  void CalculateAltitudes(GetAltitudeFn const & getAltitude, size_t threadsCount)
+  {
+    // Empty altitudes mean that at least one point of the road has no altitude.
+    std::vector<geometry::Altitudes> roadAltitudes(m_roads.size());
+    auto const calculate = [&](size_t begin, size_t end)
     {
-      geometry::Altitude const a = m_altitudeGetter.GetAltitude(f.GetPoint(i));
-      if (a == geometry::kInvalidAltitude)
+      for (size_t i = begin; i < end; ++i)
       {
-        // One invalid point invalidates the whole feature.
-        return;
+        auto & altitudes = roadAltitudes[i];
+        for (auto const & p : m_roads[i].m_points)
+        {
+          geometry::Altitude const a = getAltitude(p);
+          if (a == geometry::kInvalidAltitude)
+          {
+            // One invalid point invalidates the whole feature.
+            altitudes.clear();
+            break;
+          }
+          altitudes.push_back(a);
+        }
       }
+    };
 
-      if (minFeatureAltitude == geometry::kInvalidAltitude)
-        minFeatureAltitude = a;
-      else
-        minFeatureAltitude = std::min(minFeatureAltitude, a);
-
-      altitudes.push_back(a);
+    if (threadsCount <= 1)
+    {
+      calculate(0, m_roads.size());
+    }
+    else
+    {
+      size_t constexpr kRoadsPerTask = 1024;
+      base::thread_pool::computational::ThreadPool pool(threadsCount);
+      std::vector<std::future<void>> results;
+      for (size_t begin = 0; begin < m_roads.size(); begin += kRoadsPerTask)
+        results.emplace_back(pool.Submit(calculate, begin, std::min(begin + kRoadsPerTask, m_roads.size())));
+      for (auto & r : results)
+        r.get();
     }
 
-    hasAltitude = true;
-    m_featureAltitudes.emplace_back(id, Altitudes(std::move(altitudes)));
+    size_t roadIdx = 0;
+    for (uint32_t id = 0; id < m_featuresCount; ++id)
+    {
+      bool hasAltitude = false;
+      if (roadIdx < m_roads.size() && m_roads[roadIdx].m_featureId == id)
+      {
+        auto & altitudes = roadAltitudes[roadIdx++];
+        if (!altitudes.empty())
+        {
+          hasAltitude = true;
+          auto const minFeatureAltitude = *std::min_element(altitudes.cbegin(), altitudes.cend());
+          if (m_minAltitude == geometry::kInvalidAltitude)
+            m_minAltitude = minFeatureAltitude;
+          else
+            m_minAltitude = std::min(minFeatureAltitude, m_minAltitude);
+
+          m_featureAltitudes.emplace_back(id, Altitudes(std::move(altitudes)));
+        }
+      }
+      m_altitudeAvailabilityBuilder.push_back(hasAltitude);
+    }
 
-    if (m_minAltitude == geometry::kInvalidAltitude)
-      m_minAltitude = minFeatureAltitude;
-    else
-      m_minAltitude = std::min(minFeatureAltitude, m_minAltitude);
+    TRoads().swap(m_roads);
   }
 
   bool HasAltitudeInfo() const { return !m_featureAltitudes.empty(); }
@@ -145,22 +178,22 @@ public:
   }
 
 private:
-  AltitudeGetter & m_altitudeGetter;
+  TRoads m_roads;
+  uint32_t m_featuresCount = 0;
   TFeatureAltitudes m_featureAltitudes;
   succinct::bit_vector_builder m_altitudeAvailabilityBuilder;
-  geometry::Altitude m_minAltitude;
+  geometry::Altitude m_minAltitude = geometry::kInvalidAltitude;
 };
-}  // namespace
 
-namespace routing
-{
-void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter)
+template <typename CalculateFn>
+void BuildRoadAltitudesImpl(std::string const & mwmPath, CalculateFn && calculateAltitudes)
 {
   try
   {
     // Preparing altitude information.
-    Processor processor(altitudeGetter);
+    Processor processor;
     feature::ForEachFeature(mwmPath, processor);
+    calculateAltitudes(processor);
 
     if (!processor.HasAltitudeInfo())
     {
@@ -232,11 +265,51 @@ void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGe
     LOG(LERROR, ("An exception happened while creating", ALTITUDES_FILE_TAG, "section:", e.what()));
   }
 }
+}  // namespace
+
+namespace routing
+{
+void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter)
+{
+  BuildRoadAltitudesImpl(mwmPath, [&altitudeGetter](Processor & processor)
+  {
+    processor.CalculateAltitudes([&altitudeGetter](m2::PointD const & p)
+    {
+      return altitudeGetter.GetAltitude(p);
+    }, 1 /* threadsCount */);
+  });
+}
+
+void BuildRoadAltitudes(std::string const & mwmPath, generator::SrtmTileManager & srtmManager,
+                        size_t threadsCount)
+{
+  BuildRoadAltitudesImpl(mwmPath, [&](Processor & processor)
+  {
+    // Load all needed tiles at once, so altitudes can be read without locks.
+    // Neighbouring road points are mostly in the same tile, so store only tile changes.
+    std::vector<ms::LatLon> tileCenters;
+    for (auto const & road : processor.GetRoads())
+    {
+      for (auto const & p : road.m_points)
+      {
+        auto const center = generator::SrtmTile::GetCenter(mercator::ToLatLon(p));
+        if (tileCenters.empty() || !(tileCenters.back() == center))
+          tileCenters.push_back(center);
+      }
+    }
+    srtmManager.Prefetch(tileCenters, threadsCount);
+
+    processor.CalculateAltitudes([&srtmManager](m2::PointD const & p)
+    {
+      return srtmManager.GetLoadedHeight(mercator::ToLatLon(p));
+    }, threadsCount);
+  });
+}
 
-void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir)
+void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir, size_t threadsCount)
 {
   LOG(LINFO, ("mwmPath =", mwmPath, "srtmDir =", srtmDir));
-  SrtmGetter srtmGetter(srtmDir);
-  BuildRoadAltitudes(mwmPath, srtmGetter);
+  generator::SrtmTileManager srtmManager(srtmDir);
+  BuildRoadAltitudes(mwmPath, srtmManager, threadsCount);
 }
 }  // namespace routing
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "generator/srtm_parser.hpp"
+
 #include "geometry/point2d.hpp"
 #include "geometry/point_with_altitude.hpp"
 
 #include "indexer/feature_altitude.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace routing
@@ -26,5 +29,10 @@ public:
 /// feat. table offset  feature table         alt. info offset - feat. table offset
 /// alt. info offset    altitude info         end of section - alt. info offset
 void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter);
-void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir);
+/// Loads needed SRTM tiles and calculates altitudes of roads using |threadsCount| threads.
+/// Pass the same |srtmManager| for several mwms to reuse already loaded tiles.
+void BuildRoadAltitudes(std::string const & mwmPath, generator::SrtmTileManager & srtmManager,
+                        size_t threadsCount = 1);
+void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir,
+                        size_t threadsCount = 1);
 }  // namespace routing
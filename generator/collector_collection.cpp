@@ -3,11 +3,24 @@
 #include "generator/feature_builder.hpp"
 #include "generator/intermediate_elements.hpp"
 #include "generator/osm_element.hpp"
+#include "generator/profiler.hpp"
+
+#include "base/file_name_utils.hpp"
 
 using namespace feature;
 
 namespace generator
 {
+namespace
+{
+std::string GetStageName(CollectorInterface const & collector, char const * pass)
+{
+  auto const & filename = collector.GetFilename();
+  return std::string("collector/") + (filename.empty() ? "unnamed" : base::FileNameFromFullPath(filename)) +
+         "/" + pass;
+}
+}  // namespace
+
 std::shared_ptr<CollectorInterface> CollectorCollection::Clone(IDRInterfacePtr const & cache) const
 {
   auto p = std::make_shared<CollectorCollection>();
@@ -37,19 +50,28 @@ void CollectorCollection::CollectFeature(FeatureBuilder const & feature, OsmElem
 void CollectorCollection::Finish()
 {
   for (auto & c : m_collection)
+  {
+    profiler::ScopedStage stage(GetStageName(*c, "finish"));
     c->Finish();
+  }
 }
 
 void CollectorCollection::Save()
 {
   for (auto & c : m_collection)
+  {
+    profiler::ScopedStage stage(GetStageName(*c, "save"));
     c->Save();
+  }
 }
 
 void CollectorCollection::OrderCollectedData()
 {
   for (auto & c : m_collection)
+  {
+    profiler::ScopedStage stage(GetStageName(*c, "order"));
     c->OrderCollectedData();
+  }
 }
 
 void CollectorCollection::MergeInto(CollectorCollection & collector) const
@@ -57,6 +79,9 @@ void CollectorCollection::MergeInto(CollectorCollection & collector) const
   auto & otherCollection = collector.m_collection;
   CHECK_EQUAL(m_collection.size(), otherCollection.size(), ());
   for (size_t i = 0; i < m_collection.size(); ++i)
+  {
+    profiler::ScopedStage stage(GetStageName(*m_collection[i], "merge"));
     otherCollection[i]->Merge(*m_collection[i]);
+  }
 }
 }  // namespace generator
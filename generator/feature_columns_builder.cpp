@@ -0,0 +1,63 @@
+#include "generator/feature_columns_builder.hpp"
+
+#include "indexer/feature_columns.hpp"
+#include "indexer/features_offsets_table.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/metadata_serdes.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include <memory>
+
+#include "defines.hpp"
+
+namespace indexer
+{
+bool BuildFeatureColumnsFromDataFile(std::string const & filename, bool forceRebuild)
+{
+  try
+  {
+    std::unique_ptr<feature::FeatureColumnsBuilder> builder;
+
+    {
+      FilesContainerR rcont(filename);
+      if (!forceRebuild && rcont.IsExist(FEATURE_COLUMNS_FILE_TAG))
+        return true;
+
+      auto const table = feature::FeaturesOffsetsTable::Load(rcont);
+      if (!table)
+      {
+        LOG(LERROR, ("Can't load offsets table from:", filename));
+        return false;
+      }
+
+      std::unique_ptr<MetadataDeserializer> metaDeserializer;
+      if (rcont.IsExist(METADATA_FILE_TAG))
+        metaDeserializer = MetadataDeserializer::Load(rcont);
+
+      feature::DataHeader const header(rcont);
+      FeaturesVector const features(rcont, header, table.get(), metaDeserializer.get());
+
+      builder = std::make_unique<feature::FeatureColumnsBuilder>(
+          header.GetBounds(), feature::FeatureColumns::GetDefaultMetadata());
+      features.ForEach([&](FeatureType & ft, uint32_t featureId) { builder->Put(featureId, ft); });
+    }
+
+    {
+      FilesContainerW writeContainer(filename, FileWriter::OP_WRITE_EXISTING);
+      auto writer = writeContainer.GetWriter(FEATURE_COLUMNS_FILE_TAG);
+      builder->Freeze(*writer);
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to build feature columns:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace indexer
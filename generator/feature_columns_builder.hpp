@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+namespace indexer
+{
+// Builds the optional feature columns section (see feature::FeatureColumns)
+// with the default metadata columns and writes it to the mwm file.
+bool BuildFeatureColumnsFromDataFile(std::string const & filename, bool forceRebuild = false);
+}  // namespace indexer
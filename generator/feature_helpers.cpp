@@ -59,6 +59,8 @@ m2::PointD CalculateMidPoints::GetCenter() const
 
 void CalculateMidPoints::Sort()
 {
-  std::sort(m_vec.begin(), m_vec.end(), base::LessBy(&CellAndOffset::first));
+  // Compare offsets too to keep the file order of features with equal cells.
+  // The same order is produced by the external sort in GenerateFinalFeatures.
+  std::sort(m_vec.begin(), m_vec.end());
 }
 }  // namespace feature
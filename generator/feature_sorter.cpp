@@ -19,6 +19,7 @@
 #include "platform/mwm_version.hpp"
 #include "platform/platform.hpp"
 
+#include "coding/file_sort.hpp"
 #include "coding/files_container.hpp"
 #include "coding/point_coding.hpp"
 #include "coding/succinct_mapper.hpp"
@@ -27,6 +28,7 @@
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include "defines.hpp"
 
@@ -38,12 +40,22 @@
 
 namespace feature
 {
+namespace
+{
+// Raw features files bigger than this are sorted externally: features are read sequentially
+// and sorted in bounded memory chunks instead of random seeks over the whole file.
+uint64_t constexpr kExternalSortThresholdBytes = 4ULL * 1024 * 1024 * 1024;
+size_t constexpr kExternalSortBufferBytes = 1024 * 1024 * 1024;
+
+// Areas with more points are tesselated for all geometry scales simultaneously.
+size_t constexpr kParallelTesselationMinPoints = 2048;
+}  // namespace
 
 class FeaturesCollector2 : public FeaturesCollector
 {
 public:
   FeaturesCollector2(std::string const & name, feature::GenerateInfo const & info, DataHeader const & header,
-                     RegionData const & regionData, uint32_t versionDate)
+                     RegionData const & regionData, uint32_t versionDate, size_t threadsCount)
     : FeaturesCollector(info.GetTargetFileName(name, FEATURES_FILE_TAG))
     , m_filename(info.GetTargetFileName(name))
     , m_boundaryPostcodesEnricher(info.GetIntermediateFileName(BOUNDARY_POSTCODES_FILENAME))
@@ -59,6 +71,9 @@ public:
     }
 
     m_addrFile = std::make_unique<FileWriter>(info.GetIntermediateFileName(name + DATA_FILE_EXTENSION, TEMP_ADDR_EXTENSION));
+
+    if (threadsCount > 1)
+      m_tesselationPool = std::make_unique<base::thread_pool::computational::ThreadPool>(threadsCount);
   }
 
   void Finish() override
@@ -157,6 +172,8 @@ public:
       m2::RectD const & rect = fb.GetLimitRect();
       Polygons const & polys = fb.GetGeometry();
       bool const isCoast = fb.IsCoastCell();
+      bool const isParallelTesselation =
+          isArea && m_tesselationPool && fb.GetPointsCount() >= kParallelTesselationMinPoints;
 
       int const scalesStart = static_cast<int>(m_header.GetScalesCount()) - 1;
       for (int i = scalesStart; i >= 0; --i)
@@ -244,10 +261,18 @@ public:
             }
 
             if (!simplified.empty())
-              holder.AddTriangles(simplified, i);
+            {
+              if (isParallelTesselation)
+                holder.EnqueueTriangles(std::move(simplified), i);
+              else
+                holder.AddTriangles(simplified, i);
+            }
           }
         }
       }
+
+      if (isParallelTesselation)
+        holder.FlushTriangles(*m_tesselationPool);
     }
 
     // Override "alt_name" with synonym for Country or State for better search matching.
@@ -348,11 +373,13 @@ private:
 
   indexer::SynonymsHolder m_synonyms;
 
+  std::unique_ptr<base::thread_pool::computational::ThreadPool> m_tesselationPool;
+
   DISALLOW_COPY_AND_MOVE(FeaturesCollector2);
 };
 
 bool GenerateFinalFeatures(feature::GenerateInfo const & info, std::string const & name,
-                           feature::DataHeader::MapType mapType)
+                           feature::DataHeader::MapType mapType, size_t threadsCount)
 {
   std::string const srcFilePath = info.GetTmpFileName(name);
   std::string const dataFilePath = info.GetTargetFileName(name);
@@ -365,12 +392,14 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, std::string const
     midPoints(fb, pos);
   });
 
-  // Sort features by their middle point.
-  midPoints.Sort();
-
   // Store sorted features.
   {
     FileReader reader(srcFilePath);
+    bool const useExternalSort = reader.Size() > kExternalSortThresholdBytes;
+
+    // Sort features by their middle point.
+    if (!useExternalSort)
+      midPoints.Sort();
     // Fill mwm header.
     DataHeader header;
 
@@ -398,15 +427,46 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, std::string const
       SCOPE_GUARD(_, [&]() { Platform::RemoveFileIfExists(info.GetTargetFileName(name, FEATURES_FILE_TAG)); });
       LOG(LINFO, ("Simplifying and filtering geometry for all geom levels"));
 
-      FeaturesCollector2 collector(name, info, header, regionData, info.m_versionDate);
-      for (auto const & point : midPoints.GetVector())
+      FeaturesCollector2 collector(name, info, header, regionData, info.m_versionDate, threadsCount);
+      if (useExternalSort)
       {
+        LOG(LINFO, ("Sorting", reader.Size(), "bytes of features externally"));
+
+        auto const toCollector = [&collector](uint64_t, std::vector<uint8_t> const & blob)
+        {
+          FeatureBuilder::Buffer buffer(blob.begin(), blob.end());
+          FeatureBuilder fb;
+          serialization_policy::MaxAccuracy::Deserialize(fb, buffer);
+          collector(fb);
+        };
+
+        // Middle points are stored in the file order, so match them with features by offset.
+        auto const & points = midPoints.GetVector();
+        BlobFileSorter<uint64_t, decltype(toCollector)> sorter(
+            kExternalSortBufferBytes, info.GetIntermediateFileName(name, ".sort.tmp"), toCollector);
         ReaderSource<FileReader> src(reader);
-        src.Skip(point.second);
+        std::vector<uint8_t> buffer;
+        for (size_t i = 0; i < points.size();)
+        {
+          auto const pos = src.Pos();
+          buffer.resize(ReadVarUint<uint32_t>(src));
+          src.Read(buffer.data(), buffer.size());
+          if (points[i].second == pos)
+            sorter.Add(points[i++].first, buffer.data(), buffer.size());
+        }
+        sorter.SortAndFinish();
+      }
+      else
+      {
+        for (auto const & point : midPoints.GetVector())
+        {
+          ReaderSource<FileReader> src(reader);
+          src.Skip(point.second);
 
-        FeatureBuilder fb;
-        ReadFromSourceRawFormat(src, fb);
-        collector(fb);
+          FeatureBuilder fb;
+          ReadFromSourceRawFormat(src, fb);
+          collector(fb);
+        }
       }
 
       LOG(LINFO, ("Writing features' data to", dataFilePath));
@@ -0,0 +1,65 @@
+#include "generator/features_blocks_builder.hpp"
+
+#include "indexer/dat_section_header.hpp"
+#include "indexer/features_blocks.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/writer.hpp"
+
+#include "base/checked_cast.hpp"
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include <vector>
+
+#include "defines.hpp"
+
+namespace feature
+{
+bool BuildFeaturesBlocks(std::string const & filename, uint32_t blockSize)
+{
+  try
+  {
+    std::vector<uint8_t> features;
+    std::vector<uint8_t> blocks;
+
+    {
+      FilesContainerR const rcont(filename);
+      if (rcont.IsExist(FEATURES_BLOCKS_FILE_TAG))
+      {
+        LOG(LINFO, ("Features are already compressed in", filename));
+        return true;
+      }
+
+      auto const reader = rcont.GetReader(FEATURES_FILE_TAG);
+      DatSectionHeader header;
+      header.Read(*reader.GetPtr());
+
+      {
+        MemWriter<std::vector<uint8_t>> writer(blocks);
+        FeaturesBlocks::Build(*reader.SubReader(header.m_featuresOffset, header.m_featuresSize).GetPtr(),
+                              writer, blockSize);
+      }
+
+      MemWriter<std::vector<uint8_t>> writer(features);
+      header.m_version = DatSectionHeader::Version::V1;
+      header.m_featuresSize = 0;
+      header.Serialize(writer);
+      header.m_featuresOffset = base::checked_cast<uint32_t>(writer.Pos());
+      writer.Seek(0);
+      header.Serialize(writer);
+    }
+
+    FilesContainerW wcont(filename, FileWriter::OP_WRITE_EXISTING);
+    wcont.Write(features, FEATURES_FILE_TAG);
+    wcont.Write(blocks, FEATURES_BLOCKS_FILE_TAG);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to compress features:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace feature
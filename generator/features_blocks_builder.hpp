@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace feature
+{
+// Moves feature records of the mwm to the block compressed section (see feature::FeaturesBlocks).
+// The features section keeps its header only, with DatSectionHeader::Version::V1, so versions
+// without the compressed section support reject the mwm. Should be the last step of the mwm
+// generation.
+bool BuildFeaturesBlocks(std::string const & filename, uint32_t blockSize);
+}  // namespace feature
@@ -9,6 +9,7 @@
 #include "generator/mini_roundabout_transformer.hpp"
 #include "generator/node_mixer.hpp"
 #include "generator/osm2type.hpp"
+#include "generator/profiler.hpp"
 #include "generator/region_meta.hpp"
 
 #include "routing/speed_camera_prohibition.hpp"
@@ -67,20 +68,35 @@ void CountryFinalProcessor::Process()
 {
   //Order();
 
+  using profiler::ScopedStage;
+
   if (!m_coastlineGeomFilename.empty())
+  {
+    ScopedStage stage("final_processor/country/coastline");
     ProcessCoastline();
+  }
 
   // Add here all "straight-way" processing. There is no need to make many functions and
   // many read-write FeatureBuilder ops here.
   if (!m_miniRoundaboutsFilename.empty() || !m_addrInterpolFilename.empty())
+  {
+    ScopedStage stage("final_processor/country/roundabouts");
     ProcessRoundabouts();
+  }
 
   if (!m_fakeNodesFilename.empty())
+  {
+    ScopedStage stage("final_processor/country/fake_nodes");
     AddFakeNodes();
+  }
   if (!m_isolinesPath.empty())
+  {
+    ScopedStage stage("final_processor/country/isolines");
     AddIsolines();
+  }
 
   //DropProhibitedSpeedCameras();
+  ScopedStage stage("final_processor/country/building_parts");
   ProcessBuildingParts();
 
   //Finish();
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "base/assert.hpp"
+
 #include <cstdint>
+#include <string>
 
 namespace generator
 {
@@ -11,6 +14,17 @@ enum class FinalProcessorPriority : uint8_t
   Places,
 };
 
+inline std::string DebugPrint(FinalProcessorPriority priority)
+{
+  switch (priority)
+  {
+  case FinalProcessorPriority::CountriesOrWorld: return "countries_or_world";
+  case FinalProcessorPriority::WorldCoasts: return "world_coasts";
+  case FinalProcessorPriority::Places: return "places";
+  }
+  UNREACHABLE();
+}
+
 // Classes that inherit this interface implement the final stage of intermediate mwm processing.
 // For example, attempt to merge the coastline or adding external elements.
 // Each derived class has a priority. This is done to comply with the order of processing
@@ -28,6 +42,8 @@ public:
 
   virtual void Process() = 0;
 
+  FinalProcessorPriority GetPriority() const { return m_priority; }
+
   bool operator<(FinalProcessorIntermediateMwmInterface const & other) const
   {
     return m_priority < other.m_priority;
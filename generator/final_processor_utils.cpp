@@ -9,26 +9,29 @@ namespace generator
 {
 using namespace feature;
 
-bool Less(FeatureBuilder const & lhs, FeatureBuilder const & rhs)
+bool OrderKey::operator<(OrderKey const & rhs) const
 {
-  auto const lGeomType = static_cast<int8_t>(lhs.GetGeomType());
-  auto const rGeomType = static_cast<int8_t>(rhs.GetGeomType());
+  return std::tie(m_geomType, m_id, m_pointsCount, m_keyPoint) <
+         std::tie(rhs.m_geomType, rhs.m_id, rhs.m_pointsCount, rhs.m_keyPoint);
+}
 
+OrderKey GetOrderKey(FeatureBuilder const & fb)
+{
+  OrderKey key;
+  key.m_geomType = static_cast<int8_t>(fb.GetGeomType());
   // may be empty IDs
-  auto const lId = lhs.GetMostGenericOsmId();
-  auto const rId = rhs.GetMostGenericOsmId();
-
-  auto const lPointsCount = lhs.GetPointsCount();
-  auto const rPointsCount = rhs.GetPointsCount();
-
-  auto const lKeyPoint = lhs.GetKeyPoint();
-  auto const rKeyPoint = rhs.GetKeyPoint();
+  key.m_id = fb.GetMostGenericOsmId();
+  key.m_pointsCount = fb.GetPointsCount();
+  key.m_keyPoint = fb.GetKeyPoint();
+  return key;
+}
 
-  return std::tie(lGeomType, lId, lPointsCount, lKeyPoint) <
-         std::tie(rGeomType, rId, rPointsCount, rKeyPoint);
+bool Less(FeatureBuilder const & lhs, FeatureBuilder const & rhs)
+{
+  return GetOrderKey(lhs) < GetOrderKey(rhs);
 }
 
-void Order(std::vector<FeatureBuilder> & fbs) { std::sort(std::begin(fbs), std::end(fbs), Less); }
+void Order(std::vector<FeatureBuilder> & fbs) { std::stable_sort(std::begin(fbs), std::end(fbs), Less); }
 
 void OrderTextFileByLine(std::string const & filename)
 {
@@ -5,7 +5,12 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/file_sort.hpp"
+#include "coding/varint.hpp"
+
 #include "base/file_name_utils.hpp"
+#include "base/geo_object_id.hpp"
+#include "base/logging.hpp"
 #include "base/string_utils.hpp"
 #include "base/thread_pool_computational.hpp"
 
@@ -66,10 +71,74 @@ std::vector<std::vector<std::string>> AppendToMwmTmp(std::vector<feature::Featur
   return affiliations;
 }
 
+// Fields of a feature which define its order in final processors.
+struct OrderKey
+{
+  bool operator<(OrderKey const & rhs) const;
+
+  int8_t m_geomType = 0;
+  base::GeoObjectId m_id;
+  size_t m_pointsCount = 0;
+  m2::PointD m_keyPoint;
+};
+
+OrderKey GetOrderKey(feature::FeatureBuilder const & fb);
+
 bool Less(feature::FeatureBuilder const & lhs, feature::FeatureBuilder const & rhs);
 
 // Ordering for stable features order in final processors.
+// Features with equal OrderKey keep their order in |fbs|, as in ForEachFeatureOrdered.
 void Order(std::vector<feature::FeatureBuilder> & fbs);
 
+// Features files up to this size are ordered in memory. Bigger ones are ordered externally
+// in chunks of this size.
+uint64_t constexpr kOrderInMemoryMaxBytes = 1024ULL * 1024 * 1024;
+
+// Calls |toDo| for each feature of |filename| in the Order() order. Files bigger than
+// |inMemoryMaxBytes| are sorted with BlobFileSorter, so only a chunk of serialized features
+// is kept in memory instead of all features of the file.
+template <class SerializationPolicy = feature::serialization_policy::MaxAccuracy, class ToDo>
+void ForEachFeatureOrdered(std::string const & filename, ToDo && toDo,
+                           uint64_t inMemoryMaxBytes = kOrderInMemoryMaxBytes)
+{
+  uint64_t fileSize = 0;
+  // Happens in tests when World or Country file is empty (no valid Features to emit).
+  if (!Platform::GetFileSizeByFullPath(filename, fileSize))
+    return;
+
+  if (fileSize <= inMemoryMaxBytes)
+  {
+    auto fbs = feature::ReadAllDatRawFormat<SerializationPolicy>(filename);
+    Order(fbs);
+    for (auto & fb : fbs)
+      toDo(fb);
+    return;
+  }
+
+  LOG(LINFO, ("Ordering", fileSize, "bytes of features of", filename, "externally"));
+  auto const sink = [&toDo](OrderKey const &, std::vector<uint8_t> const & blob)
+  {
+    feature::FeatureBuilder::Buffer buffer(blob.begin(), blob.end());
+    feature::FeatureBuilder fb;
+    SerializationPolicy::Deserialize(fb, buffer);
+    toDo(fb);
+  };
+
+  BlobFileSorter<OrderKey, decltype(sink)> sorter(inMemoryMaxBytes, filename + ".sort.tmp", sink);
+  FileReader reader(filename);
+  ReaderSource<FileReader> src(reader);
+  feature::FeatureBuilder::Buffer buffer;
+  while (src.Size() > 0)
+  {
+    buffer.resize(ReadVarUint<uint32_t>(src));
+    src.Read(buffer.data(), buffer.size());
+
+    feature::FeatureBuilder fb;
+    SerializationPolicy::Deserialize(fb, buffer);
+    sorter.Add(GetOrderKey(fb), buffer.data(), buffer.size());
+  }
+  sorter.SortAndFinish();
+}
+
 void OrderTextFileByLine(std::string const & filename);
 }  // namespace generator
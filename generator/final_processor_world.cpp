@@ -2,7 +2,10 @@
 #include "generator/feature_builder.hpp"
 #include "generator/final_processor_utils.hpp"
 
+#include "coding/internal/file_data.hpp"
+
 #include "base/logging.hpp"
+#include "base/scope_guard.hpp"
 
 #include "defines.hpp"
 
@@ -22,12 +25,18 @@ WorldFinalProcessor::WorldFinalProcessor(std::string const & temporaryMwmPath,
 
 void WorldFinalProcessor::Process()
 {
-  auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(m_worldTmpFilename);
-  Order(fbs);
+  // WorldGenerator rewrites the World file, so features are streamed from a renamed one.
+  auto const srcFilename = m_worldTmpFilename + ".src";
+  if (Platform::IsFileExistsByFullPath(m_worldTmpFilename))
+    CHECK(base::RenameFileX(m_worldTmpFilename, srcFilename), (m_worldTmpFilename));
+  SCOPE_GUARD(removeSrcFile, [&srcFilename]() { Platform::RemoveFileIfExists(srcFilename); });
+
   WorldGenerator generator(m_worldTmpFilename, m_coastlineGeomFilename, m_popularPlacesFilename);
   LOG(LINFO, ("Process World features"));
-  for (auto & fb : fbs)
+  ForEachFeatureOrdered(srcFilename, [&generator](FeatureBuilder & fb)
+  {
     generator.Process(fb);
+  });
 
   LOG(LINFO, ("Merge World lines"));
   generator.DoMerge();
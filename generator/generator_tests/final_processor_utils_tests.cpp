@@ -0,0 +1,118 @@
+#include "testing/testing.hpp"
+
+#include "generator/feature_builder.hpp"
+#include "generator/final_processor_utils.hpp"
+#include "generator/generator_tests_support/test_with_classificator.hpp"
+
+#include "indexer/classificator.hpp"
+
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "base/geo_object_id.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace final_processor_utils_tests
+{
+using namespace feature;
+using namespace generator;
+using generator::tests_support::TestWithClassificator;
+using platform::tests_support::ScopedFile;
+
+std::vector<FeatureBuilder> MakeFeatures(size_t count)
+{
+  std::mt19937 rng(0);
+  std::vector<FeatureBuilder> fbs(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto & fb = fbs[i];
+    FeatureBuilderParams params;
+    params.AddType(classif().GetTypeByPath({"amenity", "cafe"}));
+    fb.SetParams(params);
+    // Some features share an id to check ordering by the other fields.
+    fb.AddOsmId(base::MakeOsmNode(rng() % (count / 2)));
+    fb.SetCenter({static_cast<double>(rng() % 100), static_cast<double>(rng() % 100)});
+  }
+  return fbs;
+}
+
+UNIT_CLASS_TEST(TestWithClassificator, ForEachFeatureOrdered_External)
+{
+  ScopedFile const file("final_processor_utils_test.mwm.tmp", ScopedFile::Mode::DoNotCreate);
+  auto const fbs = MakeFeatures(300);
+  {
+    FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(file.GetFullPath());
+    for (auto const & fb : fbs)
+      writer.Write(fb);
+  }
+
+  auto expected = fbs;
+  Order(expected);
+
+  for (uint64_t inMemoryMaxBytes : {kOrderInMemoryMaxBytes, uint64_t(2000)})
+  {
+    std::vector<FeatureBuilder> ordered;
+    ForEachFeatureOrdered(file.GetFullPath(), [&ordered](FeatureBuilder & fb)
+    {
+      ordered.push_back(fb);
+    }, inMemoryMaxBytes);
+
+    TEST_EQUAL(ordered.size(), expected.size(), (inMemoryMaxBytes));
+    for (size_t i = 0; i < ordered.size(); ++i)
+    {
+      TEST(!Less(ordered[i], expected[i]) && !Less(expected[i], ordered[i]),
+           (inMemoryMaxBytes, i, ordered[i], expected[i]));
+    }
+  }
+}
+
+UNIT_CLASS_TEST(TestWithClassificator, ForEachFeatureOrdered_SameBytes)
+{
+  ScopedFile const file("final_processor_utils_test.mwm.tmp", ScopedFile::Mode::DoNotCreate);
+  // Features with equal order keys differ by names only, so any tie reordering changes the bytes.
+  std::vector<FeatureBuilder> fbs(300);
+  for (size_t i = 0; i < fbs.size(); ++i)
+  {
+    FeatureBuilderParams params;
+    params.AddType(classif().GetTypeByPath({"amenity", "cafe"}));
+    params.AddName("default", "Cafe " + std::to_string(i));
+    fbs[i].SetParams(params);
+    fbs[i].AddOsmId(base::MakeOsmNode(i % 7));
+    fbs[i].SetCenter({static_cast<double>(i % 3), 0.0});
+  }
+  {
+    FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(file.GetFullPath());
+    for (auto const & fb : fbs)
+      writer.Write(fb);
+  }
+
+  auto const serialize = [](FeatureBuilder const & fb, FeatureBuilder::Buffer & bytes)
+  {
+    FeatureBuilder::Buffer buffer;
+    serialization_policy::MaxAccuracy::Serialize(fb, buffer);
+    bytes.insert(bytes.end(), buffer.begin(), buffer.end());
+  };
+
+  FeatureBuilder::Buffer expected;
+  Order(fbs);
+  for (auto const & fb : fbs)
+    serialize(fb, expected);
+
+  for (uint64_t inMemoryMaxBytes : {kOrderInMemoryMaxBytes, uint64_t(2000), uint64_t(0)})
+  {
+    FeatureBuilder::Buffer bytes;
+    ForEachFeatureOrdered(file.GetFullPath(), [&](FeatureBuilder & fb) { serialize(fb, bytes); },
+                          inMemoryMaxBytes);
+    TEST(bytes == expected, (inMemoryMaxBytes));
+  }
+}
+
+UNIT_TEST(ForEachFeatureOrdered_NoFile)
+{
+  size_t count = 0;
+  ForEachFeatureOrdered("non-existing.mwm.tmp", [&count](FeatureBuilder &) { ++count; });
+  TEST_EQUAL(count, 0, ());
+}
+}  // namespace final_processor_utils_tests
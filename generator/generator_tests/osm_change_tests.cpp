@@ -0,0 +1,186 @@
+#include "testing/testing.hpp"
+
+#include "generator/borders.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/osm_change.hpp"
+#include "generator/osm_element.hpp"
+#include "generator/osm_source.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osm_change_tests
+{
+using namespace generator;
+using std::string, std::vector;
+
+// Old positions from the previous build, mercator coordinates.
+std::unordered_map<uint64_t, m2::PointD> const kNodes = {
+    {1, {-5.0, 5.0}}, {2, {-6.0, 5.0}}, {3, {5.0, 5.0}}, {4, {6.0, 5.0}}, {5, {25.0, 5.0}}};
+
+std::unordered_map<uint64_t, WayElement> const kWays = {{10, WayElement(10, {1, 2})}};
+
+class IntermediateDataReaderTest : public cache::IntermediateDataReaderInterface
+{
+  bool GetNode(uint64_t id, double & y, double & x) const override
+  {
+    auto const it = kNodes.find(id);
+    if (it == kNodes.end())
+      return false;
+
+    y = it->second.y;
+    x = it->second.x;
+    return true;
+  }
+
+  bool GetWay(uint64_t id, WayElement & e) override
+  {
+    auto const it = kWays.find(id);
+    if (it == kWays.end())
+      return false;
+
+    e = it->second;
+    return true;
+  }
+
+  bool GetRelation(uint64_t id, RelationElement & e) override
+  {
+    if (id != 20)
+      return false;
+
+    e.m_nodes.emplace_back(5, "");
+    return true;
+  }
+};
+
+borders::CountryPolygons MakeCountry(string const & name, double minX, double maxX)
+{
+  borders::PolygonsTree tree;
+  m2::RegionD region(vector<m2::PointD>{{minX, 0.0}, {maxX, 0.0}, {maxX, 10.0}, {minX, 10.0}});
+  auto const rect = region.GetRect();
+  tree.Add(std::move(region), rect);
+  return borders::CountryPolygons(name, tree);
+}
+
+borders::CountryPolygonsCollection MakeCountries()
+{
+  borders::CountryPolygonsCollection countries;
+  countries.Add(MakeCountry("Left", -10.0, -1.0));
+  countries.Add(MakeCountry("Right", 1.0, 10.0));
+  countries.Add(MakeCountry("Far", 20.0, 30.0));
+  countries.Add(MakeCountry("Untouched", 40.0, 50.0));
+  return countries;
+}
+
+OsmElement MakeNode(uint64_t id, m2::PointD const & point)
+{
+  OsmElement node;
+  node.m_type = OsmElement::EntityType::Node;
+  node.m_id = id;
+  auto const latLon = mercator::ToLatLon(point);
+  node.m_lat = latLon.m_lat;
+  node.m_lon = latLon.m_lon;
+  return node;
+}
+
+UNIT_TEST(OsmChange_Parse)
+{
+  std::istringstream stream(R"(<?xml version="1.0" encoding="UTF-8"?>
+<osmChange version="0.6">
+  <create>
+    <node id="1" lat="10.5" lon="20.5">
+      <tag k="amenity" v="cafe"/>
+    </node>
+  </create>
+  <modify>
+    <way id="2">
+      <nd ref="1"/>
+      <nd ref="3"/>
+      <tag k="highway" v="primary"/>
+    </way>
+  </modify>
+  <delete>
+    <relation id="4">
+      <member type="way" ref="2" role="outer"/>
+    </relation>
+  </delete>
+</osmChange>)");
+
+  SourceReader reader(stream);
+  vector<std::pair<OsmChangeAction, OsmElement>> changes;
+  ProcessOsmChangeFromXML(reader, [&changes](OsmChangeAction action, OsmElement && element)
+  {
+    changes.emplace_back(action, std::move(element));
+  });
+
+  TEST_EQUAL(changes.size(), 3, ());
+
+  TEST_EQUAL(changes[0].first, OsmChangeAction::Create, ());
+  TEST(changes[0].second.IsNode(), ());
+  TEST_EQUAL(changes[0].second.m_id, 1, ());
+  TEST_EQUAL(changes[0].second.m_lat, 10.5, ());
+  TEST_EQUAL(changes[0].second.GetTag("amenity"), "cafe", ());
+
+  TEST_EQUAL(changes[1].first, OsmChangeAction::Modify, ());
+  TEST(changes[1].second.IsWay(), ());
+  TEST_EQUAL(changes[1].second.Nodes(), vector<uint64_t>({1, 3}), ());
+
+  TEST_EQUAL(changes[2].first, OsmChangeAction::Delete, ());
+  TEST(changes[2].second.IsRelation(), ());
+  TEST_EQUAL(changes[2].second.Members().size(), 1, ());
+  TEST_EQUAL(changes[2].second.Members()[0].m_ref, 2, ());
+}
+
+UNIT_TEST(OsmChange_ChangedCountries)
+{
+  auto const countries = MakeCountries();
+  IntermediateDataReaderTest cache;
+
+  {
+    // A node is moved from Left to Right.
+    ChangedCountriesFinder finder(countries, cache);
+    finder.Add(OsmChangeAction::Modify, MakeNode(1, {5.5, 5.0}));
+    TEST_EQUAL(finder.Finish(), std::set<string>({"Left", "Right"}), ());
+  }
+  {
+    // A way in Left gets a new node in Right.
+    ChangedCountriesFinder finder(countries, cache);
+    finder.Add(OsmChangeAction::Create, MakeNode(100, {7.0, 5.0}));
+    OsmElement way;
+    way.m_type = OsmElement::EntityType::Way;
+    way.m_id = 10;
+    way.AddNd(1);
+    way.AddNd(100);
+    finder.Add(OsmChangeAction::Modify, std::move(way));
+    TEST_EQUAL(finder.Finish(), std::set<string>({"Left", "Right"}), ());
+  }
+  {
+    // A relation is deleted: its old members in Far are taken from the cache.
+    ChangedCountriesFinder finder(countries, cache);
+    OsmElement relation;
+    relation.m_type = OsmElement::EntityType::Relation;
+    relation.m_id = 20;
+    finder.Add(OsmChangeAction::Delete, std::move(relation));
+    TEST_EQUAL(finder.Finish(), std::set<string>({"Far"}), ());
+  }
+  {
+    // A new relation with an existing way of Left.
+    ChangedCountriesFinder finder(countries, cache);
+    OsmElement relation;
+    relation.m_type = OsmElement::EntityType::Relation;
+    relation.m_id = 21;
+    relation.AddMember(10, OsmElement::EntityType::Way, "outer");
+    relation.AddMember(3, OsmElement::EntityType::Node, "label");
+    finder.Add(OsmChangeAction::Create, std::move(relation));
+    TEST_EQUAL(finder.Finish(), std::set<string>({"Left", "Right"}), ());
+  }
+}
+}  // namespace osm_change_tests
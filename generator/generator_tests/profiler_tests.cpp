@@ -0,0 +1,110 @@
+#include "testing/testing.hpp"
+
+#include "generator/profiler.hpp"
+
+#include "cppjansson/cppjansson.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace profiler_tests
+{
+using namespace generator::profiler;
+
+UNIT_TEST(Profiler_Disabled)
+{
+  auto & profiler = Profiler::Instance();
+  profiler.Clear();
+  profiler.SetEnabled(false);
+  {
+    ScopedStage stage("stage");
+    stage.AddElements(10);
+  }
+  {
+    // A stage started while disabled has no start CPU time and is not reported.
+    ScopedStage stage("late");
+    profiler.SetEnabled(true);
+  }
+  profiler.SetEnabled(false);
+
+  base::Json json(profiler.ToJSON());
+  auto const * stages = base::GetJSONObligatoryField(json.get(), "stages");
+  TEST_EQUAL(json_array_size(stages), 0, ());
+}
+
+UNIT_TEST(Profiler_StagesAndThreads)
+{
+  auto & profiler = Profiler::Instance();
+  profiler.Clear();
+  profiler.SetEnabled(true);
+
+  auto const emit = [](uint64_t elements)
+  {
+    ScopedStage stage("emit");
+    stage.AddElements(elements);
+    stage.AddBytesRead(2 * elements);
+  };
+
+  emit(10);
+  std::thread thread(emit, 5);
+  thread.join();
+  {
+    ScopedStage stage("save");
+    stage.AddBytesWritten(100);
+  }
+
+  base::Json json(profiler.ToJSON());
+  profiler.SetEnabled(false);
+  profiler.Clear();
+
+  TEST_EQUAL(FromJSONObject<uint64_t>(json.get(), "threads_count"), 2, ());
+
+  auto const * stages = base::GetJSONObligatoryField(json.get(), "stages");
+  TEST_EQUAL(json_array_size(stages), 2, ());
+
+  json_t const * emitStage = json_array_get(stages, 0);
+  TEST_EQUAL(FromJSONObject<std::string>(emitStage, "name"), "emit", ());
+  TEST_EQUAL(FromJSONObject<uint64_t>(emitStage, "calls"), 2, ());
+  TEST_EQUAL(FromJSONObject<uint64_t>(emitStage, "elements"), 15, ());
+  TEST_EQUAL(FromJSONObject<uint64_t>(emitStage, "bytes_read"), 30, ());
+  TEST_EQUAL(json_array_size(base::GetJSONObligatoryField(emitStage, "threads")), 2, ());
+  TEST(json_object_get(emitStage, "process_peak_memory_bytes_at_end"), ());
+
+  json_t const * saveStage = json_array_get(stages, 1);
+  TEST_EQUAL(FromJSONObject<std::string>(saveStage, "name"), "save", ());
+  TEST_EQUAL(FromJSONObject<uint64_t>(saveStage, "bytes_written"), 100, ());
+}
+
+UNIT_TEST(Profiler_CpuAndWallTime)
+{
+  auto & profiler = Profiler::Instance();
+  profiler.Clear();
+  profiler.SetEnabled(true);
+  {
+    ScopedStage stage("sleep");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+
+  base::Json json(profiler.ToJSON());
+  profiler.SetEnabled(false);
+  profiler.Clear();
+
+  json_t const * stage = json_array_get(base::GetJSONObligatoryField(json.get(), "stages"), 0);
+  auto const wallSeconds = FromJSONObject<double>(stage, "wall_seconds");
+  auto const cpuSeconds = FromJSONObject<double>(stage, "cpu_seconds");
+  TEST_GREATER_OR_EQUAL(wallSeconds, 0.05, ());
+  // Waiting isn't a work.
+  TEST_LESS(cpuSeconds, wallSeconds, ());
+}
+
+UNIT_TEST(Profiler_DumpToBadPath)
+{
+  auto & profiler = Profiler::Instance();
+  profiler.Clear();
+  profiler.SetEnabled(true);
+  // Must not throw.
+  profiler.Dump("/non-existing-dir/profile.json");
+  profiler.SetEnabled(false);
+}
+}  // namespace profiler_tests
@@ -1,13 +1,70 @@
 #include "testing/testing.hpp"
 
+#include "generator/altitude_generator.hpp"
+#include "generator/generator_tests_support/test_feature.hpp"
+#include "generator/generator_tests_support/test_mwm_builder.hpp"
 #include "generator/srtm_parser.hpp"
 
+#include "indexer/altitude_loader.hpp"
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/feature_processor.hpp"
+
+#include "platform/country_file.hpp"
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+#include "platform/platform_tests_support/scoped_dir.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "coding/endianness.hpp"
+
+#include "base/file_name_utils.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
 using namespace generator;
 
 namespace
 {
+using namespace platform;
+using namespace platform::tests_support;
+
 inline std::string GetBase(ms::LatLon const & coord) { return SrtmTile::GetBase(coord); }
 
+// Uncompressed N00E000 tile in the writable dir. Heights depend on both row and column.
+std::string MakeHgtTile()
+{
+  size_t constexpr kSide = 60 * 60 + 1;
+  std::string data(kSide * kSide * sizeof(geometry::Altitude), 0);
+  auto * heights = reinterpret_cast<geometry::Altitude *>(&data[0]);
+  for (size_t row = 0; row < kSide; ++row)
+  {
+    for (size_t col = 0; col < kSide; ++col)
+      heights[row * kSide + col] = ReverseByteOrder(static_cast<geometry::Altitude>((row * 7 + col * 3) % 4000));
+  }
+  return data;
+}
+
+// Altitudes of the old sequential mode: tiles are loaded on demand while walking the roads.
+class SequentialSrtmGetter : public routing::AltitudeGetter
+{
+public:
+  explicit SequentialSrtmGetter(SrtmTileManager & manager) : m_manager(manager) {}
+
+  // AltitudeGetter overrides:
+  geometry::Altitude GetAltitude(m2::PointD const & p) override
+  {
+    return m_manager.GetHeight(mercator::ToLatLon(p));
+  }
+
+private:
+  SrtmTileManager & m_manager;
+};
+
 UNIT_TEST(FilenameTests)
 {
   auto name = GetBase({56.4566, 37.3467});
@@ -25,4 +82,91 @@ UNIT_TEST(FilenameTests)
   name = GetBase({-34.622358, -58.383654});
   TEST_EQUAL(name, "S35W059", ());
 }
+
+UNIT_TEST(SrtmTileManager_PrefetchMissingTiles)
+{
+  SrtmTileManager manager("not_existing_srtm_dir");
+  ms::LatLon const coord(56.4566, 37.3467);
+  TEST_EQUAL(manager.GetLoadedHeight(coord), geometry::kInvalidAltitude, ());
+
+  manager.Prefetch({coord, {56.1, 37.9}, {-35.35, -12.1}}, 2 /* threadsCount */);
+  TEST(!manager.GetTile(coord).IsValid(), ());
+  TEST_EQUAL(manager.GetLoadedHeight(coord), geometry::kInvalidAltitude, ());
+}
+
+UNIT_TEST(SrtmTileManager_SequentialAndParallelAltitudes)
+{
+  classificator::Load();
+  std::string const kTestDir = "srtm_parser_test";
+  ScopedFile const tile(GetBase({0.5, 0.5}) + ".hgt", MakeHgtTile());
+  ScopedDir const dir(kTestDir);
+
+  // More roads than one parallel task takes.
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> coord(0.01, 0.99);
+  std::vector<std::vector<m2::PointD>> roads(3000);
+  for (auto & road : roads)
+  {
+    for (size_t i = 0; i < 3; ++i)
+      road.push_back(mercator::FromLatLon(coord(rng), coord(rng)));
+  }
+  // This road leaves the tile, so it has no altitudes.
+  roads.back().push_back(mercator::FromLatLon(1.5, 0.5));
+
+  std::string const dirPath = base::JoinPath(GetPlatform().WritableDir(), kTestDir);
+  LocalCountryFile sequentialCountry(dirPath, CountryFile("sequential"), 1);
+  LocalCountryFile parallelCountry(dirPath, CountryFile("parallel"), 1);
+  ScopedFile const sequentialMwm(dir, sequentialCountry.GetCountryFile(), MapFileType::Map);
+  ScopedFile const parallelMwm(dir, parallelCountry.GetCountryFile(), MapFileType::Map);
+  for (auto * country : {&sequentialCountry, &parallelCountry})
+  {
+    generator::tests_support::TestMwmBuilder builder(*country, feature::DataHeader::MapType::Country);
+    for (auto const & road : roads)
+      builder.Add(generator::tests_support::TestStreet(road, std::string(), std::string()));
+  }
+
+  SrtmTileManager sequentialManager("not_existing_srtm_dir");
+  SequentialSrtmGetter sequentialGetter(sequentialManager);
+  routing::BuildRoadAltitudes(sequentialMwm.GetFullPath(), sequentialGetter);
+
+  SrtmTileManager parallelManager("not_existing_srtm_dir");
+  routing::BuildRoadAltitudes(parallelMwm.GetFullPath(), parallelManager, 4 /* threadsCount */);
+
+  FrozenDataSource dataSource;
+  auto const sequentialId = dataSource.RegisterMap(sequentialCountry).first;
+  auto const parallelId = dataSource.RegisterMap(parallelCountry).first;
+  auto const sequentialHandle = dataSource.GetMwmHandleById(sequentialId);
+  auto const parallelHandle = dataSource.GetMwmHandleById(parallelId);
+  TEST(sequentialHandle.IsAlive() && parallelHandle.IsAlive(), ());
+
+  feature::AltitudeLoaderCached sequentialLoader(*sequentialHandle.GetValue());
+  feature::AltitudeLoaderCached parallelLoader(*parallelHandle.GetValue());
+  TEST(sequentialLoader.HasAltitudes(), ());
+  TEST(parallelLoader.HasAltitudes(), ());
+
+  size_t roadsCount = 0;
+  size_t roadsWithAltitudes = 0;
+  feature::ForEachFeature(sequentialMwm.GetFullPath(), [&](FeatureType & f, uint32_t id)
+  {
+    f.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    size_t const pointsCount = f.GetPointsCount();
+    auto const & sequential = sequentialLoader.GetAltitudes(id, pointsCount);
+    auto const & parallel = parallelLoader.GetAltitudes(id, pointsCount);
+    TEST_EQUAL(sequential, parallel, (id));
+
+    ++roadsCount;
+    geometry::Altitudes expected;
+    for (size_t i = 0; i < pointsCount; ++i)
+    {
+      auto const altitude = sequentialManager.GetHeight(mercator::ToLatLon(f.GetPoint(i)));
+      if (altitude == geometry::kInvalidAltitude)
+        return;
+      expected.push_back(altitude);
+    }
+    ++roadsWithAltitudes;
+    TEST_EQUAL(sequential, expected, (id));
+  });
+  TEST_EQUAL(roadsCount, roads.size(), ());
+  TEST_EQUAL(roadsWithAltitudes, roads.size() - 1, ());
+}
 }  // namespace
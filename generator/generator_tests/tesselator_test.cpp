@@ -3,6 +3,11 @@
 #include "generator/tesselator.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/timer.hpp"
+
+#include <cmath>
+#include <random>
 
 namespace tesselator_test
 {
@@ -70,4 +75,97 @@ UNIT_TEST(Tesselator_Odd)
 
   TEST_EQUAL(2, RunTest(l), ());
 }
+
+double GetTrianglesArea(tesselator::TrianglesInfo const & info)
+{
+  double area = 0.0;
+  info.ForEachTriangle([&area](P const & p1, P const & p2, P const & p3)
+  {
+    // Fast path should emit CCW triangles only.
+    double const s = m2::CrossProduct(p2 - p1, p3 - p1);
+    TEST_GREATER(s, 0.0, (p1, p2, p3));
+    area += s / 2.0;
+  });
+  return area;
+}
+
+UNIT_TEST(Tesselator_EarClipping)
+{
+  {
+    // CW square with a closing point.
+    std::vector<P> const square = { P(0, 0), P(0, 2), P(2, 2), P(2, 0), P(0, 0) };
+    tesselator::TrianglesInfo info;
+    TEST_EQUAL(2, tesselator::TesselateSimpleInterior(square, info), ());
+    TEST_ALMOST_EQUAL_ABS(GetTrianglesArea(info), 4.0, 1e-9, ());
+  }
+  {
+    // Concave L-shaped building.
+    std::vector<P> const building = { P(0, 0), P(3, 0), P(3, 1), P(1, 1), P(1, 3), P(0, 3) };
+    tesselator::TrianglesInfo info;
+    TEST_EQUAL(4, tesselator::TesselateSimpleInterior(building, info), ());
+    TEST_ALMOST_EQUAL_ABS(GetTrianglesArea(info), 5.0, 1e-9, ());
+  }
+  {
+    // Self-intersections and holes are left for libtess2.
+    std::vector<P> const bowtie = { P(0, 0), P(2, 2), P(2, 0), P(0, 2) };
+    tesselator::TrianglesInfo info;
+    TEST_EQUAL(0, tesselator::TesselateSimpleInterior(bowtie, info), ());
+    TEST(info.IsEmpty(), ());
+
+    tesselator::PolygonsT polys = { bowtie };
+    TEST_EQUAL(2, tesselator::TesselateInterior(polys, info), ());
+  }
+}
+
+// Compares the ear clipping fast path with libtess2 on building-like polygons.
+UNIT_TEST(Tesselator_Benchmark)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<size_t> countDist(4, tesselator::kMaxEarClippingPoints);
+  std::uniform_real_distribution<double> radiusDist(0.5, 1.0);
+  std::uniform_real_distribution<double> jitterDist(0.0, 0.9);
+
+  // Random polygons, star-shaped around the origin, are simple and may be concave.
+  std::vector<tesselator::PolygonsT> polygons(5000);
+  for (auto & polys : polygons)
+  {
+    size_t const count = countDist(rng);
+    tesselator::PointsT points;
+    for (size_t i = 0; i < count; ++i)
+    {
+      double const a = 2 * math::pi * (i + jitterDist(rng)) / count;
+      double const r = radiusDist(rng);
+      points.emplace_back(r * std::cos(a), r * std::sin(a));
+    }
+    polys.push_back(std::move(points));
+  }
+
+  auto const run = [&polygons](auto && tesselate, std::vector<double> & areas)
+  {
+    std::vector<tesselator::TrianglesInfo> infos(polygons.size());
+    size_t trianglesCount = 0;
+    base::Timer timer;
+    for (size_t i = 0; i < polygons.size(); ++i)
+      trianglesCount += tesselate(polygons[i], infos[i]);
+    double const seconds = timer.ElapsedSeconds();
+    LOG(LINFO, ("Triangles:", trianglesCount, "Triangles/sec:", trianglesCount / std::max(seconds, 1e-9)));
+
+    for (auto const & info : infos)
+      areas.push_back(GetTrianglesArea(info));
+    return trianglesCount;
+  };
+
+  std::vector<double> simpleAreas, complexAreas;
+  LOG(LINFO, ("Ear clipping:"));
+  size_t const simpleCount = run([](tesselator::PolygonsT const & polys, tesselator::TrianglesInfo & info)
+  {
+    return tesselator::TesselateSimpleInterior(polys.front(), info);
+  }, simpleAreas);
+  LOG(LINFO, ("libtess2:"));
+  size_t const complexCount = run(&tesselator::TesselateComplexInterior, complexAreas);
+
+  TEST_EQUAL(simpleCount, complexCount, ());
+  for (size_t i = 0; i < polygons.size(); ++i)
+    TEST_ALMOST_EQUAL_ABS(simpleAreas[i], complexAreas[i], 1e-9, (polygons[i]));
+}
 }  // namespace tesselator_test
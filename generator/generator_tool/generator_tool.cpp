@@ -9,14 +9,18 @@
 #include "generator/descriptions_section_builder.hpp"
 #include "generator/dumper.hpp"
 #include "generator/feature_builder.hpp"
+#include "generator/feature_columns_builder.hpp"
 #include "generator/feature_sorter.hpp"
+#include "generator/features_blocks_builder.hpp"
 #include "generator/generate_info.hpp"
 #include "generator/isolines_section_builder.hpp"
 #include "generator/maxspeeds_builder.hpp"
 #include "generator/metalines_builder.hpp"
+#include "generator/osm_change.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/platform_helpers.hpp"
 #include "generator/popular_places_section_builder.hpp"
+#include "generator/profiler.hpp"
 #include "generator/postcode_points_builder.hpp"
 #include "generator/processor_factory.hpp"
 #include "generator/raw_generator.hpp"
@@ -51,6 +55,7 @@
 #include "coding/endianness.hpp"
 
 #include "base/file_name_utils.hpp"
+#include "base/scope_guard.hpp"
 #include "base/timer.hpp"
 
 #include "defines.hpp"
@@ -100,12 +105,23 @@ DEFINE_uint64(planet_version, base::SecondsSinceEpoch(),
               "Version as seconds since epoch, by default - now.");
 
 // Preprocessing and feature generator.
+DEFINE_string(osm_change, "",
+              "Path to an OSM change (.osc) file. Writes names of countries changed by it to "
+              CHANGED_COUNTRIES_FILENAME " in 'intermediate_data_path'. Must be run against "
+              "the previous build's intermediate data, i.e. before 'preprocess' of the updated planet.");
 DEFINE_bool(preprocess, false, "1st pass - create nodes/ways/relations data.");
 DEFINE_bool(generate_features, false, "2nd pass - generate intermediate features.");
 DEFINE_bool(generate_geometry, false,
             "3rd pass - split and simplify geometry and triangles for features.");
 DEFINE_bool(generate_index, false, "4rd pass - generate index.");
+DEFINE_bool(generate_rtree_index, false,
+            "Also generate the packed R-tree geometry index, used for viewport queries when present.");
 DEFINE_bool(generate_search_index, false, "5th pass - generate search index.");
+DEFINE_bool(generate_feature_columns, false,
+            "Generate the optional columnar section with types, centers, ranks and some metadata.");
+DEFINE_bool(compress_features, false,
+            "Move feature records to the block compressed section. Should be the last pass.");
+DEFINE_uint64(compress_features_block_size, 32 * 1024, "Uncompressed size of feature records block.");
 DEFINE_bool(dump_cities_boundaries, false, "Dump cities boundaries to a file");
 DEFINE_bool(generate_cities_boundaries, false, "Generate the cities boundaries section");
 DEFINE_string(cities_boundaries_data, "", "File with cities boundaries");
@@ -198,6 +214,8 @@ DEFINE_bool(dump_mwm_tmp, false, "Prints feature builder objects from .mwm.tmp")
 DEFINE_uint64(threads_count, 0, "Desired count of threads. If count equals zero, count of "
                                 "threads is set automatically.");
 DEFINE_bool(verbose, false, "Provide more detailed output.");
+DEFINE_string(profiling_report, "",
+              "Output json file with per-stage wall and CPU times, OSM element counts, I/O bytes and peak memory.");
 
 MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 {
@@ -213,6 +231,15 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   gflags::SetVersionString(pl.Version());
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
+  if (!FLAGS_profiling_report.empty())
+    profiler::Profiler::Instance().SetEnabled(true);
+  // Failed runs are dumped too, they are the most interesting ones.
+  SCOPE_GUARD(dumpProfilingReport, []()
+  {
+    if (!FLAGS_profiling_report.empty())
+      profiler::Profiler::Instance().Dump(FLAGS_profiling_report);
+  });
+
   unsigned threadsCount = FLAGS_threads_count != 0 ? static_cast<unsigned>(FLAGS_threads_count)
                                                    : pl.CpuCores();
 
@@ -270,10 +297,19 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
   classificator::Load();
 
+  if (!FLAGS_osm_change.empty())
+  {
+    LOG(LINFO, ("Finding countries changed by", FLAGS_osm_change));
+    profiler::ScopedStage stage("osm_change");
+    if (!FindChangedCountries(genInfo, FLAGS_osm_change, genInfo.GetIntermediateFileName(CHANGED_COUNTRIES_FILENAME)))
+      return EXIT_FAILURE;
+  }
+
   // Generate intermediate files.
   if (FLAGS_preprocess)
   {
     LOG(LINFO, ("Generating intermediate data ...."));
+    profiler::ScopedStage stage("preprocess");
     if (!GenerateIntermediateData(genInfo))
       return EXIT_FAILURE;
   }
@@ -282,6 +318,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   if (FLAGS_generate_features || FLAGS_generate_world || FLAGS_make_coasts)
   {
     RawGenerator rawGenerator(genInfo, threadsCount);
+    profiler::ScopedStage stage("generate_features");
     if (FLAGS_generate_features)
       rawGenerator.GenerateCountries();
     if (FLAGS_generate_world)
@@ -328,6 +365,11 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     }
   }
 
+  // SRTM tiles are shared by all mwms to avoid loading tiles on the borders several times.
+  std::unique_ptr<generator::SrtmTileManager> srtmManager;
+  if (!FLAGS_srtm_path.empty())
+    srtmManager = std::make_unique<generator::SrtmTileManager>(FLAGS_srtm_path);
+
   // Enumerate over all features files that were created.
   size_t const count = genInfo.m_bucketNames.size();
   for (size_t i = 0; i < count; ++i)
@@ -349,18 +391,25 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       // On error move to the next bucket without index generation.
 
       LOG(LINFO, ("Generating result features for", country));
-      if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
-        continue;
+      {
+        profiler::ScopedFileStage stage("section/features", dataFile);
+        if (!feature::GenerateFinalFeatures(genInfo, country, mapType, threadsCount))
+          continue;
+      }
 
       LOG(LINFO, ("Generating offsets table for", dataFile));
-      if (!feature::BuildOffsetsTable(dataFile))
-        continue;
+      {
+        profiler::ScopedFileStage stage("section/offsets", dataFile);
+        if (!feature::BuildOffsetsTable(dataFile))
+          continue;
+      }
 
       if (mapType == MapType::Country)
       {
         string const metalinesFilename = genInfo.GetIntermediateFileName(METALINES_FILENAME);
 
         LOG(LINFO, ("Processing metalines from", metalinesFilename));
+        profiler::ScopedFileStage stage("section/metalines", dataFile);
         if (!feature::WriteMetalinesSection(dataFile, metalinesFilename, osmToFeatureFilename))
           LOG(LCRITICAL, ("Error generating metalines section."));
       }
@@ -369,8 +418,10 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     if (FLAGS_generate_index)
     {
       LOG(LINFO, ("Generating index for", dataFile));
+      profiler::ScopedFileStage stage("section/index", dataFile);
 
-      if (!indexer::BuildIndexFromDataFile(dataFile, FLAGS_intermediate_data_path + country))
+      if (!indexer::BuildIndexFromDataFile(dataFile, FLAGS_intermediate_data_path + country,
+                                             FLAGS_generate_rtree_index))
         LOG(LCRITICAL, ("Error generating index."));
     }
 
@@ -379,10 +430,13 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       LOG(LINFO, ("Generating search index for", dataFile));
 
       /// @todo Make threads count according to environment (single mwm build or planet build).
-      if (!indexer::BuildSearchIndexFromDataFile(country, genInfo, true /* forceRebuild */,
-                                                 threadsCount))
       {
-        LOG(LCRITICAL, ("Error generating search index."));
+        profiler::ScopedFileStage stage("section/search_index", dataFile);
+        if (!indexer::BuildSearchIndexFromDataFile(country, genInfo, true /* forceRebuild */,
+                                                   threadsCount))
+        {
+          LOG(LCRITICAL, ("Error generating search index."));
+        }
       }
 
       if (!FLAGS_uk_postcodes_dataset.empty() || !FLAGS_us_postcodes_dataset.empty())
@@ -395,6 +449,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
           return EXIT_FAILURE;
         }
 
+        profiler::ScopedFileStage stage("section/postcode_points", dataFile);
         auto const topmostCountry = (*countryParentGetter)(country);
         bool res = true;
         if (topmostCountry == "United Kingdom" && !FLAGS_uk_postcodes_dataset.empty())
@@ -414,18 +469,31 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       }
 
       LOG(LINFO, ("Generating rank table for", dataFile));
-      if (!search::SearchRankTableBuilder::CreateIfNotExists(dataFile))
-        LOG(LCRITICAL, ("Error generating rank table."));
+      {
+        profiler::ScopedFileStage stage("section/rank_table", dataFile);
+        if (!search::SearchRankTableBuilder::CreateIfNotExists(dataFile))
+          LOG(LCRITICAL, ("Error generating rank table."));
+      }
 
       LOG(LINFO, ("Generating centers table for", dataFile));
+      profiler::ScopedFileStage stage("section/centers_table", dataFile);
       if (!indexer::BuildCentersTableFromDataFile(dataFile, true /* forceRebuild */))
         LOG(LCRITICAL, ("Error generating centers table."));
     }
 
+    if (FLAGS_generate_feature_columns)
+    {
+      LOG(LINFO, ("Generating feature columns for", dataFile));
+      profiler::ScopedFileStage stage("section/feature_columns", dataFile);
+      if (!indexer::BuildFeatureColumnsFromDataFile(dataFile, true /* forceRebuild */))
+        LOG(LCRITICAL, ("Error generating feature columns."));
+    }
+
     if (FLAGS_generate_cities_boundaries)
     {
       CHECK(!FLAGS_cities_boundaries_data.empty(), ());
       LOG(LINFO, ("Generating cities boundaries for", dataFile));
+      profiler::ScopedFileStage stage("section/cities_boundaries", dataFile);
       generator::OsmIdToBoundariesTable table;
       if (!generator::DeserializeBoundariesTable(FLAGS_cities_boundaries_data, table))
         LOG(LCRITICAL, ("Error deserializing boundaries table"));
@@ -436,22 +504,28 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     if (FLAGS_generate_cities_ids)
     {
       LOG(LINFO, ("Generating cities ids for", dataFile));
+      profiler::ScopedFileStage stage("section/cities_ids", dataFile);
       if (!generator::BuildCitiesIds(dataFile, osmToFeatureFilename))
         LOG(LCRITICAL, ("Error generating cities ids."));
     }
 
     if (!FLAGS_srtm_path.empty())
-      routing::BuildRoadAltitudes(dataFile, FLAGS_srtm_path);
+    {
+      profiler::ScopedFileStage stage("section/altitudes", dataFile);
+      routing::BuildRoadAltitudes(dataFile, *srtmManager, threadsCount);
+    }
 
     transit::experimental::EdgeIdToFeatureId transitEdgeFeatureIds;
 
     if (!FLAGS_transit_path_experimental.empty())
     {
+      profiler::ScopedFileStage stage("section/transit", dataFile);
       transitEdgeFeatureIds = transit::experimental::BuildTransit(
           path, country, osmToFeatureFilename, FLAGS_transit_path_experimental);
     }
     else if (!FLAGS_transit_path.empty())
     {
+      profiler::ScopedFileStage stage("section/transit", dataFile);
       routing::transit::BuildTransit(path, country, osmToFeatureFilename, FLAGS_transit_path);
     }
 
@@ -465,6 +539,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 //      else
 //      {
         string const camerasFilename = genInfo.GetIntermediateFileName(CAMERAS_TO_WAYS_FILENAME);
+        profiler::ScopedFileStage stage("section/speed_cameras", dataFile);
 
         BuildCamerasInfo(dataFile, camerasFilename, osmToFeatureFilename);
 //      }
@@ -473,6 +548,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     if (country == WORLD_FILE_NAME && !FLAGS_world_roads_path.empty())
     {
       LOG(LINFO, ("Generating routing section for World."));
+      profiler::ScopedFileStage stage("section/world_roads", dataFile);
       if (!routing::BuildWorldRoads(dataFile, FLAGS_world_roads_path))
       {
         LOG(LCRITICAL, ("Generating routing section for World has failed."));
@@ -498,6 +574,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       {
         auto const boundariesPath = genInfo.GetIntermediateFileName(CITY_BOUNDARIES_COLLECTOR_FILENAME);
         LOG(LINFO, ("Generating", CITY_ROADS_FILE_TAG, "for", dataFile, "using", boundariesPath));
+        profiler::ScopedFileStage stage("section/city_roads", dataFile);
         if (!BuildCityRoads(dataFile, boundariesPath))
           LOG(LCRITICAL, ("Generating city roads error."));
       }
@@ -505,23 +582,30 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       string const restrictionsFilename = genInfo.GetIntermediateFileName(RESTRICTIONS_FILENAME);
       string const roadAccessFilename = genInfo.GetIntermediateFileName(ROAD_ACCESS_FILENAME);
 
-      BuildRoutingIndex(dataFile, country, *countryParentGetter);
+      {
+        profiler::ScopedFileStage stage("section/routing_index", dataFile);
+        BuildRoutingIndex(dataFile, country, *countryParentGetter);
+      }
       auto routingGraph = CreateIndexGraph(dataFile, country, *countryParentGetter);
       CHECK(routingGraph, ());
 
       auto osm2feature = routing::CreateWay2FeatureMapper(dataFile, osmToFeatureFilename);
 
       /// @todo CHECK return result doesn't work now for some small countries like Somalie.
-      if (!BuildRoadRestrictions(*routingGraph, dataFile, restrictionsFilename, osmToFeatureFilename) ||
-          !BuildRoadAccessInfo(dataFile, roadAccessFilename, *osm2feature))
       {
-        LOG(LERROR, ("Routing build failed for", dataFile));
+        profiler::ScopedFileStage stage("section/restrictions_and_road_access", dataFile);
+        if (!BuildRoadRestrictions(*routingGraph, dataFile, restrictionsFilename, osmToFeatureFilename) ||
+            !BuildRoadAccessInfo(dataFile, roadAccessFilename, *osm2feature))
+        {
+          LOG(LERROR, ("Routing build failed for", dataFile));
+        }
       }
 
       if (FLAGS_generate_maxspeed)
       {
         string const maxspeedsFilename = genInfo.GetIntermediateFileName(MAXSPEEDS_FILENAME);
         LOG(LINFO, ("Generating maxspeeds section for", dataFile, "using", maxspeedsFilename));
+        profiler::ScopedFileStage stage("section/maxspeeds", dataFile);
         BuildMaxspeedsSection(routingGraph.get(), dataFile, osmToFeatureFilename, maxspeedsFilename);
       }
     }
@@ -539,6 +623,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
       if (FLAGS_make_cross_mwm)
       {
+        profiler::ScopedFileStage stage("section/cross_mwm", dataFile);
         BuildRoutingCrossMwmSection(path, dataFile, country, genInfo.m_intermediateDir,
                                     *countryParentGetter, osmToFeatureFilename);
       }
@@ -564,15 +649,20 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     if (!FLAGS_generate_popular_places && !FLAGS_wikipedia_pages.empty())
     {
       // FLAGS_idToWikidata maybe empty.
+      profiler::ScopedFileStage stage("section/descriptions", dataFile);
       DescriptionsSectionBuilder::CollectAndBuild(FLAGS_wikipedia_pages, dataFile, FLAGS_idToWikidata);
     }
 
     // This section must be built with the same isolines file as had been used at the features stage.
     if (FLAGS_generate_isolines_info)
+    {
+      profiler::ScopedFileStage stage("section/isolines_info", dataFile);
       BuildIsolinesInfoSection(FLAGS_isolines_path, country, dataFile);
+    }
 
     if (FLAGS_generate_popular_places)
     {
+      profiler::ScopedFileStage stage("section/popular_places", dataFile);
       if (!FLAGS_wikipedia_pages.empty())
         BuildPopularPlacesFromWikiDump(dataFile, FLAGS_wikipedia_pages, FLAGS_idToWikidata);
       else
@@ -581,9 +671,21 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
     if (FLAGS_generate_traffic_keys)
     {
+      profiler::ScopedFileStage stage("section/traffic_keys", dataFile);
       if (!traffic::GenerateTrafficKeysFromDataFile(dataFile))
         LOG(LCRITICAL, ("Error generating traffic keys."));
     }
+
+    if (FLAGS_compress_features)
+    {
+      LOG(LINFO, ("Compressing features for", dataFile));
+      profiler::ScopedFileStage stage("section/features_blocks", dataFile);
+      if (!feature::BuildFeaturesBlocks(dataFile,
+                                        static_cast<uint32_t>(FLAGS_compress_features_block_size)))
+      {
+        LOG(LCRITICAL, ("Error compressing features."));
+      }
+    }
   }
 
   string const dataFile = base::JoinPath(path, FLAGS_output + DATA_FILE_EXTENSION);
@@ -12,8 +12,12 @@
 #include "indexer/data_header.hpp"
 #include "indexer/feature.hpp"
 
+#include "base/thread_pool_computational.hpp"
+
 #include <functional>
+#include <future>
 #include <list>
+#include <utility>
 #include <vector>
 
 namespace feature
@@ -143,7 +147,9 @@ public:
     return true;
   }
 
-  void AddTriangles(Polygons const & polys, int scaleIndex)
+  // Its important AddTriangles is called sequentially from upper scales to lower.
+  // |info| may contain triangles of |polys| tesselated in advance.
+  void AddTriangles(Polygons const & polys, int scaleIndex, tesselator::TrianglesInfo * info = nullptr)
   {
     CHECK(m_buffer.m_innerTrg.empty(), ());
     m_trgInner = false;
@@ -155,7 +161,7 @@ public:
     if (m_trgPrevCount == 0 ||
         (trgPointsCount + kGeomMinDiff <= m_trgPrevCount && trgPointsCount * kGeomMinFactor <= m_trgPrevCount))
     {
-      if (WriteOuterTriangles(polys, scaleIndex))
+      if (WriteOuterTriangles(polys, scaleIndex, info))
       {
         // Assign only if geometry is valid (correctly tesselated and saved).
         m_trgPrevCount = trgPointsCount;
@@ -169,6 +175,39 @@ public:
     }
   }
 
+  // Same as AddTriangles, but tesselation is postponed till FlushTriangles.
+  void EnqueueTriangles(Polygons && polys, int scaleIndex)
+  {
+    CHECK(m_buffer.m_innerTrg.empty(), ());
+    m_trgInner = false;
+    m_queuedTriangles.emplace_back(std::move(polys), scaleIndex);
+  }
+
+  // Tesselates all the enqueued scales on |pool| simultaneously and adds them in the enqueue order.
+  // Scales discarded as too similar to a more detailed one are tesselated in vain,
+  // so it pays off for huge areas only.
+  void FlushTriangles(base::thread_pool::computational::ThreadPool & pool)
+  {
+    std::vector<std::future<tesselator::TrianglesInfo>> infos;
+    infos.reserve(m_queuedTriangles.size());
+    for (auto const & queued : m_queuedTriangles)
+    {
+      infos.push_back(pool.Submit([&queued]()
+      {
+        tesselator::TrianglesInfo info;
+        tesselator::TesselateInterior(queued.first, info);
+        return info;
+      }));
+    }
+
+    for (size_t i = 0; i < m_queuedTriangles.size(); ++i)
+    {
+      auto info = infos[i].get();
+      AddTriangles(m_queuedTriangles[i].first, m_queuedTriangles[i].second, &info);
+    }
+    m_queuedTriangles.clear();
+  }
+
 private:
   class StripEmitter
   {
@@ -206,13 +245,20 @@ private:
     serial::SaveOuterPath(toSave, cp, m_geoFileGetter(i));
   }
 
-  bool WriteOuterTriangles(Polygons const & polys, int i)
+  bool WriteOuterTriangles(Polygons const & polys, int i, tesselator::TrianglesInfo * tesselated)
   {
     CHECK(m_trgFileGetter, ("m_trgFileGetter must be set to write outer triangles."));
 
     // tesselation
-    tesselator::TrianglesInfo info;
-    if (0 == tesselator::TesselateInterior(polys, info))
+    tesselator::TrianglesInfo localInfo;
+    if (!tesselated)
+    {
+      tesselator::TesselateInterior(polys, localInfo);
+      tesselated = &localInfo;
+    }
+
+    tesselator::TrianglesInfo const & info = *tesselated;
+    if (info.IsEmpty())
     {
       /// @todo Some examples here: https://github.com/organicmaps/organicmaps/issues/5607
       LOG(LWARNING, ("GeometryHolder: No triangles for scale index", i, "in", m_fb.GetMostGenericOsmId()));
@@ -307,6 +353,9 @@ private:
   bool m_ptsInner, m_trgInner;
   size_t m_ptsPrevCount = 0, m_trgPrevCount = 0;
 
+  // Polygons and scale indexes waiting for FlushTriangles.
+  std::vector<std::pair<Polygons, int>> m_queuedTriangles;
+
   feature::DataHeader const & m_header;
 };
 }  //  namespace feature
@@ -0,0 +1,289 @@
+#include "generator/osm_change.hpp"
+
+#include "generator/osm_xml_source.hpp"
+
+#include "coding/parse_xml.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <fstream>
+#include <string_view>
+
+namespace generator
+{
+namespace
+{
+// Osc is an osm xml with one more level: elements are grouped into
+// <create>, <modify> and <delete> blocks inside the <osmChange> root.
+class OsmChangeXmlSource
+{
+public:
+  using Emitter = std::function<void(OsmChangeAction, OsmElement &&)>;
+
+  explicit OsmChangeXmlSource(Emitter const & fn)
+    : m_emitter(fn)
+    , m_elements([this](OsmElement && element)
+      {
+        if (!m_isKnownAction)
+          return;
+
+        element.Validate();
+        m_emitter(m_action, std::move(element));
+      })
+  {
+  }
+
+  void CharData(std::string const &) {}
+
+  void AddAttr(char const * key, char const * value)
+  {
+    if (m_depth > 1)
+      m_elements.AddAttr(key, value);
+  }
+
+  bool Push(char const * tagName)
+  {
+    ++m_depth;
+    if (m_depth == 1)
+      return true;
+
+    if (m_depth == 2)
+    {
+      std::string_view const action(tagName);
+      m_isKnownAction = true;
+      if (action == "create")
+        m_action = OsmChangeAction::Create;
+      else if (action == "modify")
+        m_action = OsmChangeAction::Modify;
+      else if (action == "delete")
+        m_action = OsmChangeAction::Delete;
+      else
+        m_isKnownAction = false;
+
+      if (!m_isKnownAction)
+        LOG(LWARNING, ("Unknown osmChange block is skipped:", action));
+    }
+
+    // An action block is the root for XMLSource.
+    return m_elements.Push(tagName);
+  }
+
+  void Pop(char const * tagName)
+  {
+    if (m_depth-- > 1)
+      m_elements.Pop(tagName);
+  }
+
+private:
+  Emitter const & m_emitter;
+  XMLSource m_elements;
+
+  size_t m_depth = 0;
+  OsmChangeAction m_action = OsmChangeAction::Create;
+  bool m_isKnownAction = false;
+};
+
+m2::PointD ToPoint(double y, double x) { return {x, y}; }
+}  // namespace
+
+std::string DebugPrint(OsmChangeAction action)
+{
+  switch (action)
+  {
+  case OsmChangeAction::Create: return "Create";
+  case OsmChangeAction::Modify: return "Modify";
+  case OsmChangeAction::Delete: return "Delete";
+  }
+  UNREACHABLE();
+}
+
+void ProcessOsmChangeFromXML(SourceReader & stream,
+                             std::function<void(OsmChangeAction, OsmElement &&)> const & processor)
+{
+  OsmChangeXmlSource source(processor);
+  XMLSequenceParser<SourceReader, OsmChangeXmlSource> parser(stream, source);
+  while (parser.Read())
+    ;
+}
+
+// ChangedCountriesFinder --------------------------------------------------------------------------
+ChangedCountriesFinder::ChangedCountriesFinder(borders::CountryPolygonsCollection const & countries,
+                                               cache::IntermediateDataReaderInterface & cache)
+  : m_countries(countries), m_cache(cache)
+{
+}
+
+void ChangedCountriesFinder::Add(OsmChangeAction action, OsmElement && element)
+{
+  if (action != OsmChangeAction::Delete)
+  {
+    if (element.IsNode())
+      m_nodes[element.m_id] = mercator::FromLatLon(element.m_lat, element.m_lon);
+    else if (element.IsWay())
+      m_ways[element.m_id] = element.Nodes();
+  }
+
+  // Changes are processed in Finish(), when new positions of all the changed nodes are known.
+  m_changes.push_back({action, std::move(element)});
+}
+
+std::set<std::string> ChangedCountriesFinder::Finish()
+{
+  for (auto const & change : m_changes)
+  {
+    auto const & element = change.m_element;
+    bool const hasOld = change.m_action != OsmChangeAction::Create;
+    bool const hasNew = change.m_action != OsmChangeAction::Delete;
+
+    if (element.IsNode())
+    {
+      double y, x;
+      if (hasOld && m_cache.GetNode(element.m_id, y, x))
+        AddPoint(ToPoint(y, x));
+      if (hasNew)
+        AddPoint(m_nodes.at(element.m_id));
+    }
+    else if (element.IsWay())
+    {
+      if (hasOld)
+        AddOldWay(element.m_id);
+      if (hasNew)
+        AddNodes(element.Nodes());
+    }
+    else if (element.IsRelation())
+    {
+      if (hasOld)
+        AddOldRelation(element.m_id);
+      if (!hasNew)
+        continue;
+
+      for (auto const & member : element.Members())
+      {
+        m2::PointD point;
+        if (member.m_type == OsmElement::EntityType::Node && GetNode(member.m_ref, point))
+          AddPoint(point);
+        else if (member.m_type == OsmElement::EntityType::Way)
+          AddNewWay(member.m_ref);
+        // Subrelations are not followed: they are rare and their own members are mostly changed too.
+      }
+    }
+  }
+
+  m_changes.clear();
+  return std::move(m_result);
+}
+
+bool ChangedCountriesFinder::GetNode(uint64_t id, m2::PointD & point) const
+{
+  auto const it = m_nodes.find(id);
+  if (it != m_nodes.cend())
+  {
+    point = it->second;
+    return true;
+  }
+
+  double y, x;
+  if (!m_cache.GetNode(id, y, x))
+    return false;
+
+  point = ToPoint(y, x);
+  return true;
+}
+
+void ChangedCountriesFinder::AddPoint(m2::PointD const & point)
+{
+  m_countries.ForEachCountryInRect(m2::RectD(point, point), [&](borders::CountryPolygons const & country)
+  {
+    if (country.Contains(point))
+      m_result.insert(country.GetName());
+  });
+}
+
+void ChangedCountriesFinder::AddNodes(std::vector<uint64_t> const & ids)
+{
+  m2::PointD point;
+  for (auto const id : ids)
+  {
+    if (GetNode(id, point))
+      AddPoint(point);
+  }
+}
+
+void ChangedCountriesFinder::AddOldWay(uint64_t id)
+{
+  WayElement way(id);
+  if (!m_cache.GetWay(id, way))
+    return;
+
+  double y, x;
+  for (auto const nodeId : way.m_nodes)
+  {
+    if (m_cache.GetNode(nodeId, y, x))
+      AddPoint(ToPoint(y, x));
+  }
+}
+
+void ChangedCountriesFinder::AddNewWay(uint64_t id)
+{
+  auto const it = m_ways.find(id);
+  if (it != m_ways.cend())
+  {
+    AddNodes(it->second);
+    return;
+  }
+
+  WayElement way(id);
+  if (m_cache.GetWay(id, way))
+    AddNodes(way.m_nodes);
+}
+
+void ChangedCountriesFinder::AddOldRelation(uint64_t id)
+{
+  RelationElement relation;
+  if (!m_cache.GetRelation(id, relation))
+    return;
+
+  double y, x;
+  for (auto const & node : relation.m_nodes)
+  {
+    if (m_cache.GetNode(node.first, y, x))
+      AddPoint(ToPoint(y, x));
+  }
+
+  for (auto const & way : relation.m_ways)
+    AddOldWay(way.first);
+}
+
+bool FindChangedCountries(feature::GenerateInfo const & info, std::string const & oscFilename,
+                          std::string const & outFilename)
+{
+  auto const & countries = borders::GetOrCreateCountryPolygonsTree(info.m_targetDir);
+  cache::IntermediateDataObjectsCache objectsCache;
+  cache::IntermediateData intermediateData(objectsCache, info);
+
+  ChangedCountriesFinder finder(countries, *intermediateData.GetCache());
+  SourceReader reader(oscFilename);
+  ProcessOsmChangeFromXML(reader, [&finder](OsmChangeAction action, OsmElement && element)
+  {
+    finder.Add(action, std::move(element));
+  });
+
+  auto const changed = finder.Finish();
+  LOG(LINFO, (changed.size(), "of", countries.GetSize(), "countries are changed by", oscFilename));
+
+  std::ofstream stream(outFilename);
+  if (!stream)
+  {
+    LOG(LERROR, ("Can't open", outFilename));
+    return false;
+  }
+
+  for (auto const & name : changed)
+    stream << name << '\n';
+  return stream.good();
+}
+}  // namespace generator
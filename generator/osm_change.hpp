@@ -0,0 +1,75 @@
+#pragma once
+
+#include "generator/borders.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/osm_element.hpp"
+#include "generator/osm_source.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace generator
+{
+enum class OsmChangeAction
+{
+  Create,
+  Modify,
+  Delete
+};
+
+std::string DebugPrint(OsmChangeAction action);
+
+/// Reads OSM change (.osc) xml and emits every changed element with the action of its block.
+void ProcessOsmChangeFromXML(SourceReader & stream,
+                             std::function<void(OsmChangeAction, OsmElement &&)> const & processor);
+
+/// Finds countries whose features may be changed by an OSM change. It uses intermediate data
+/// of the previous build to get old positions of changed nodes, ways and relation members.
+/// Only these countries need to be regenerated (and diffed) after the planet update.
+class ChangedCountriesFinder
+{
+public:
+  ChangedCountriesFinder(borders::CountryPolygonsCollection const & countries,
+                         cache::IntermediateDataReaderInterface & cache);
+
+  void Add(OsmChangeAction action, OsmElement && element);
+
+  /// @return Names of changed countries after all elements of the change are added.
+  std::set<std::string> Finish();
+
+private:
+  struct Change
+  {
+    OsmChangeAction m_action;
+    OsmElement m_element;
+  };
+
+  bool GetNode(uint64_t id, m2::PointD & point) const;
+  void AddPoint(m2::PointD const & point);
+  void AddNodes(std::vector<uint64_t> const & ids);
+  void AddOldWay(uint64_t id);
+  void AddNewWay(uint64_t id);
+  void AddOldRelation(uint64_t id);
+
+  borders::CountryPolygonsCollection const & m_countries;
+  cache::IntermediateDataReaderInterface & m_cache;
+
+  // New positions and node lists from the change itself.
+  std::unordered_map<uint64_t, m2::PointD> m_nodes;
+  std::unordered_map<uint64_t, std::vector<uint64_t>> m_ways;
+  std::vector<Change> m_changes;
+
+  std::set<std::string> m_result;
+};
+
+/// Writes names of countries changed by |oscFilename| to |outFilename|, one per line.
+bool FindChangedCountries(feature::GenerateInfo const & info, std::string const & oscFilename,
+                          std::string const & outFilename);
+}  // namespace generator
@@ -0,0 +1,222 @@
+#include "generator/profiler.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include "cppjansson/cppjansson.hpp"
+
+#include "std/target_os.hpp"
+
+#include <utility>
+
+#ifndef OMIM_OS_WINDOWS
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+namespace generator
+{
+namespace profiler
+{
+namespace
+{
+void CountersToJSON(json_t & obj, Counters const & counters)
+{
+  ToJSONObject(obj, "wall_seconds", counters.m_wallSeconds);
+  ToJSONObject(obj, "cpu_seconds", counters.m_cpuSeconds);
+  ToJSONObject(obj, "calls", counters.m_calls);
+  ToJSONObject(obj, "elements", counters.m_elements);
+  ToJSONObject(obj, "bytes_read", counters.m_bytesRead);
+  ToJSONObject(obj, "bytes_written", counters.m_bytesWritten);
+}
+}  // namespace
+
+Counters & Counters::operator+=(Counters const & rhs)
+{
+  m_wallSeconds += rhs.m_wallSeconds;
+  m_cpuSeconds += rhs.m_cpuSeconds;
+  m_calls += rhs.m_calls;
+  m_elements += rhs.m_elements;
+  m_bytesRead += rhs.m_bytesRead;
+  m_bytesWritten += rhs.m_bytesWritten;
+  return *this;
+}
+
+// static
+Profiler & Profiler::Instance()
+{
+  static Profiler instance;
+  return instance;
+}
+
+void Profiler::SetEnabled(bool enabled)
+{
+  std::lock_guard lock(m_mutex);
+  if (enabled && !m_enabled)
+    m_timer.Reset();
+  m_enabled = enabled;
+}
+
+void Profiler::Add(std::string const & stage, Counters const & counters)
+{
+  if (!m_enabled)
+    return;
+
+  auto const peakMemory = GetPeakMemoryBytes();
+
+  std::lock_guard lock(m_mutex);
+  auto const threadIndex = GetThreadIndex(std::this_thread::get_id());
+  auto it = m_stages.find(stage);
+  if (it == m_stages.end())
+  {
+    m_order.push_back(stage);
+    it = m_stages.emplace(stage, Stage()).first;
+  }
+
+  auto & s = it->second;
+  s.m_total += counters;
+  s.m_threads[threadIndex] += counters;
+  s.m_processPeakMemoryAtEnd = std::max(s.m_processPeakMemoryAtEnd, peakMemory);
+}
+
+size_t Profiler::GetThreadIndex(std::thread::id const & id)
+{
+  return m_threadIndexes.emplace(id, m_threadIndexes.size()).first->second;
+}
+
+// static
+uint64_t Profiler::GetPeakMemoryBytes()
+{
+#ifdef OMIM_OS_WINDOWS
+  return 0;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+  auto const maxRss = static_cast<uint64_t>(usage.ru_maxrss);
+#ifdef OMIM_OS_MAC
+  // Bytes on macOS.
+  return maxRss;
+#else
+  // Kilobytes on Linux.
+  return maxRss * 1024;
+#endif
+#endif
+}
+
+// static
+double Profiler::GetThreadCpuSeconds()
+{
+#ifdef OMIM_OS_WINDOWS
+  return 0.0;
+#else
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+    return 0.0;
+  return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+#endif
+}
+
+std::string Profiler::ToJSON() const
+{
+  std::lock_guard lock(m_mutex);
+
+  auto stages = base::NewJSONArray();
+  for (auto const & name : m_order)
+  {
+    auto const & stage = m_stages.at(name);
+
+    auto obj = base::NewJSONObject();
+    ToJSONObject(*obj, "name", name);
+    CountersToJSON(*obj, stage.m_total);
+    ToJSONObject(*obj, "process_peak_memory_bytes_at_end", stage.m_processPeakMemoryAtEnd);
+
+    auto threads = base::NewJSONArray();
+    for (auto const & [index, counters] : stage.m_threads)
+    {
+      auto thread = base::NewJSONObject();
+      ToJSONObject(*thread, "thread", index);
+      CountersToJSON(*thread, counters);
+      json_array_append_new(threads.get(), thread.release());
+    }
+    ToJSONObject(*obj, "threads", threads);
+    json_array_append_new(stages.get(), obj.release());
+  }
+
+  auto root = base::NewJSONObject();
+  ToJSONObject(*root, "total_seconds", m_timer.ElapsedSeconds());
+  ToJSONObject(*root, "peak_memory_bytes", GetPeakMemoryBytes());
+  ToJSONObject(*root, "threads_count", m_threadIndexes.size());
+  ToJSONObject(*root, "stages", stages);
+  return base::DumpToString(root, JSON_INDENT(2));
+}
+
+void Profiler::Dump(std::string const & path) const
+{
+  if (!m_enabled)
+    return;
+
+  try
+  {
+    auto const json = ToJSON();
+    FileWriter writer(path);
+    writer.Write(json.data(), json.size());
+    LOG(LINFO, ("Profiling report was written to", path));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't write profiling report to", path, e.Msg()));
+  }
+}
+
+void Profiler::Clear()
+{
+  std::lock_guard lock(m_mutex);
+  m_order.clear();
+  m_stages.clear();
+  m_threadIndexes.clear();
+  m_timer.Reset();
+}
+
+ScopedStage::ScopedStage(std::string stage)
+  : m_stage(std::move(stage)), m_enabled(Profiler::Instance().IsEnabled())
+{
+  if (m_enabled)
+    m_startCpuSeconds = Profiler::GetThreadCpuSeconds();
+}
+
+ScopedStage::~ScopedStage()
+{
+  auto & profiler = Profiler::Instance();
+  if (!m_enabled || !profiler.IsEnabled())
+    return;
+
+  m_counters.m_wallSeconds = m_timer.ElapsedSeconds();
+  m_counters.m_cpuSeconds = Profiler::GetThreadCpuSeconds() - m_startCpuSeconds;
+  m_counters.m_calls = 1;
+  profiler.Add(m_stage, m_counters);
+}
+
+ScopedFileStage::ScopedFileStage(std::string stage, std::string filePath)
+  : ScopedStage(std::move(stage)), m_filePath(std::move(filePath))
+{
+  if (IsEnabled())
+    Platform::GetFileSizeByFullPath(m_filePath, m_initialSize);
+}
+
+ScopedFileStage::~ScopedFileStage()
+{
+  if (!IsEnabled())
+    return;
+
+  uint64_t size = 0;
+  if (Platform::GetFileSizeByFullPath(m_filePath, size) && size > m_initialSize)
+    AddBytesWritten(size - m_initialSize);
+}
+}  // namespace profiler
+}  // namespace generator
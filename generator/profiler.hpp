@@ -0,0 +1,116 @@
+#pragma once
+
+#include "base/timer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace generator
+{
+namespace profiler
+{
+struct Counters
+{
+  Counters & operator+=(Counters const & rhs);
+
+  // Elapsed wall time. Includes time spent waiting for I/O, locks and other threads.
+  double m_wallSeconds = 0.0;
+  // CPU time of the thread which ran the stage. Work of helper threads is reported by their own stages.
+  double m_cpuSeconds = 0.0;
+  uint64_t m_calls = 0;
+  // Processed OSM elements.
+  uint64_t m_elements = 0;
+  uint64_t m_bytesRead = 0;
+  uint64_t m_bytesWritten = 0;
+};
+
+/// Collects per-stage and per-thread timings of the generator passes and dumps them as JSON,
+/// so that nightly builds can be compared with each other.
+/// Collecting is disabled by default and costs a single atomic check per ScopedStage in this case.
+class Profiler
+{
+public:
+  static Profiler & Instance();
+
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const { return m_enabled; }
+
+  void Add(std::string const & stage, Counters const & counters);
+
+  /// @return Maximum resident set size of the process in bytes (0 if unsupported).
+  static uint64_t GetPeakMemoryBytes();
+  /// @return CPU time consumed by the calling thread in seconds (0 if unsupported).
+  static double GetThreadCpuSeconds();
+
+  std::string ToJSON() const;
+  /// Writes ToJSON() to |path|, does nothing if profiling is disabled.
+  /// Doesn't throw, so it may be called from scope guards of failed runs.
+  void Dump(std::string const & path) const;
+
+  void Clear();
+
+private:
+  Profiler() = default;
+
+  size_t GetThreadIndex(std::thread::id const & id);
+
+  struct Stage
+  {
+    Counters m_total;
+    // Peak RSS of the whole process sampled when the stage's calls ended, not the stage's own usage.
+    uint64_t m_processPeakMemoryAtEnd = 0;
+    std::map<size_t, Counters> m_threads;
+  };
+
+  std::atomic<bool> m_enabled{false};
+  base::Timer m_timer;
+
+  mutable std::mutex m_mutex;
+  // Stages are reported in the order of their first appearance.
+  std::vector<std::string> m_order;
+  std::map<std::string, Stage> m_stages;
+  std::map<std::thread::id, size_t> m_threadIndexes;
+};
+
+/// Measures a lifetime of the object and reports it as a |stage| call on destruction.
+class ScopedStage
+{
+public:
+  explicit ScopedStage(std::string stage);
+  ~ScopedStage();
+
+  void AddElements(uint64_t count) { m_counters.m_elements += count; }
+  void AddBytesRead(uint64_t bytes) { m_counters.m_bytesRead += bytes; }
+  void AddBytesWritten(uint64_t bytes) { m_counters.m_bytesWritten += bytes; }
+
+protected:
+  bool IsEnabled() const { return m_enabled; }
+
+private:
+  std::string m_stage;
+  Counters m_counters;
+  base::Timer m_timer;
+  // Stages started while profiling was disabled are not reported, so they never query the CPU clock.
+  bool m_enabled = false;
+  double m_startCpuSeconds = 0.0;
+};
+
+/// Same as ScopedStage, but also reports growth of |filePath| as written bytes.
+/// Handy for section builders that append a section to the mwm container.
+class ScopedFileStage : public ScopedStage
+{
+public:
+  ScopedFileStage(std::string stage, std::string filePath);
+  ~ScopedFileStage();
+
+private:
+  std::string m_filePath;
+  uint64_t m_initialSize = 0;
+};
+}  // namespace profiler
+}  // namespace generator
@@ -8,6 +8,7 @@
 #include "generator/final_processor_world.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/processor_factory.hpp"
+#include "generator/profiler.hpp"
 #include "generator/raw_generator_writer.hpp"
 #include "generator/translator_factory.hpp"
 #include "generator/translators_pool.hpp"
@@ -166,6 +167,7 @@ bool RawGenerator::Execute()
   {
     auto const finalProcessor = m_finalProcessors.top();
     m_finalProcessors.pop();
+    profiler::ScopedStage stage("final_processor/" + DebugPrint(finalProcessor->GetPriority()));
     finalProcessor->Process();
   }
 
@@ -254,8 +256,14 @@ bool RawGenerator::GenerateFilteredFeatures()
   {
     std::vector<OsmElement> elements(m_chunkSize);
     size_t idx = 0;
-    while (idx < m_chunkSize && sourceProcessor->TryRead(elements[idx]))
-      ++idx;
+    {
+      profiler::ScopedStage stage("osm_source/read");
+      auto const startPos = reader.Pos();
+      while (idx < m_chunkSize && sourceProcessor->TryRead(elements[idx]))
+        ++idx;
+      stage.AddElements(idx);
+      stage.AddBytesRead(reader.Pos() - startPos);
+    }
 
     isEnd = idx < m_chunkSize;
     stats.Log(elements, reader.Pos(), isEnd/* forcePrint */);
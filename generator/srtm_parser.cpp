@@ -7,9 +7,12 @@
 
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <fstream>
+#include <future>
 #include <iomanip>
+#include <set>
 #include <sstream>
 
 namespace generator
@@ -18,6 +21,8 @@ namespace
 {
 size_t constexpr kArcSecondsInDegree = 60 * 60;
 size_t constexpr kSrtmTileSize = (kArcSecondsInDegree + 1) * (kArcSecondsInDegree + 1) * 2;
+// About 6 GB of decompressed tiles.
+size_t constexpr kMaxPrefetchedTilesCount = 256;
 
 struct UnzipMemDelegate : public ZipFileReader::Delegate
 {
@@ -185,15 +190,7 @@ geometry::Altitude SrtmTileManager::GetHeight(ms::LatLon const & coord)
   if (it == m_tiles.end())
   {
     SrtmTile tile;
-    try
-    {
-      tile.Init(m_dir, coord);
-    }
-    catch (RootException const & e)
-    {
-      std::string const base = SrtmTile::GetBase(coord);
-      LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
-    }
+    InitTile(coord, tile);
 
     // It's OK to store even invalid tiles and return invalid height
     // for them later.
@@ -203,6 +200,68 @@ geometry::Altitude SrtmTileManager::GetHeight(ms::LatLon const & coord)
   return it->second.GetHeight(coord);
 }
 
+geometry::Altitude SrtmTileManager::GetLoadedHeight(ms::LatLon const & coord) const
+{
+  auto const it = m_tiles.find(GetKey(coord));
+  if (it == m_tiles.end())
+    return geometry::kInvalidAltitude;
+  return it->second.GetHeight(coord);
+}
+
+void SrtmTileManager::Prefetch(std::vector<ms::LatLon> const & coords, size_t threadsCount)
+{
+  std::set<LatLonKey> neededKeys;
+  std::vector<ms::LatLon> toLoad;
+  for (auto const & coord : coords)
+  {
+    auto const key = GetKey(coord);
+    if (neededKeys.insert(key).second && m_tiles.count(key) == 0)
+      toLoad.push_back(coord);
+  }
+
+  if (m_tiles.size() + toLoad.size() > kMaxPrefetchedTilesCount)
+  {
+    for (auto it = m_tiles.begin(); it != m_tiles.end();)
+    {
+      if (neededKeys.count(it->first) == 0)
+        it = m_tiles.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  if (toLoad.empty())
+    return;
+
+  LOG(LINFO, ("Loading", toLoad.size(), "SRTM tiles,", m_tiles.size(), "tiles are reused."));
+  std::vector<SrtmTile> tiles(toLoad.size());
+  {
+    base::thread_pool::computational::ThreadPool pool(std::max(threadsCount, size_t(1)));
+    std::vector<std::future<void>> results;
+    results.reserve(toLoad.size());
+    for (size_t i = 0; i < toLoad.size(); ++i)
+      results.emplace_back(pool.Submit([&, i]() { InitTile(toLoad[i], tiles[i]); }));
+    for (auto & r : results)
+      r.get();
+  }
+
+  for (size_t i = 0; i < toLoad.size(); ++i)
+    m_tiles.emplace(GetKey(toLoad[i]), std::move(tiles[i]));
+}
+
+void SrtmTileManager::InitTile(ms::LatLon const & coord, SrtmTile & tile) const
+{
+  try
+  {
+    tile.Init(m_dir, coord);
+  }
+  catch (RootException const & e)
+  {
+    std::string const base = SrtmTile::GetBase(coord);
+    LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
+  }
+}
+
 // static
 SrtmTileManager::LatLonKey SrtmTileManager::GetKey(ms::LatLon const & coord)
 {
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace generator
 {
@@ -54,10 +55,20 @@ public:
 
   SrtmTile const & GetTile(ms::LatLon const & coord);
 
+  /// Loads tiles covering |coords| in parallel using |threadsCount| threads.
+  /// If the cache becomes too big, tiles which don't cover |coords| are dropped first.
+  void Prefetch(std::vector<ms::LatLon> const & coords, size_t threadsCount);
+
+  /// Returns height only from already loaded tiles (see Prefetch) or kInvalidAltitude.
+  /// Unlike GetHeight(), it's safe to call it concurrently.
+  geometry::Altitude GetLoadedHeight(ms::LatLon const & coord) const;
+
 private:
   using LatLonKey = std::pair<int32_t, int32_t>;
   static LatLonKey GetKey(ms::LatLon const & coord);
 
+  void InitTile(ms::LatLon const & coord, SrtmTile & tile) const;
+
   std::string m_dir;
 
   struct Hash
@@ -8,6 +8,8 @@
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
 #include <queue>
@@ -16,7 +18,158 @@
 
 namespace tesselator
 {
+namespace
+{
+// Orientation of (p1, p2, p) is exactly computed, so collinear points are never taken as a turn.
+bool IsLeftTurn(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p)
+{
+  return m2::robust::OrientedS(p1, p2, p) > 0.0;
+}
+
+// Is |p| inside or on the border of CCW triangle (a, b, c)?
+bool IsInTriangle(m2::PointD const & a, m2::PointD const & b, m2::PointD const & c, m2::PointD const & p)
+{
+  if (p.x < std::min({a.x, b.x, c.x}) || p.x > std::max({a.x, b.x, c.x}) ||
+      p.y < std::min({a.y, b.y, c.y}) || p.y > std::max({a.y, b.y, c.y}))
+  {
+    return false;
+  }
+
+  return m2::robust::OrientedS(b, p, a) >= 0.0 && m2::robust::OrientedS(c, p, b) >= 0.0 &&
+         m2::robust::OrientedS(a, p, c) >= 0.0;
+}
+
+double GetDoubledSignedArea(PointsT const & points)
+{
+  double area = 0.0;
+  for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++)
+    area += points[j].x * points[i].y - points[i].x * points[j].y;
+  return area;
+}
+}  // namespace
+
+int TesselateSimpleInterior(PointsT const & contour, TrianglesInfo & info)
+{
+  if (contour.size() < 3 || contour.size() > kMaxEarClippingPoints + 1)
+    return 0;
+
+  // Remove consecutive duplicates and a closing point.
+  PointsT points;
+  points.reserve(contour.size());
+  for (auto const & p : contour)
+  {
+    if (points.empty() || points.back() != p)
+      points.push_back(p);
+  }
+  while (points.size() > 1 && points.front() == points.back())
+    points.pop_back();
+
+  size_t const count = points.size();
+  if (count < 3 || count > kMaxEarClippingPoints)
+    return 0;
+
+  // Touching rings (repeated vertices) and self-intersections are left for libtess2.
+  {
+    PointsT sorted = points;
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+      return 0;
+  }
+  if (m2::robust::CheckPolygonSelfIntersections(points.begin(), points.end()))
+    return 0;
+
+  double const area = GetDoubledSignedArea(points);
+  if (area == 0.0)
+    return 0;
+  if (area < 0.0)
+    std::reverse(points.begin(), points.end());
+
+  // Ear clipping over a doubly linked list of the contour vertices.
+  std::vector<size_t> prev(count), next(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    prev[i] = (i + count - 1) % count;
+    next[i] = (i + 1) % count;
+  }
+
+  // Only non-convex vertices can get inside an ear of a simple polygon.
+  std::vector<bool> isConvex(count);
+  auto const updateConvex = [&](size_t v)
+  {
+    isConvex[v] = IsLeftTurn(points[v], points[next[v]], points[prev[v]]);
+  };
+  for (size_t i = 0; i < count; ++i)
+    updateConvex(i);
+
+  auto const isEar = [&](size_t v)
+  {
+    if (!isConvex[v])
+      return false;
+
+    auto const & a = points[prev[v]];
+    auto const & b = points[v];
+    auto const & c = points[next[v]];
+    for (size_t p = next[next[v]]; p != prev[v]; p = next[p])
+    {
+      if (!isConvex[p] && IsInTriangle(a, b, c, points[p]))
+        return false;
+    }
+    return true;
+  };
+
+  std::vector<std::array<size_t, 3>> triangles;
+  triangles.reserve(count - 2);
+
+  size_t v = 0;
+  size_t misses = 0;
+  for (size_t remaining = count; remaining > 3;)
+  {
+    if (isEar(v))
+    {
+      triangles.push_back({prev[v], v, next[v]});
+      next[prev[v]] = next[v];
+      prev[next[v]] = prev[v];
+      updateConvex(prev[v]);
+      updateConvex(next[v]);
+      v = prev[v];
+      --remaining;
+      misses = 0;
+    }
+    else
+    {
+      v = next[v];
+      // A full round without ears means a degenerate polygon.
+      if (++misses > remaining)
+        return 0;
+    }
+  }
+
+  if (!isConvex[v])
+    return 0;
+  triangles.push_back({prev[v], v, next[v]});
+
+  info.AssignPoints(points.begin(), points.end());
+  info.Reserve(triangles.size());
+  for (auto const & t : triangles)
+    info.Add(static_cast<int>(t[0]), static_cast<int>(t[1]), static_cast<int>(t[2]));
+
+  return static_cast<int>(triangles.size());
+}
+
 int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
+{
+  // |info| is left untouched if the fast path is not applicable.
+  if (polys.size() == 1)
+  {
+    int const count = TesselateSimpleInterior(polys.front(), info);
+    if (count != 0)
+      return count;
+  }
+
+  return TesselateComplexInterior(polys, info);
+}
+
+int TesselateComplexInterior(PolygonsT const & polys, TrianglesInfo & info)
 {
   int constexpr kCoordinatesPerVertex = 2;
   int constexpr kVerticesInPolygon = 3;
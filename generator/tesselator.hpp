@@ -182,7 +182,20 @@ namespace tesselator
     }
   };
 
-  /// Main tesselate function.
+  /// Contours with more points are always tesselated with libtess2:
+  /// ear clipping is quadratic and wins only on small polygons like building footprints.
+  size_t constexpr kMaxEarClippingPoints = 64;
+
+  /// Ear clipping tesselation of a single simple (hole-less and not self-intersecting) contour.
+  /// @returns number of resulting triangles or 0 if the contour is not suitable for the fast path.
+  int TesselateSimpleInterior(PointsT const & contour, TrianglesInfo & info);
+
+  /// libtess2 tesselation of any polygons set (holes, self-intersections) with the odd winding rule.
+  /// @returns number of resulting triangles after triangulation.
+  int TesselateComplexInterior(PolygonsT const & polys, TrianglesInfo & info);
+
+  /// Main tesselate function: tries TesselateSimpleInterior for a single contour
+  /// and falls back to TesselateComplexInterior.
   /// @returns number of resulting triangles after triangulation.
   int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info);
 }
@@ -1,5 +1,7 @@
 #include "generator/translators_pool.hpp"
 
+#include "generator/profiler.hpp"
+
 #include <future>
 
 namespace generator
@@ -21,6 +23,8 @@ void TranslatorsPool::Emit(std::vector<OsmElement> && elements)
   m_translators.WaitAndPop(translator);
   m_threadPool.SubmitWork([&, translator, elements = std::move(elements)]() mutable
   {
+    profiler::ScopedStage stage("translators/emit");
+    stage.AddElements(elements.size());
     for (auto const & element : elements)
       translator->Emit(element);
 
@@ -65,6 +69,8 @@ bool TranslatorsPool::Finish()
     queue.Push(pool.Submit([state = std::move(state)]() mutable {
       auto leftTranslator = state->left.get();
       auto rigthTranslator = state->right.get();
+      // Started after both halves are ready, so waiting for them isn't counted.
+      profiler::ScopedStage stage("translators/finish_and_merge");
       rigthTranslator->Finish();
       leftTranslator->Finish();
       leftTranslator->Merge(*rigthTranslator);
@@ -75,7 +81,11 @@ bool TranslatorsPool::Finish()
   std::future<TranslatorPtr> translatorFuture;
   queue.WaitAndPop(translatorFuture);
   auto translator = translatorFuture.get();
-  translator->Finish();
+  {
+    profiler::ScopedStage stage("translators/finish");
+    translator->Finish();
+  }
+  profiler::ScopedStage stage("translators/save");
   return translator->Save();
 }
 }  // namespace generator
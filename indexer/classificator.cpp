@@ -2,10 +2,13 @@
 #include "indexer/map_style_reader.hpp"
 #include "indexer/tree_structure.hpp"
 
+#include "base/assert.hpp"
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
 
 
 using std::string;
@@ -258,6 +261,12 @@ namespace
       while (i != m_rules.end() && i->m_scale == scale)
         add_rule(ft, i++);
     }
+
+    void find(int ft, size_t beg, size_t end)
+    {
+      for (size_t i = beg; i < end; ++i)
+        add_rule(ft, m_rules.begin() + i);
+    }
   };
 } // namespace
 
@@ -349,6 +358,7 @@ void Classificator::ReadClassificator(std::istream & s)
   tree::LoadTreeAsText(s, policy);
 
   m_root.Sort();
+  CompileTypes();
 
   m_coastType = GetTypeByPath({ "natural", "coastline" });
   m_stubType = GetTypeByPath({ "mapswithme" });
@@ -413,6 +423,7 @@ void Classificator::ReadTypesMapping(std::istream & s)
 
 void Classificator::Clear()
 {
+  m_compiledTypes.clear();
   ClassifObject("world").Swap(m_root);
   m_mapping.Clear();
 }
@@ -428,8 +439,65 @@ template <class ToDo> void Classificator::ForEachPathObject(uint32_t type, ToDo
   }
 }
 
+void Classificator::CompileTypes()
+{
+  m_compiledTypes.clear();
+  ForEachTree([this](ClassifObject const * p, uint32_t type)
+  {
+    CompiledType & compiled = m_compiledTypes[type];
+    compiled.m_object = p;
+
+    auto const & rules = p->GetDrawRules();
+    CHECK_LESS(rules.size(), std::numeric_limits<uint16_t>::max(), (p->GetName()));
+    for (int scale = 0; scale < static_cast<int>(compiled.m_rulesBegin.size()); ++scale)
+    {
+      if (scale <= scales::UPPER_STYLE_SCALE)
+        compiled.m_drawable.set(scale, p->IsDrawable(scale));
+      auto const it = std::lower_bound(rules.begin(), rules.end(), scale, less_scales());
+      compiled.m_rulesBegin[scale] = static_cast<uint16_t>(std::distance(rules.begin(), it));
+    }
+  });
+}
+
+Classificator::CompiledType const * Classificator::GetCompiledType(uint32_t type) const
+{
+  auto const it = m_compiledTypes.find(type);
+  return it != m_compiledTypes.end() ? &it->second : nullptr;
+}
+
+void Classificator::GetSuitable(uint32_t type, int scale, feature::GeomType gt,
+                                drule::KeysT & keys) const
+{
+  ASSERT(static_cast<int>(gt) >= 0 && static_cast<int>(gt) <= 2, ());
+
+  auto const * compiled = GetCompiledType(type);
+  if (compiled == nullptr)
+  {
+    GetObject(type)->GetSuitable(scale, gt, keys);
+    return;
+  }
+
+  // Drawable mask is the visibility one for objects with drawing rules.
+  if (!compiled->m_drawable[scale])
+    return;
+
+  suitable_getter rulesGetter(compiled->m_object->GetDrawRules(), keys);
+  rulesGetter.find(static_cast<int>(gt), compiled->m_rulesBegin[scale],
+                   compiled->m_rulesBegin[scale + 1]);
+}
+
+bool Classificator::IsDrawable(uint32_t type, int scale) const
+{
+  if (auto const * compiled = GetCompiledType(type))
+    return compiled->m_drawable[scale];
+  return GetObject(type)->IsDrawable(scale);
+}
+
 ClassifObject const * Classificator::GetObject(uint32_t type) const
 {
+  if (auto const * compiled = GetCompiledType(type))
+    return compiled->m_object;
+
   ClassifObject const * res = nullptr;
   ForEachPathObject(type, [&res](ClassifObject const * p)
   {
@@ -8,6 +8,9 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include "3party/skarupke/flat_hash_map.hpp"
+
+#include <array>
 #include <bitset>
 #include <string>
 #include <utility>
@@ -235,7 +238,19 @@ public:
                                          root);
   }
 
+  /// @name Constant time lookups by the compiled types table, see CompileTypes().
+  /// @{
   ClassifObject const * GetObject(uint32_t type) const;
+  /// Same as GetObject(type)->GetSuitable(scale, gt, keys).
+  void GetSuitable(uint32_t type, int scale, feature::GeomType gt, drule::KeysT & keys) const;
+  /// Same as GetObject(type)->IsDrawable(scale).
+  bool IsDrawable(uint32_t type, int scale) const;
+  /// @}
+
+  /// Builds the flat table of all types, so hot paths don't walk the tree and search drawing rules.
+  /// Should be called after any change of the tree or drawing rules.
+  void CompileTypes();
+
   std::string GetFullObjectName(uint32_t type) const;
   std::vector<std::string> GetFullObjectNamePath(uint32_t type) const;
 
@@ -248,7 +263,19 @@ private:
   template <typename Iter>
   uint32_t GetTypeByPathImpl(Iter beg, Iter end) const;
 
+  struct CompiledType
+  {
+    ClassifObject const * m_object = nullptr;
+    ClassifObject::VisibleMask m_drawable;
+    // Drawing rules of a scale are [m_rulesBegin[scale], m_rulesBegin[scale + 1]) of the object
+    // drawing rules, the range is empty when the object is invisible on the scale.
+    std::array<uint16_t, scales::UPPER_STYLE_SCALE + 2> m_rulesBegin = {};
+  };
+
+  CompiledType const * GetCompiledType(uint32_t type) const;
+
   ClassifObject m_root;
+  ska::flat_hash_map<uint32_t, CompiledType> m_compiledTypes;
   IndexAndTypeMapping m_mapping;
   uint32_t m_coastType = 0;
   uint32_t m_stubType = 0;
@@ -10,13 +10,16 @@ public:
   enum class Version : uint8_t
   {
     V0 = 0,
-    Latest = V0
+    // Feature records are moved to FEATURES_BLOCKS_FILE_TAG section, see feature::FeaturesBlocks.
+    // Readers of V0 can't read it and reject the header.
+    V1 = 1,
+    Latest = V1
   };
 
   template <typename Sink>
   void Serialize(Sink & sink) const
   {
-    CHECK_EQUAL(m_version, Version::V0, ());
+    CHECK_LESS_OR_EQUAL(m_version, Version::Latest, ());
     WriteToSink(sink, static_cast<uint8_t>(m_version));
     WriteToSink(sink, m_featuresOffset);
     WriteToSink(sink, m_featuresSize);
@@ -26,12 +29,13 @@ public:
   {
     NonOwningReaderSource source(reader);
     m_version = static_cast<Version>(ReadPrimitiveFromSource<uint8_t>(source));
-    CHECK_EQUAL(static_cast<uint8_t>(m_version), static_cast<uint8_t>(Version::V0), ());
+    CHECK_LESS_OR_EQUAL(static_cast<uint8_t>(m_version), static_cast<uint8_t>(Version::Latest), ());
     m_featuresOffset = ReadPrimitiveFromSource<uint32_t>(source);
     m_featuresSize = ReadPrimitiveFromSource<uint32_t>(source);
   }
 
-  Version m_version = Version::Latest;
+  // V1 is written by the features compression pass only.
+  Version m_version = Version::V0;
   // All offsets are relative to the start of the section (offset of header is zero).
   uint32_t m_featuresOffset = 0;
   uint32_t m_featuresSize = 0;
@@ -39,7 +43,11 @@ public:
 
 inline std::string DebugPrint(DatSectionHeader::Version v)
 {
-  CHECK(v == DatSectionHeader::Version::V0, ());
-  return "V0";
+  switch (v)
+  {
+  case DatSectionHeader::Version::V0: return "V0";
+  case DatSectionHeader::Version::V1: return "V1";
+  }
+  UNREACHABLE();
 }
 }  // namespace feature
@@ -1,10 +1,15 @@
 #include "indexer/data_source.hpp"
+#include "indexer/features_blocks.hpp"
 #include "indexer/scale_index.hpp"
 #include "indexer/unique_index.hpp"
 
 #include "platform/mwm_version.hpp"
 
+#include "base/thread_pool_computational.hpp"
+
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <limits>
 
 using platform::CountryFile;
@@ -49,20 +54,33 @@ public:
       if (scale > lastScale)
         scale = lastScale;
 
-      // Use last coding scale for covering (see index_builder.cpp).
-      covering::Intervals const & intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
-      ScaleIndex<ModelReaderPtr> index(mwmValue->m_cont.GetReader(INDEX_FILE_TAG), mwmValue->m_factory);
-
-      // iterate through intervals
-      for (auto const & i : intervals)
+      // R-tree boxes are exact for a viewport, other modes are defined by the cells covering.
+      auto const * rtree = mwmValue->GetRTree();
+      if (cov.GetMode() == covering::ViewportWithLowLevels && rtree)
       {
-        index.ForEachInIntervalAndScale(i.first, i.second, scale, [&](uint64_t /* key */, uint32_t value)
+        rtree->ForEachInRectAndScale(cov.GetRect(), scale, [&](uint32_t value)
         {
           if (checkUnique(value))
             m_fn(value, *src);
         });
-        if (m_stop())
-          break;
+      }
+      else
+      {
+        // Use last coding scale for covering (see index_builder.cpp).
+        covering::Intervals const & intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
+        ScaleIndex<ModelReaderPtr> index(mwmValue->m_cont.GetReader(INDEX_FILE_TAG), mwmValue->m_factory);
+
+        // iterate through intervals
+        for (auto const & i : intervals)
+        {
+          index.ForEachInIntervalAndScale(i.first, i.second, scale, [&](uint64_t /* key */, uint32_t value)
+          {
+            if (checkUnique(value))
+              m_fn(value, *src);
+          });
+          if (m_stop())
+            break;
+        }
       }
     }
 
@@ -79,6 +97,52 @@ private:
   DataSource::StopSearchCallback m_stop;
 };
 
+// Thread-safe version of CheckUniqueIndexes for a known features count.
+class ConcurrentUniqueIndexes
+{
+public:
+  explicit ConcurrentUniqueIndexes(size_t count) : m_bits((count + 63) / 64) {}
+
+  bool operator()(uint32_t index)
+  {
+    ASSERT_LESS(index / 64, m_bits.size(), ());
+    uint64_t const mask = uint64_t(1) << (index % 64);
+    return (m_bits[index / 64].fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+  }
+
+private:
+  std::vector<std::atomic<uint64_t>> m_bits;
+};
+
+// Splits |intervals| into about |count| chunks of consecutive intervals. Long intervals
+// (e.g. the whole world in FullCover mode) are split into equal key ranges.
+std::vector<covering::Intervals> SplitIntervals(covering::Intervals const & intervals, size_t count)
+{
+  std::vector<covering::Intervals> chunks;
+  if (intervals.empty())
+    return chunks;
+
+  if (intervals.size() >= count)
+  {
+    size_t const chunkSize = (intervals.size() + count - 1) / count;
+    for (size_t i = 0; i < intervals.size(); i += chunkSize)
+    {
+      auto const end = std::min(i + chunkSize, intervals.size());
+      chunks.emplace_back(intervals.begin() + i, intervals.begin() + end);
+    }
+    return chunks;
+  }
+
+  auto const parts = static_cast<int64_t>((count + intervals.size() - 1) / intervals.size());
+  for (auto const & [beg, end] : intervals)
+  {
+    auto const step = std::max<int64_t>((end - beg + parts - 1) / parts, 1);
+    for (auto b = beg; b < end; b += step)
+      chunks.push_back({{b, std::min(b + step, end)}});
+  }
+  return chunks;
+}
+
 void ReadFeatureType(std::function<void(FeatureType &)> const & fn, FeatureSource & src, uint32_t index)
 {
   std::unique_ptr<FeatureType> ft;
@@ -94,8 +158,9 @@ void ReadFeatureType(std::function<void(FeatureType &)> const & fn, FeatureSourc
   }
   case FeatureStatus::Untouched:
   {
-    ft = src.GetOriginalFeature(index);
-    break;
+    // The most common case: read the feature without allocations.
+    src.ReadOriginalFeature(index, fn);
+    return;
   }
   }
   CHECK(ft, ());
@@ -175,6 +240,7 @@ std::unique_ptr<MwmValue> DataSource::CreateValue(MwmInfo & info) const
 
   p->m_metaDeserializer = indexer::MetadataDeserializer::Load(p->m_cont);
   CHECK(p->m_metaDeserializer, ());
+  p->m_featuresBlocks = feature::FeaturesBlocks::Load(p->m_cont);
   return p;
 }
 
@@ -262,6 +328,179 @@ void DataSource::ForEachInScale(FeatureCallback const & f, int scale) const
   ForEachInIntervals(readFunctor, covering::FullCover, m2::RectD::GetInfiniteRect(), scale);
 }
 
+void DataSource::ForEachInRectParallel(ParallelFeatureCallback const & f, m2::RectD const & rect,
+                                       int scale, size_t threadsCount) const
+{
+  ForEachInIntervalsParallel(f, covering::ViewportWithLowLevels, rect, scale, threadsCount);
+}
+
+void DataSource::ForEachInScaleParallel(ParallelFeatureCallback const & f, int scale,
+                                        size_t threadsCount) const
+{
+  ForEachInIntervalsParallel(f, covering::FullCover, m2::RectD::GetInfiniteRect(), scale,
+                             threadsCount);
+}
+
+void DataSource::ForEachInIntervalsParallel(ParallelFeatureCallback const & f,
+                                            covering::CoveringMode mode, m2::RectD const & rect,
+                                            int scale, size_t threadsCount) const
+{
+  CHECK_GREATER(threadsCount, 0, ());
+
+  // Every chunk is read by one thread.
+  size_t constexpr kChunksPerThread = 4;
+
+  struct Mwm
+  {
+    MwmId m_id;
+    int m_scale = 0;
+    // Features are read from this number of parts of the R-tree as in ReadMWMFunctor,
+    // 0 if they are read by the cells covering.
+    size_t m_rtreeParts = 0;
+    std::unique_ptr<ConcurrentUniqueIndexes> m_unique;
+  };
+
+  struct Chunk
+  {
+    size_t m_mwm = 0;
+    covering::Intervals m_intervals;
+    size_t m_rtreePart = 0;
+    // Edited features of the mwm are read with its first chunk.
+    bool m_readAdditional = false;
+  };
+
+  std::vector<std::shared_ptr<MwmInfo>> infos;
+  GetMwmsInfo(infos);
+  base::EraseIf(infos, [&](auto const & info)
+  {
+    return !(info->m_minScale <= scale && scale <= info->m_maxScale &&
+             rect.IsIntersect(info->m_bordersRect));
+  });
+  if (infos.empty())
+    return;
+
+  covering::CoveringGetter cov(rect, mode);
+  size_t const chunksPerMwm = (threadsCount * kChunksPerThread + infos.size() - 1) / infos.size();
+
+  std::vector<Mwm> mwms;
+  std::vector<Chunk> chunks;
+  for (auto const & info : infos)
+  {
+    // Handles are locked by the workers, this one is needed to read the header only.
+    MwmHandle const handle = GetMwmHandleById(MwmId(info));
+    if (!handle.IsAlive())
+      continue;
+
+    Mwm mwm;
+    mwm.m_id = handle.GetId();
+    auto const lastScale = handle.GetValue()->GetHeader().GetLastScale();
+    mwm.m_scale = std::min(scale, lastScale);
+
+    // Duplicates of different chunks can't be detected without the features count.
+    size_t const featuresCount = (*m_factory)(handle)->GetNumFeatures();
+    if (featuresCount != 0)
+      mwm.m_unique = std::make_unique<ConcurrentUniqueIndexes>(featuresCount);
+
+    size_t const firstChunk = chunks.size();
+    if (mode == covering::ViewportWithLowLevels && handle.GetValue()->GetRTree())
+    {
+      mwm.m_rtreeParts = featuresCount != 0 ? chunksPerMwm : 1;
+      for (size_t part = 0; part < mwm.m_rtreeParts; ++part)
+      {
+        Chunk chunk;
+        chunk.m_mwm = mwms.size();
+        chunk.m_rtreePart = part;
+        chunks.push_back(std::move(chunk));
+      }
+    }
+    else
+    {
+      auto const & intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
+      auto mwmChunks = SplitIntervals(intervals, featuresCount != 0 ? chunksPerMwm : 1);
+      if (mwmChunks.empty())
+        mwmChunks.emplace_back();
+
+      for (auto & intervalsChunk : mwmChunks)
+      {
+        Chunk chunk;
+        chunk.m_mwm = mwms.size();
+        chunk.m_intervals = std::move(intervalsChunk);
+        chunks.push_back(std::move(chunk));
+      }
+    }
+    chunks[firstChunk].m_readAdditional = true;
+    mwms.push_back(std::move(mwm));
+  }
+
+  std::atomic<size_t> nextChunk = 0;
+  auto const worker = [&](size_t threadIndex)
+  {
+    FeatureCallback const fn = [&f, threadIndex](FeatureType & ft) { f(ft, threadIndex); };
+
+    size_t mwmIndex = mwms.size();
+    MwmHandle handle;
+    std::unique_ptr<FeatureSource> src;
+    std::unique_ptr<ScaleIndex<ModelReaderPtr>> index;
+
+    for (size_t i = nextChunk++; i < chunks.size(); i = nextChunk++)
+    {
+      auto const & chunk = chunks[i];
+      auto & mwm = mwms[chunk.m_mwm];
+      if (chunk.m_mwm != mwmIndex)
+      {
+        // FeatureSource refers to the handle.
+        index.reset();
+        src.reset();
+        handle = GetMwmHandleById(mwm.m_id);
+        if (!handle.IsAlive())
+        {
+          mwmIndex = mwms.size();
+          continue;
+        }
+
+        auto const & value = *handle.GetValue();
+        src = (*m_factory)(handle);
+        index = std::make_unique<ScaleIndex<ModelReaderPtr>>(value.m_cont.GetReader(INDEX_FILE_TAG),
+                                                             value.m_factory);
+        mwmIndex = chunk.m_mwm;
+      }
+
+      CheckUniqueIndexes checkUnique;
+      auto const readFeature = [&](uint64_t /* key */, uint32_t value)
+      {
+        if (mwm.m_unique ? (*mwm.m_unique)(value) : checkUnique(value))
+          ReadFeatureType(fn, *src, value);
+      };
+
+      if (mwm.m_rtreeParts != 0)
+      {
+        auto const * rtree = handle.GetValue()->GetRTree();
+        CHECK(rtree, (mwm.m_id));
+        rtree->ForEachInRectAndScale(cov.GetRect(), mwm.m_scale, chunk.m_rtreePart, mwm.m_rtreeParts,
+                                     [&](uint32_t value) { readFeature(0 /* key */, value); });
+      }
+      else
+      {
+        for (auto const & [beg, end] : chunk.m_intervals)
+          index->ForEachInIntervalAndScale(beg, end, mwm.m_scale, readFeature);
+      }
+
+      if (chunk.m_readAdditional)
+      {
+        src->ForEachAdditionalFeature(rect, mwm.m_scale,
+                                      [&](uint32_t value) { ReadFeatureType(fn, *src, value); });
+      }
+    }
+  };
+
+  base::thread_pool::computational::ThreadPool pool(threadsCount);
+  std::vector<std::future<void>> results;
+  for (size_t i = 0; i < threadsCount; ++i)
+    results.push_back(pool.Submit(worker, i));
+  for (auto & result : results)
+    result.get();
+}
+
 void DataSource::ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const & rect, int scale,
                                      MwmId const & id) const
 {
@@ -298,14 +537,16 @@ void DataSource::ReadFeatures(FeatureCallback const & fn, std::vector<FeatureID>
         ASSERT_NOT_EQUAL(
             FeatureStatus::Deleted, fts,
             ("Deleted feature was cached. It should not be here. Please review your code."));
-        std::unique_ptr<FeatureType> ft;
         if (fts == FeatureStatus::Modified || fts == FeatureStatus::Created)
-          ft = src->GetModifiedFeature(fidIter->m_index);
+        {
+          auto ft = src->GetModifiedFeature(fidIter->m_index);
+          CHECK(ft, ());
+          fn(*ft);
+        }
         else
-          ft = src->GetOriginalFeature(fidIter->m_index);
-
-        CHECK(ft, ());
-        fn(*ft);
+        {
+          src->ReadOriginalFeature(fidIter->m_index, fn);
+        }
       } while (++fidIter != endIter && id == fidIter->m_mwmId);
     }
     else
@@ -13,6 +13,7 @@ class DataSource : public MwmSet
 {
 public:
   using FeatureCallback = std::function<void(FeatureType &)>;
+  using ParallelFeatureCallback = std::function<void(FeatureType &, size_t threadIndex)>;
   using FeatureIdCallback = std::function<void(FeatureID const &)>;
   using StopSearchCallback = std::function<bool(void)>;
 
@@ -38,6 +39,17 @@ public:
   void ForEachInScale(FeatureCallback const & f, int scale) const;
   void ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const & rect, int scale,
                            MwmId const & id) const;
+
+  /// Parallel versions of ForEachInRect and ForEachInScale for offline tools.
+  /// Mwms and their covering intervals are split into chunks, which are read by |threadsCount|
+  /// threads, each with its own mwm handles and FeatureSource. |f| is called concurrently,
+  /// |threadIndex| is in [0, threadsCount) and may be used to address per-thread accumulators.
+  /// Every feature is visited once, but features order is unspecified.
+  void ForEachInRectParallel(ParallelFeatureCallback const & f, m2::RectD const & rect, int scale,
+                             size_t threadsCount) const;
+  void ForEachInScaleParallel(ParallelFeatureCallback const & f, int scale,
+                              size_t threadsCount) const;
+
   // "features" must be sorted using FeatureID::operator< as predicate.
   void ReadFeatures(FeatureCallback const & fn, std::vector<FeatureID> const & features) const;
 
@@ -67,6 +79,9 @@ protected:
   /// @}
 
 private:
+  void ForEachInIntervalsParallel(ParallelFeatureCallback const & f, covering::CoveringMode mode,
+                                  m2::RectD const & rect, int scale, size_t threadsCount) const;
+
   std::unique_ptr<FeatureSourceFactory> m_factory;
 };
 
@@ -417,7 +417,9 @@ void RulesHolder::LoadFromBinaryProto(string const & s)
 
   CHECK ( doSet.m_cont.ParseFromString(s), ("Error in proto loading!") );
 
-  classif().GetMutableRoot()->ForEachObject(ref(doSet));
+  Classificator & c = classif();
+  c.GetMutableRoot()->ForEachObject(ref(doSet));
+  c.CompileTypes();
 
   InitBackgroundColors(doSet.m_cont);
   InitColors(doSet.m_cont);
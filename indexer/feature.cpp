@@ -117,12 +117,6 @@ uint32_t CalcOffset(ArrayByteSource const & source, uint8_t const * start)
   return static_cast<uint32_t>(distance(start, source.PtrUint8()));
 }
 
-uint8_t Header(vector<uint8_t> const & data)
-{
- CHECK(!data.empty(), ());
- return data[0];
-}
-
 void ReadOffsets(SharedLoadInfo const & loadInfo, ArrayByteSource & src, uint8_t mask,
                  FeatureType::GeometryOffsets & offsets)
 {
@@ -190,12 +184,28 @@ uint8_t ReadByte(TSource & src)
 FeatureType::FeatureType(SharedLoadInfo const * loadInfo, vector<uint8_t> && buffer,
                          indexer::MetadataDeserializer * metadataDeserializer)
   : m_loadInfo(loadInfo)
-  , m_data(std::move(buffer))
+  , m_buffer(std::move(buffer))
+  , m_metadataDeserializer(metadataDeserializer)
+{
+  CHECK(m_loadInfo, ());
+  CHECK(!m_buffer.empty(), ());
+
+  m_data = m_buffer.data();
+  m_dataSize = m_buffer.size();
+  m_header = m_data[0]; // Parse the header and optional name/layer/addinfo.
+}
+
+FeatureType::FeatureType(SharedLoadInfo const * loadInfo, uint8_t const * data, size_t size,
+                         indexer::MetadataDeserializer * metadataDeserializer)
+  : m_loadInfo(loadInfo)
+  , m_data(data)
+  , m_dataSize(size)
   , m_metadataDeserializer(metadataDeserializer)
 {
   CHECK(m_loadInfo, ());
+  CHECK(m_data && size > 0, ());
 
-  m_header = Header(m_data); // Parse the header and optional name/layer/addinfo.
+  m_header = m_data[0];
 }
 
 std::unique_ptr<FeatureType> FeatureType::CreateFromMapObject(osm::MapObject const & emo)
@@ -274,7 +284,7 @@ void FeatureType::ParseTypes()
 
   auto const typesOffset = sizeof(m_header);
   Classificator & c = classif();
-  ArrayByteSource source(m_data.data() + typesOffset);
+  ArrayByteSource source(m_data + typesOffset);
 
   size_t const count = GetTypesCount();
   for (size_t i = 0; i < count; ++i)
@@ -293,7 +303,7 @@ void FeatureType::ParseTypes()
     }
   }
 
-  m_offsets.m_common = CalcOffset(source, m_data.data());
+  m_offsets.m_common = CalcOffset(source, m_data);
   m_parsed.m_types = true;
 }
 
@@ -305,9 +315,8 @@ void FeatureType::ParseCommon()
   CHECK(m_loadInfo, ());
   ParseTypes();
 
-  ArrayByteSource source(m_data.data() + m_offsets.m_common);
-  uint8_t const h = Header(m_data);
-  m_params.Read(source, h);
+  ArrayByteSource source(m_data + m_offsets.m_common);
+  m_params.Read(source, m_header);
 
   if (GetGeomType() == GeomType::Point)
   {
@@ -315,7 +324,7 @@ void FeatureType::ParseCommon()
     m_limitRect.Add(m_center);
   }
 
-  m_offsets.m_header2 = CalcOffset(source, m_data.data());
+  m_offsets.m_header2 = CalcOffset(source, m_data);
   m_parsed.m_common = true;
 }
 
@@ -351,8 +360,8 @@ void FeatureType::ParseHeader2()
   ParseCommon();
 
   uint8_t elemsCount = 0, geomScalesMask = 0;
-  BitSource bitSource(m_data.data() + m_offsets.m_header2);
-  auto const headerGeomType = static_cast<HeaderGeomType>(Header(m_data) & HEADER_MASK_GEOMTYPE);
+  BitSource bitSource(m_data + m_offsets.m_header2);
+  auto const headerGeomType = static_cast<HeaderGeomType>(m_header & HEADER_MASK_GEOMTYPE);
 
   if (headerGeomType == HeaderGeomType::Line || headerGeomType == HeaderGeomType::Area)
   {
@@ -389,7 +398,8 @@ void FeatureType::ParseHeader2()
       }
 
       auto const * start = src.PtrUint8();
-      src = ArrayByteSource(serial::LoadInnerPath(start, elemsCount, cp, m_points));
+      src = ArrayByteSource(
+          serial::LoadInnerPath(start, m_data + m_dataSize, elemsCount, cp, m_points));
       // TODO: here and further m_innerStats is needed for stats calculation in generator_tool only
       m_innerStats.m_points = CalcOffset(src, start);
     }
@@ -410,7 +420,8 @@ void FeatureType::ParseHeader2()
       elemsCount += 2;
 
       auto const * start = src.PtrUint8();
-      src = ArrayByteSource(serial::LoadInnerTriangles(start, elemsCount, cp, m_triangles));
+      src = ArrayByteSource(
+          serial::LoadInnerTriangles(start, m_data + m_dataSize, elemsCount, cp, m_triangles));
       m_innerStats.m_strips = CalcOffset(src, start);
     }
     else
@@ -420,7 +431,7 @@ void FeatureType::ParseHeader2()
     }
   }
   // Size of the whole header incl. inner geometry / triangles.
-  m_innerStats.m_size = CalcOffset(src, m_data.data());
+  m_innerStats.m_size = CalcOffset(src, m_data);
   m_parsed.m_header2 = true;
 }
 
@@ -449,7 +460,7 @@ void FeatureType::ParseGeometry(int scale)
     CHECK(m_loadInfo, ());
     ParseHeader2();
 
-    auto const headerGeomType = static_cast<HeaderGeomType>(Header(m_data) & HEADER_MASK_GEOMTYPE);
+    auto const headerGeomType = static_cast<HeaderGeomType>(m_header & HEADER_MASK_GEOMTYPE);
     if (headerGeomType == HeaderGeomType::Line)
     {
       size_t const pointsCount = m_points.size();
@@ -501,7 +512,7 @@ FeatureType::GeomStat FeatureType::GetOuterGeometryStats()
   ASSERT_LESS_OR_EQUAL(scalesCount, DataHeader::kMaxScalesCount, ("MWM has too many geometry scales!"));
   FeatureType::GeomStat res;
 
-  auto const headerGeomType = static_cast<HeaderGeomType>(Header(m_data) & HEADER_MASK_GEOMTYPE);
+  auto const headerGeomType = static_cast<HeaderGeomType>(m_header & HEADER_MASK_GEOMTYPE);
   if (headerGeomType == HeaderGeomType::Line)
   {
     size_t const pointsCount = m_points.size();
@@ -550,7 +561,7 @@ void FeatureType::ParseTriangles(int scale)
     CHECK(m_loadInfo, ());
     ParseHeader2();
 
-    auto const headerGeomType = static_cast<HeaderGeomType>(Header(m_data) & HEADER_MASK_GEOMTYPE);
+    auto const headerGeomType = static_cast<HeaderGeomType>(m_header & HEADER_MASK_GEOMTYPE);
     if (headerGeomType == HeaderGeomType::Area)
     {
       if (m_triangles.empty())
@@ -577,7 +588,7 @@ FeatureType::GeomStat FeatureType::GetOuterTrianglesStats()
   ASSERT_LESS_OR_EQUAL(scalesCount, static_cast<int>(DataHeader::kMaxScalesCount), ("MWM has too many geometry scales!"));
   FeatureType::GeomStat res;
 
-  auto const headerGeomType = static_cast<HeaderGeomType>(Header(m_data) & HEADER_MASK_GEOMTYPE);
+  auto const headerGeomType = static_cast<HeaderGeomType>(m_header & HEADER_MASK_GEOMTYPE);
   if (headerGeomType == HeaderGeomType::Area)
   {
     if (m_triangles.empty())
@@ -36,6 +36,9 @@ public:
 
   FeatureType(feature::SharedLoadInfo const * loadInfo, std::vector<uint8_t> && buffer,
               indexer::MetadataDeserializer * metadataDeserializer);
+  /// Doesn't copy the feature record, |data| should outlive the feature (mapped mwm section).
+  FeatureType(feature::SharedLoadInfo const * loadInfo, uint8_t const * data, size_t size,
+              indexer::MetadataDeserializer * metadataDeserializer);
 
   static std::unique_ptr<FeatureType> CreateFromMapObject(osm::MapObject const & emo);
 
@@ -245,7 +248,10 @@ private:
 
   // Non-owning pointer to shared load info. SharedLoadInfo created once per FeaturesVector.
   feature::SharedLoadInfo const * m_loadInfo = nullptr;
-  std::vector<uint8_t> m_data;
+  // Feature record. Points to |m_buffer| or to the memory of mapped mwm section.
+  uint8_t const * m_data = nullptr;
+  size_t m_dataSize = 0;
+  std::vector<uint8_t> m_buffer;
 
   // Pointer to shared metedata deserializer. Must be set for mwm format >= Format::v11
   indexer::MetadataDeserializer * m_metadataDeserializer = nullptr;
@@ -0,0 +1,358 @@
+#include "indexer/feature_columns.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/endianness.hpp"
+#include "coding/files_container.hpp"
+#include "coding/point_coding.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "defines.hpp"
+
+namespace feature
+{
+namespace
+{
+uint8_t GetBits(uint32_t maxValue) { return maxValue == 0 ? 0 : bits::FloorLog(maxValue) + 1; }
+
+uint64_t GetWordsCount(uint32_t count, uint8_t bits)
+{
+  return (static_cast<uint64_t>(count) * bits + 63) / 64;
+}
+
+void WriteString(Writer & writer, std::string const & s)
+{
+  WriteVarUint(writer, base::checked_cast<uint32_t>(s.size()));
+  writer.Write(s.data(), s.size());
+}
+
+std::string_view ReadString(ArrayByteSource & src)
+{
+  auto const size = ReadVarUint<uint32_t>(src);
+  std::string_view const s(reinterpret_cast<char const *>(src.PtrUint8()), size);
+  src.Advance(size);
+  return s;
+}
+}  // namespace
+
+// PackedColumn ------------------------------------------------------------------------------------
+uint32_t PackedColumn::Get(uint32_t i) const
+{
+  if (m_bits == 0)
+    return 0;
+
+  uint64_t const pos = static_cast<uint64_t>(i) * m_bits;
+  uint8_t const * p = m_words + (pos / 64) * sizeof(uint64_t);
+  uint32_t const shift = pos % 64;
+
+  uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  uint64_t value = SwapIfBigEndianMacroBased(word) >> shift;
+  if (shift + m_bits > 64)
+  {
+    std::memcpy(&word, p + sizeof(word), sizeof(word));
+    value |= SwapIfBigEndianMacroBased(word) << (64 - shift);
+  }
+  return static_cast<uint32_t>(value & ((uint64_t(1) << m_bits) - 1));
+}
+
+// static
+void PackedColumn::Write(Writer & writer, std::vector<uint32_t> const & values)
+{
+  uint32_t const maxValue = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+  uint8_t const bits = GetBits(maxValue);
+  WriteToSink(writer, bits);
+
+  std::vector<uint64_t> words(GetWordsCount(base::checked_cast<uint32_t>(values.size()), bits));
+  for (size_t i = 0; i < values.size() && bits != 0; ++i)
+  {
+    uint64_t const pos = static_cast<uint64_t>(i) * bits;
+    uint32_t const shift = pos % 64;
+    words[pos / 64] |= static_cast<uint64_t>(values[i]) << shift;
+    if (shift + bits > 64)
+      words[pos / 64 + 1] |= static_cast<uint64_t>(values[i]) >> (64 - shift);
+  }
+
+  for (auto const w : words)
+    WriteToSink(writer, w);
+}
+
+// static
+PackedColumn PackedColumn::Read(ArrayByteSource & src, uint32_t count)
+{
+  auto const bits = ReadPrimitiveFromSource<uint8_t>(src);
+  CHECK_LESS_OR_EQUAL(bits, 32, ());
+  PackedColumn const column(src.PtrUint8(), bits);
+  src.Advance(GetWordsCount(count, bits) * sizeof(uint64_t));
+  return column;
+}
+
+// FeatureColumns ----------------------------------------------------------------------------------
+// static
+std::vector<Metadata::EType> const & FeatureColumns::GetDefaultMetadata()
+{
+  static std::vector<Metadata::EType> const kMetadata = {
+      Metadata::FMD_CUISINE, Metadata::FMD_OPEN_HOURS, Metadata::FMD_OPERATOR,
+      Metadata::FMD_POSTCODE, Metadata::FMD_BRAND};
+  return kMetadata;
+}
+
+// static
+std::unique_ptr<FeatureColumns> FeatureColumns::Load(FilesContainerR const & cont)
+{
+  if (!cont.IsExist(FEATURE_COLUMNS_FILE_TAG))
+    return {};
+
+  auto reader = cont.GetReader(FEATURE_COLUMNS_FILE_TAG);
+  return Load(*reader.GetPtr());
+}
+
+// static
+std::unique_ptr<FeatureColumns> FeatureColumns::Load(Reader & reader)
+{
+  auto columns = std::make_unique<FeatureColumns>();
+  columns->m_buffer.resize(base::checked_cast<size_t>(reader.Size()));
+  reader.Read(0, columns->m_buffer.data(), columns->m_buffer.size());
+
+  if (!columns->Init())
+    return {};
+  return columns;
+}
+
+bool FeatureColumns::Init()
+{
+  if (m_buffer.empty())
+    return false;
+
+  ArrayByteSource src(m_buffer.data());
+  auto const version = static_cast<Version>(ReadPrimitiveFromSource<uint8_t>(src));
+  if (version != Version::V0)
+  {
+    LOG(LWARNING, ("Unknown feature columns version:", static_cast<int>(version)));
+    return false;
+  }
+
+  m_count = ReadPrimitiveFromSource<uint32_t>(src);
+
+  // Types.
+  auto const & c = classif();
+  m_typesDictionary.resize(ReadVarUint<uint32_t>(src));
+  for (auto & types : m_typesDictionary)
+  {
+    types = TypesHolder(static_cast<GeomType>(ReadPrimitiveFromSource<int8_t>(src)));
+    auto const count = ReadPrimitiveFromSource<uint8_t>(src);
+    for (uint8_t i = 0; i < count; ++i)
+    {
+      uint32_t const type = c.GetTypeForIndex(ReadVarUint<uint32_t>(src));
+      types.Add(type > 0 ? type : c.GetStubType());
+    }
+  }
+
+  m_types = PackedColumn::Read(src, m_count);
+
+  // Centers.
+  m_coordBits = ReadPrimitiveFromSource<uint8_t>(src);
+  auto const minX = ReadPrimitiveFromSource<uint32_t>(src);
+  auto const minY = ReadPrimitiveFromSource<uint32_t>(src);
+  auto const maxX = ReadPrimitiveFromSource<uint32_t>(src);
+  auto const maxY = ReadPrimitiveFromSource<uint32_t>(src);
+  m_limitRect = m2::RectD(PointUToPointD({minX, minY}, kPointCoordBits),
+                          PointUToPointD({maxX, maxY}, kPointCoordBits));
+
+  m_x = PackedColumn::Read(src, m_count);
+  m_y = PackedColumn::Read(src, m_count);
+  m_ranks = PackedColumn::Read(src, m_count);
+
+  // Metadata.
+  auto const metadataCount = ReadPrimitiveFromSource<uint8_t>(src);
+  for (uint8_t i = 0; i < metadataCount; ++i)
+  {
+    auto & column = m_metadata[static_cast<Metadata::EType>(ReadPrimitiveFromSource<int8_t>(src))];
+    column.m_dictionary.resize(ReadVarUint<uint32_t>(src));
+    for (auto & s : column.m_dictionary)
+      s = ReadString(src);
+    column.m_ids = PackedColumn::Read(src, m_count);
+  }
+
+  CHECK_LESS_OR_EQUAL(static_cast<size_t>(src.PtrUint8() - m_buffer.data()), m_buffer.size(), ());
+  return true;
+}
+
+TypesHolder const & FeatureColumns::GetTypes(uint32_t index) const
+{
+  ASSERT_LESS(index, m_count, ());
+  return m_typesDictionary[m_types.Get(index)];
+}
+
+m2::PointD FeatureColumns::GetCenter(uint32_t index) const
+{
+  ASSERT_LESS(index, m_count, ());
+  return PointUToPointD({m_x.Get(index), m_y.Get(index)}, m_coordBits, m_limitRect);
+}
+
+uint8_t FeatureColumns::GetRank(uint32_t index) const
+{
+  ASSERT_LESS(index, m_count, ());
+  return static_cast<uint8_t>(m_ranks.Get(index));
+}
+
+std::string_view FeatureColumns::GetMetadata(uint32_t index, Metadata::EType type) const
+{
+  ASSERT_LESS(index, m_count, ());
+  auto const it = m_metadata.find(type);
+  if (it == m_metadata.cend())
+    return {};
+
+  auto const id = it->second.m_ids.Get(index);
+  return id == 0 ? std::string_view() : it->second.m_dictionary[id - 1];
+}
+
+void FeatureColumns::ForEach(FeatureColumnsQuery const & query,
+                             std::function<void(uint32_t)> const & fn) const
+{
+  // Filters are evaluated once per dictionary value, the scan compares ids only.
+  std::vector<bool> typesMatch(m_typesDictionary.size(), query.m_types.empty());
+  for (size_t i = 0; i < m_typesDictionary.size() && !query.m_types.empty(); ++i)
+  {
+    for (uint32_t const type : m_typesDictionary[i])
+    {
+      for (uint32_t const queryType : query.m_types)
+      {
+        uint32_t t = type;
+        ftype::TruncValue(t, ftype::GetLevel(queryType));
+        if (t == queryType)
+          typesMatch[i] = true;
+      }
+    }
+  }
+
+  std::vector<PackedColumn const *> metadata;
+  for (auto const type : query.m_metadata)
+  {
+    auto const it = m_metadata.find(type);
+    if (it == m_metadata.cend())
+      return;
+    metadata.push_back(&it->second.m_ids);
+  }
+
+  bool const checkRect = !query.m_rect.IsRectInside(m_limitRect);
+  for (uint32_t i = 0; i < m_count; ++i)
+  {
+    if (!typesMatch[m_types.Get(i)])
+      continue;
+
+    if (std::any_of(metadata.begin(), metadata.end(),
+                    [i](PackedColumn const * column) { return column->Get(i) == 0; }))
+    {
+      continue;
+    }
+
+    if (checkRect && !query.m_rect.IsPointInside(GetCenter(i)))
+      continue;
+
+    fn(i);
+  }
+}
+
+// FeatureColumnsBuilder ---------------------------------------------------------------------------
+FeatureColumnsBuilder::FeatureColumnsBuilder(m2::RectD const & limitRect,
+                                             std::vector<Metadata::EType> const & metadata)
+  : m_limitRect(limitRect), m_coordBits(GetCoordBits(limitRect, kMwmPointAccuracy))
+{
+  CHECK(limitRect.IsValid(), (limitRect));
+  for (auto const type : metadata)
+    m_metadata[type];
+}
+
+void FeatureColumnsBuilder::Put(uint32_t index, FeatureType & ft)
+{
+  CHECK_EQUAL(index, m_types.size(), ("Features should be put without gaps."));
+
+  auto const & c = classif();
+  std::vector<uint32_t> types = {static_cast<uint32_t>(ft.GetGeomType())};
+  ft.ForEachType([&](uint32_t type) { types.push_back(c.GetIndexForType(type)); });
+  auto const typesId = m_typesDictionary.emplace(std::move(types), m_typesDictionary.size()).first->second;
+  m_types.push_back(typesId);
+
+  auto const center = PointDToPointU(feature::GetCenter(ft), m_coordBits, m_limitRect);
+  m_x.push_back(center.x);
+  m_y.push_back(center.y);
+
+  m_ranks.push_back(ft.GetRank());
+
+  for (auto & [type, column] : m_metadata)
+  {
+    auto const value = ft.GetMetadata(type);
+    if (value.empty())
+    {
+      column.m_ids.push_back(0);
+      continue;
+    }
+
+    auto const id = column.m_dictionary.emplace(std::string(value), column.m_dictionary.size()).first->second;
+    column.m_ids.push_back(id + 1);
+  }
+}
+
+void FeatureColumnsBuilder::Freeze(Writer & writer) const
+{
+  WriteToSink(writer, static_cast<uint8_t>(FeatureColumns::Version::Latest));
+  WriteToSink(writer, base::checked_cast<uint32_t>(m_types.size()));
+
+  std::vector<std::vector<uint32_t> const *> typesDictionary(m_typesDictionary.size());
+  for (auto const & [types, id] : m_typesDictionary)
+    typesDictionary[id] = &types;
+
+  WriteVarUint(writer, base::checked_cast<uint32_t>(typesDictionary.size()));
+  for (auto const * types : typesDictionary)
+  {
+    // Geometry type and classificator indexes of types.
+    WriteToSink(writer, static_cast<int8_t>(types->front()));
+    WriteToSink(writer, static_cast<uint8_t>(types->size() - 1));
+    for (size_t i = 1; i < types->size(); ++i)
+      WriteVarUint(writer, (*types)[i]);
+  }
+  PackedColumn::Write(writer, m_types);
+
+  WriteToSink(writer, m_coordBits);
+  auto const leftBottom = PointDToPointU(m_limitRect.LeftBottom(), kPointCoordBits);
+  WriteToSink(writer, leftBottom.x);
+  WriteToSink(writer, leftBottom.y);
+  auto const rightTop = PointDToPointU(m_limitRect.RightTop(), kPointCoordBits);
+  WriteToSink(writer, rightTop.x);
+  WriteToSink(writer, rightTop.y);
+  PackedColumn::Write(writer, m_x);
+  PackedColumn::Write(writer, m_y);
+
+  PackedColumn::Write(writer, m_ranks);
+
+  WriteToSink(writer, base::checked_cast<uint8_t>(m_metadata.size()));
+  for (auto const & [type, column] : m_metadata)
+  {
+    WriteToSink(writer, static_cast<int8_t>(type));
+
+    std::vector<std::string const *> dictionary(column.m_dictionary.size());
+    for (auto const & [s, id] : column.m_dictionary)
+      dictionary[id] = &s;
+
+    WriteVarUint(writer, base::checked_cast<uint32_t>(dictionary.size()));
+    for (auto const * s : dictionary)
+      WriteString(writer, *s);
+    PackedColumn::Write(writer, column.m_ids);
+  }
+}
+}  // namespace feature
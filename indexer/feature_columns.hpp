@@ -0,0 +1,135 @@
+#pragma once
+
+#include "indexer/feature_data.hpp"
+#include "indexer/feature_meta.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ArrayByteSource;
+class FilesContainerR;
+class Reader;
+class Writer;
+
+namespace feature
+{
+/// Values of the same bits width packed into 64-bit little-endian words.
+class PackedColumn
+{
+public:
+  PackedColumn() = default;
+  PackedColumn(uint8_t const * words, uint8_t bits) : m_words(words), m_bits(bits) {}
+
+  uint32_t Get(uint32_t i) const;
+
+  static void Write(Writer & writer, std::vector<uint32_t> const & values);
+  /// @return The column of |count| values at the source position and skips it.
+  static PackedColumn Read(ArrayByteSource & src, uint32_t count);
+
+private:
+  uint8_t const * m_words = nullptr;
+  uint8_t m_bits = 0;
+};
+
+struct FeatureColumnsQuery
+{
+  m2::RectD m_rect = m2::RectD::GetInfiniteRect();
+  /// Features with at least one type starting with any of |m_types|,
+  /// e.g. "amenity" matches "amenity-cafe". Empty means any type.
+  std::vector<uint32_t> m_types;
+  /// Features which have all of these metadata. Keys without a column match nothing.
+  std::vector<Metadata::EType> m_metadata;
+};
+
+/// Optional columnar copy of the most scanned feature attributes: types, centers, ranks and
+/// some metadata, keyed by feature index. Types and metadata values are dictionary coded,
+/// all columns are fixed-width, so scans and filters don't touch the features section.
+class FeatureColumns
+{
+public:
+  enum class Version : uint8_t
+  {
+    V0 = 0,
+    Latest = V0
+  };
+
+  /// Metadata which are written by default.
+  static std::vector<Metadata::EType> const & GetDefaultMetadata();
+
+  /// @return nullptr if the section doesn't exist or can't be loaded.
+  static std::unique_ptr<FeatureColumns> Load(FilesContainerR const & cont);
+  static std::unique_ptr<FeatureColumns> Load(Reader & reader);
+
+  uint32_t GetCount() const { return m_count; }
+
+  /// Types in the same order as FeatureType::ForEachType.
+  TypesHolder const & GetTypes(uint32_t index) const;
+  m2::PointD GetCenter(uint32_t index) const;
+  uint8_t GetRank(uint32_t index) const;
+
+  bool HasMetadata(Metadata::EType type) const { return m_metadata.count(type) != 0; }
+  /// @return Empty string if the feature hasn't the value or there is no such column.
+  std::string_view GetMetadata(uint32_t index, Metadata::EType type) const;
+
+  /// Calls |fn| with indexes of features matching |query| in increasing order.
+  void ForEach(FeatureColumnsQuery const & query, std::function<void(uint32_t)> const & fn) const;
+
+private:
+  struct StringColumn
+  {
+    std::vector<std::string_view> m_dictionary;
+    // Index in |m_dictionary| + 1, zero if there is no value.
+    PackedColumn m_ids;
+  };
+
+  bool Init();
+
+  std::vector<uint8_t> m_buffer;
+  uint32_t m_count = 0;
+
+  std::vector<TypesHolder> m_typesDictionary;
+  PackedColumn m_types;
+
+  m2::RectD m_limitRect;
+  uint8_t m_coordBits = 0;
+  PackedColumn m_x, m_y;
+
+  PackedColumn m_ranks;
+
+  std::map<Metadata::EType, StringColumn> m_metadata;
+};
+
+class FeatureColumnsBuilder
+{
+public:
+  FeatureColumnsBuilder(m2::RectD const & limitRect, std::vector<Metadata::EType> const & metadata);
+
+  /// Features should be put in increasing order of indexes without gaps.
+  void Put(uint32_t index, FeatureType & ft);
+  void Freeze(Writer & writer) const;
+
+private:
+  struct StringColumn
+  {
+    std::map<std::string, uint32_t> m_dictionary;
+    std::vector<uint32_t> m_ids;
+  };
+
+  m2::RectD m_limitRect;
+  uint8_t m_coordBits;
+
+  std::map<std::vector<uint32_t>, uint32_t> m_typesDictionary;
+  std::vector<uint32_t> m_types;
+  std::vector<uint32_t> m_x, m_y;
+  std::vector<uint32_t> m_ranks;
+  std::map<Metadata::EType, StringColumn> m_metadata;
+};
+}  // namespace feature
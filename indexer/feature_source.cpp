@@ -20,7 +20,8 @@ FeatureSource::FeatureSource(MwmSet::MwmHandle const & handle) : m_handle(handle
 
   auto const & value = *m_handle.GetValue();
   m_vector = std::make_unique<FeaturesVector>(value.m_cont, value.GetHeader(), value.m_table.get(),
-                                              value.m_metaDeserializer.get());
+                                              value.m_metaDeserializer.get(), &value.GetMappedFeatures(),
+                                              value.m_featuresBlocks.get());
 }
 
 size_t FeatureSource::GetNumFeatures() const
@@ -41,6 +42,17 @@ std::unique_ptr<FeatureType> FeatureSource::GetOriginalFeature(uint32_t index) c
   return ft;
 }
 
+void FeatureSource::ReadOriginalFeature(uint32_t index, std::function<void(FeatureType &)> const & fn) const
+{
+  ASSERT(m_handle.IsAlive(), ());
+  ASSERT(m_vector, ());
+  m_vector->ReadByIndex(index, [&](FeatureType & ft)
+  {
+    ft.SetID({ GetMwmId(), index });
+    fn(ft);
+  });
+}
+
 FeatureStatus FeatureSource::GetFeatureStatus(uint32_t index) const
 {
   return FeatureStatus::Untouched;
@@ -34,6 +34,8 @@ public:
   size_t GetNumFeatures() const;
 
   std::unique_ptr<FeatureType> GetOriginalFeature(uint32_t index) const;
+  /// Same as GetOriginalFeature, but doesn't allocate the feature, see FeaturesVector::ReadByIndex.
+  void ReadOriginalFeature(uint32_t index, std::function<void(FeatureType &)> const & fn) const;
 
   MwmSet::MwmId const & GetMwmId() const { return m_handle.GetId(); }
 
@@ -34,7 +34,7 @@ void GetDrawRule(TypesHolder const & types, int level, drule::KeysT & keys)
   auto const geomType = types.GetGeomType();
   level = CorrectScale(level);
   for (uint32_t t : types)
-    c.GetObject(t)->GetSuitable(level, geomType, keys);
+    c.GetSuitable(t, level, geomType, keys);
 }
 
 void GetDrawRule(vector<uint32_t> const & types, int level, GeomType geomType, drule::KeysT & keys)
@@ -44,7 +44,7 @@ void GetDrawRule(vector<uint32_t> const & types, int level, GeomType geomType, d
 
   level = CorrectScale(level);
   for (uint32_t t : types)
-    c.GetObject(t)->GetSuitable(level, geomType, keys);
+    c.GetSuitable(t, level, geomType, keys);
 }
 
 void FilterRulesByRuntimeSelector(FeatureType & f, int zoomLevel, drule::KeysT & keys)
@@ -76,10 +76,10 @@ namespace
       m_arr[3] = rules & RULE_LINE;
     }
 
-    bool operator() (ClassifObject const * p) const
+    bool operator() (uint32_t type) const
     {
       drule::KeysT keys;
-      p->GetSuitable(m_scale, m_geomType, keys);
+      classif().GetSuitable(type, m_scale, m_geomType, keys);
 
       for (auto const & k : keys)
       {
@@ -248,7 +248,7 @@ bool IsDrawableForIndexClassifOnly(TypesHolder const & types, int level)
   Classificator const & c = classif();
   for (uint32_t t : types)
   {
-    if (c.GetObject(t)->IsDrawable(level))
+    if (c.IsDrawable(t, level))
       return true;
 
     if (level == GetNondrawableStandaloneIndexScale(t))
@@ -410,12 +410,10 @@ namespace
 {
   bool IsDrawableForRules(TypesHolder const & types, int level, int rules)
   {
-    Classificator const & c = classif();
-
     IsDrawableRulesChecker doCheck(level, types.GetGeomType(), rules);
     for (uint32_t t : types)
     {
-      if (doCheck(c.GetObject(t)))
+      if (doCheck(t))
         return true;
     }
 
@@ -0,0 +1,186 @@
+#include "indexer/features_blocks.hpp"
+
+#include "coding/succinct_mapper.hpp"
+#include "coding/writer.hpp"
+#include "coding/zlib.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <iterator>
+
+namespace feature
+{
+namespace
+{
+template <class Cont>
+void LoadAndMap(uint64_t dataSize, ReaderSource<FilesContainerR::TReader> & src, Cont & cont,
+                std::unique_ptr<CopiedMemoryRegion> & region)
+{
+  std::vector<uint8_t> data(static_cast<size_t>(dataSize));
+  src.Read(data.data(), data.size());
+  region = std::make_unique<CopiedMemoryRegion>(std::move(data));
+  coding::MapVisitor visitor(region->ImmutableData());
+  cont.map(visitor);
+}
+
+std::vector<uint8_t> FreezeOffsets(std::vector<uint32_t> const & offsets)
+{
+  CHECK(!offsets.empty(), ());
+  succinct::elias_fano::elias_fano_builder builder(offsets.back() + 1, offsets.size());
+  for (auto const offset : offsets)
+    builder.push_back(offset);
+
+  std::vector<uint8_t> buffer;
+  MemWriter<std::vector<uint8_t>> writer(buffer);
+  coding::FreezeVisitor<decltype(writer)> visitor(writer);
+  succinct::elias_fano(&builder).map(visitor);
+  return buffer;
+}
+}  // namespace
+
+// static
+uint32_t const FeaturesBlocks::kDefaultBlockSize = 32 * 1024;
+
+// static
+std::unique_ptr<FeaturesBlocks> FeaturesBlocks::Load(FilesContainerR const & cont)
+{
+  if (!cont.IsExist(FEATURES_BLOCKS_FILE_TAG))
+    return {};
+  return Load(cont.GetReader(FEATURES_BLOCKS_FILE_TAG));
+}
+
+// static
+std::unique_ptr<FeaturesBlocks> FeaturesBlocks::Load(FilesContainerR::TReader const & reader)
+{
+  // Can't use make_unique with private constructor.
+  return std::unique_ptr<FeaturesBlocks>(new FeaturesBlocks(reader));
+}
+
+FeaturesBlocks::FeaturesBlocks(FilesContainerR::TReader const & reader) : m_reader(reader)
+{
+  ReaderSource<FilesContainerR::TReader> src(m_reader);
+  m_header.Deserialize(src);
+
+  src.Skip(m_header.m_startsOffset - src.Pos());
+  LoadAndMap(m_header.m_offsetsOffset - m_header.m_startsOffset, src, m_starts, m_startsRegion);
+  LoadAndMap(m_header.m_dataOffset - m_header.m_offsetsOffset, src, m_offsets, m_offsetsRegion);
+
+  CHECK_EQUAL(m_starts.num_ones(), m_header.m_blocksCount + 1, ());
+  CHECK_EQUAL(m_offsets.num_ones(), m_header.m_blocksCount + 1, ());
+}
+
+// static
+void FeaturesBlocks::Build(Reader const & records, Writer & writer, uint32_t blockSize)
+{
+  CHECK_GREATER(blockSize, 0, ());
+
+  std::vector<uint32_t> starts;
+  std::vector<uint32_t> offsets = {0};
+  std::vector<uint8_t> data;
+
+  coding::ZLib::Deflate const deflate(coding::ZLib::Deflate::Format::ZLib,
+                                      coding::ZLib::Deflate::Level::BestCompression);
+  std::vector<uint8_t> block;
+  auto const flush = [&]()
+  {
+    if (block.empty())
+      return;
+    CHECK(deflate(block.data(), block.size(), std::back_inserter(data)), ());
+    offsets.push_back(base::checked_cast<uint32_t>(data.size()));
+    block.clear();
+  };
+
+  // Blocks are split by records, so a record is always in one block.
+  NonOwningReaderSource src(records);
+  while (src.Size() > 0)
+  {
+    auto const offset = base::checked_cast<uint32_t>(src.Pos());
+    auto const size = ReadVarUint<uint32_t>(src);
+    if (block.empty())
+      starts.push_back(offset);
+
+    auto const recordSize = static_cast<size_t>(src.Pos() - offset) + size;
+    block.resize(block.size() + recordSize);
+    auto * dst = block.data() + block.size() - recordSize;
+    records.Read(offset, dst, recordSize);
+    src.Skip(size);
+
+    if (block.size() >= blockSize)
+      flush();
+  }
+  flush();
+
+  Header header;
+  header.m_recordsSize = base::checked_cast<uint32_t>(records.Size());
+  header.m_blocksCount = base::checked_cast<uint32_t>(starts.size());
+
+  // Empty elias-fano can't be built, so the starts are terminated by the records size.
+  starts.push_back(header.m_recordsSize);
+  auto const startsBuffer = FreezeOffsets(starts);
+  auto const offsetsBuffer = FreezeOffsets(offsets);
+
+  // Section writers can't seek, so all offsets are calculated before writing.
+  uint64_t headerSize = 0;
+  {
+    std::vector<uint8_t> buffer;
+    MemWriter<std::vector<uint8_t>> headerWriter(buffer);
+    header.Serialize(headerWriter);
+    headerSize = buffer.size() + coding::ToAlign8(buffer.size());
+  }
+  header.m_startsOffset = base::checked_cast<uint32_t>(headerSize);
+  header.m_offsetsOffset = base::checked_cast<uint32_t>(header.m_startsOffset + startsBuffer.size());
+  header.m_dataOffset = base::checked_cast<uint32_t>(header.m_offsetsOffset + offsetsBuffer.size());
+  header.m_endOffset = base::checked_cast<uint32_t>(header.m_dataOffset + data.size());
+
+  auto const startOffset = writer.Pos();
+  header.Serialize(writer);
+  uint64_t bytesWritten = writer.Pos() - startOffset;
+  coding::WritePadding(writer, bytesWritten);
+  writer.Write(startsBuffer.data(), startsBuffer.size());
+  writer.Write(offsetsBuffer.data(), offsetsBuffer.size());
+  writer.Write(data.data(), data.size());
+  CHECK_EQUAL(writer.Pos() - startOffset, header.m_endOffset, ());
+
+  LOG(LINFO, ("Features blocks:", header.m_blocksCount, "records size:", header.m_recordsSize,
+              "compressed size:", data.size()));
+}
+
+std::vector<uint8_t> FeaturesBlocks::ReadRecord(uint32_t offset) const
+{
+  ASSERT_LESS(offset, m_header.m_recordsSize, ());
+  // Index of the last block which starts not after |offset|.
+  auto const index = static_cast<uint32_t>(m_starts.rank(offset + 1) - 1);
+
+  bool found;
+  auto & block = m_cache.Find(index, found);
+  if (!found)
+  {
+    block.clear();
+    ReadBlock(index, block);
+  }
+
+  auto const pos = offset - static_cast<uint32_t>(m_starts.select(index));
+  ASSERT_LESS(pos, block.size(), ());
+  ArrayByteSource src(block.data() + pos);
+  auto const size = ReadVarUint<uint32_t>(src);
+  ASSERT_LESS_OR_EQUAL(src.PtrUint8() + size, block.data() + block.size(), ());
+  return {src.PtrUint8(), src.PtrUint8() + size};
+}
+
+void FeaturesBlocks::ReadBlock(uint32_t index, std::vector<uint8_t> & block) const
+{
+  ASSERT_LESS(index, m_header.m_blocksCount, ());
+  auto const begin = m_offsets.select(index);
+  auto const end = m_offsets.select(index + 1);
+
+  std::vector<uint8_t> compressed(static_cast<size_t>(end - begin));
+  m_reader.Read(m_header.m_dataOffset + begin, compressed.data(), compressed.size());
+
+  coding::ZLib::Inflate const inflate(coding::ZLib::Inflate::Format::ZLib);
+  CHECK(inflate(compressed.data(), compressed.size(), std::back_inserter(block)), (index));
+}
+}  // namespace feature
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "coding/byte_stream.hpp"
+#include "coding/files_container.hpp"
+#include "coding/memory_region.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/lru_cache.hpp"
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-private-field"
+#endif
+
+#include "3party/succinct/elias_fano.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+class Writer;
+
+namespace feature
+{
+/// Optional block compressed copy of the feature records of the features section.
+/// Records are grouped into blocks of about |blockSize| bytes which are compressed
+/// independently, so reading a record needs decompression of its block only.
+/// Records are addressed by the same offsets as in the features section (see FeaturesOffsetsTable).
+/// Note! This class is NOT Thread-Safe, as FeaturesVector. It is kept in MwmValue, which is used
+/// by one mwm handle at a time.
+class FeaturesBlocks
+{
+public:
+  enum class Version : uint8_t
+  {
+    V0 = 0,
+    Latest = V0
+  };
+
+  struct Header
+  {
+    template <typename Sink>
+    void Serialize(Sink & sink) const
+    {
+      CHECK_EQUAL(static_cast<uint8_t>(m_version), static_cast<uint8_t>(Version::V0), ());
+      WriteToSink(sink, static_cast<uint8_t>(m_version));
+      WriteToSink(sink, m_recordsSize);
+      WriteToSink(sink, m_blocksCount);
+      WriteToSink(sink, m_startsOffset);
+      WriteToSink(sink, m_offsetsOffset);
+      WriteToSink(sink, m_dataOffset);
+      WriteToSink(sink, m_endOffset);
+    }
+
+    template <typename Source>
+    void Deserialize(Source & src)
+    {
+      m_version = static_cast<Version>(ReadPrimitiveFromSource<uint8_t>(src));
+      CHECK_EQUAL(static_cast<uint8_t>(m_version), static_cast<uint8_t>(Version::V0), ());
+      m_recordsSize = ReadPrimitiveFromSource<uint32_t>(src);
+      m_blocksCount = ReadPrimitiveFromSource<uint32_t>(src);
+      m_startsOffset = ReadPrimitiveFromSource<uint32_t>(src);
+      m_offsetsOffset = ReadPrimitiveFromSource<uint32_t>(src);
+      m_dataOffset = ReadPrimitiveFromSource<uint32_t>(src);
+      m_endOffset = ReadPrimitiveFromSource<uint32_t>(src);
+    }
+
+    Version m_version = Version::Latest;
+    // Size of uncompressed records.
+    uint32_t m_recordsSize = 0;
+    uint32_t m_blocksCount = 0;
+    // All offsets are relative to the start of the section.
+    uint32_t m_startsOffset = 0;
+    uint32_t m_offsetsOffset = 0;
+    uint32_t m_dataOffset = 0;
+    uint32_t m_endOffset = 0;
+  };
+
+  static uint32_t const kDefaultBlockSize;
+
+  /// @return nullptr if the section doesn't exist.
+  static std::unique_ptr<FeaturesBlocks> Load(FilesContainerR const & cont);
+  static std::unique_ptr<FeaturesBlocks> Load(FilesContainerR::TReader const & reader);
+
+  /// Compresses |records| in the VarRecordReader format.
+  static void Build(Reader const & records, Writer & writer, uint32_t blockSize = kDefaultBlockSize);
+
+  uint32_t GetRecordsSize() const { return m_header.m_recordsSize; }
+  uint32_t GetBlocksCount() const { return m_header.m_blocksCount; }
+
+  std::vector<uint8_t> ReadRecord(uint32_t offset) const;
+
+  /// Calls |toDo(offset, data)| for all records in the order of offsets.
+  template <typename ToDo>
+  void ForEachRecord(ToDo && toDo) const
+  {
+    std::vector<uint8_t> block;
+    for (uint32_t i = 0; i < m_header.m_blocksCount; ++i)
+    {
+      block.clear();
+      ReadBlock(i, block);
+
+      auto const start = static_cast<uint32_t>(m_starts.select(i));
+      ArrayByteSource src(block.data());
+      while (src.PtrUint8() < block.data() + block.size())
+      {
+        auto const offset = start + static_cast<uint32_t>(src.PtrUint8() - block.data());
+        auto const size = ReadVarUint<uint32_t>(src);
+        std::vector<uint8_t> data(src.PtrUint8(), src.PtrUint8() + size);
+        src.Advance(size);
+        toDo(offset, std::move(data));
+      }
+    }
+  }
+
+private:
+  // Decompressed blocks which are kept for random access.
+  static size_t constexpr kCachedBlocks = 4;
+
+  explicit FeaturesBlocks(FilesContainerR::TReader const & reader);
+
+  void ReadBlock(uint32_t index, std::vector<uint8_t> & block) const;
+
+  FilesContainerR::TReader m_reader;
+  Header m_header;
+
+  // Offsets of the first records of blocks in the uncompressed records, the last one is the
+  // records size.
+  succinct::elias_fano m_starts;
+  std::unique_ptr<CopiedMemoryRegion> m_startsRegion;
+  // Offsets of blocks in the compressed data, the last one is the size of data.
+  succinct::elias_fano m_offsets;
+  std::unique_ptr<CopiedMemoryRegion> m_offsetsRegion;
+
+  mutable LruCache<uint32_t, std::vector<uint8_t>> m_cache{kCachedBlocks};
+
+  DISALLOW_COPY_AND_MOVE(FeaturesBlocks);
+};
+}  // namespace feature
@@ -5,31 +5,83 @@
 
 #include "platform/constants.hpp"
 
+#include "coding/byte_stream.hpp"
+#include "coding/varint.hpp"
+
 
 FeaturesVector::FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
                                feature::FeaturesOffsetsTable const * table,
-                               indexer::MetadataDeserializer * metaDeserializer)
+                               indexer::MetadataDeserializer * metaDeserializer,
+                               FilesMappingContainer::Handle const * mappedFeatures,
+                               feature::FeaturesBlocks const * blocks)
 : m_loadInfo(cont, header), m_table(table), m_metaDeserializer(metaDeserializer)
+, m_mappedFeatures(mappedFeatures)
 {
-  InitRecordsReader();
+  InitRecordsReader(cont, blocks);
 }
 
-void FeaturesVector::InitRecordsReader()
+void FeaturesVector::InitRecordsReader(FilesContainerR const & cont, feature::FeaturesBlocks const * blocks)
 {
   FilesContainerR::TReader reader = m_loadInfo.GetDataReader();
 
   feature::DatSectionHeader header;
   header.Read(*reader.GetPtr());
-  CHECK(header.m_version == feature::DatSectionHeader::Version::V0,
-          (base::Underlying(header.m_version)));
   m_recordReader = std::make_unique<RecordReader>(
         reader.SubReader(header.m_featuresOffset, header.m_featuresSize));
+
+  // Records are moved to the compressed section, the features section keeps the header only.
+  if (header.m_version == feature::DatSectionHeader::Version::V1)
+  {
+    CHECK_EQUAL(header.m_featuresSize, 0, ());
+    if (!blocks)
+    {
+      m_ownBlocks = feature::FeaturesBlocks::Load(cont);
+      blocks = m_ownBlocks.get();
+    }
+    CHECK(blocks, ("No", FEATURES_BLOCKS_FILE_TAG, "section in", cont.GetFileName()));
+    m_blocks = blocks;
+    return;
+  }
+
+  if (m_mappedFeatures && m_mappedFeatures->IsValid())
+  {
+    CHECK_LESS_OR_EQUAL(header.m_featuresOffset + header.m_featuresSize, m_mappedFeatures->GetSize(), ());
+    m_records = m_mappedFeatures->GetData<uint8_t>() + header.m_featuresOffset;
+    m_recordsSize = header.m_featuresSize;
+  }
+}
+
+uint32_t FeaturesVector::GetRecordOffset(uint32_t index) const
+{
+  return m_table ? m_table->GetFeatureOffset(index) : index;
+}
+
+std::vector<uint8_t> FeaturesVector::ReadRecord(uint32_t offset) const
+{
+  return m_blocks ? m_blocks->ReadRecord(offset) : m_recordReader->ReadRecord(offset);
+}
+
+uint8_t const * FeaturesVector::GetMappedRecord(uint32_t offset, uint32_t & size) const
+{
+  ASSERT_LESS(offset, m_recordsSize, ());
+  ArrayByteSource src(m_records + offset);
+  size = ReadVarUint<uint32_t>(src);
+  ASSERT_LESS_OR_EQUAL(offset + size, m_recordsSize, ());
+  return src.PtrUint8();
 }
 
 std::unique_ptr<FeatureType> FeaturesVector::GetByIndex(uint32_t index) const
 {
-  auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
-  return std::make_unique<FeatureType>(&m_loadInfo, m_recordReader->ReadRecord(ftOffset), m_metaDeserializer);
+  auto const ftOffset = GetRecordOffset(index);
+  if (m_records != nullptr)
+  {
+    // Copy the record: the mapping is released with the mwm value, but callers may keep the feature.
+    uint32_t size;
+    uint8_t const * data = GetMappedRecord(ftOffset, size);
+    return std::make_unique<FeatureType>(&m_loadInfo, std::vector<uint8_t>(data, data + size),
+                                         m_metaDeserializer);
+  }
+  return std::make_unique<FeatureType>(&m_loadInfo, ReadRecord(ftOffset), m_metaDeserializer);
 }
 
 size_t FeaturesVector::GetNumFeatures() const
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "indexer/feature.hpp"
+#include "indexer/features_blocks.hpp"
 #include "indexer/metadata_serdes.hpp"
 #include "indexer/shared_load_info.hpp"
 
@@ -19,18 +20,45 @@ class FeaturesVector
   DISALLOW_COPY(FeaturesVector);
 
 public:
+  /// @param[in] mappedFeatures Optional mapped features section, see MwmValue::GetMappedFeatures().
+  /// ReadByIndex doesn't copy feature records when it is set.
+  /// @param[in] blocks Optional compressed records of the mwm, see MwmValue::m_featuresBlocks.
+  /// The vector loads its own copy if the records are compressed and |blocks| is not set.
   FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
                  feature::FeaturesOffsetsTable const * table,
-                 indexer::MetadataDeserializer * metaDeserializer);
+                 indexer::MetadataDeserializer * metaDeserializer,
+                 FilesMappingContainer::Handle const * mappedFeatures = nullptr,
+                 feature::FeaturesBlocks const * blocks = nullptr);
 
+  /// The feature owns a copy of its record, so it may outlive the vector's mwm handle.
   std::unique_ptr<FeatureType> GetByIndex(uint32_t index) const;
 
+  /// Same as GetByIndex, but the feature lives on the stack during the |toDo| call only and may
+  /// point to the mapped section, so there are no heap allocations if the section is mapped.
+  /// The caller should hold the mwm handle during the call.
+  template <class ToDo> void ReadByIndex(uint32_t index, ToDo && toDo) const
+  {
+    auto const ftOffset = GetRecordOffset(index);
+    if (m_records != nullptr)
+    {
+      uint32_t size;
+      uint8_t const * data = GetMappedRecord(ftOffset, size);
+      FeatureType ft(&m_loadInfo, data, size, m_metaDeserializer);
+      toDo(ft);
+    }
+    else
+    {
+      FeatureType ft(&m_loadInfo, ReadRecord(ftOffset), m_metaDeserializer);
+      toDo(ft);
+    }
+  }
+
   size_t GetNumFeatures() const;
 
   template <class ToDo> void ForEach(ToDo && toDo) const
   {
     uint32_t index = 0;
-    m_recordReader->ForEachRecord([&](uint32_t pos, std::vector<uint8_t> && data)
+    ForEachRecord([&](uint32_t pos, std::vector<uint8_t> && data)
     {
       FeatureType ft(&m_loadInfo, std::move(data), m_metaDeserializer);
 
@@ -47,8 +75,7 @@ public:
   {
     feature::DataHeader header(cont);
     FeaturesVector vec(cont, header);
-    vec.m_recordReader->ForEachRecord(
-        [&](uint32_t pos, std::vector<uint8_t> && /* data */) { toDo(pos); });
+    vec.ForEachRecord([&](uint32_t pos, std::vector<uint8_t> && /* data */) { toDo(pos); });
   }
 
 private:
@@ -57,18 +84,40 @@ private:
   FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header)
     : m_loadInfo(cont, header)
   {
-    InitRecordsReader();
+    InitRecordsReader(cont, nullptr /* blocks */);
   }
 
-  void InitRecordsReader();
+  void InitRecordsReader(FilesContainerR const & cont, feature::FeaturesBlocks const * blocks);
+
+  std::vector<uint8_t> ReadRecord(uint32_t offset) const;
+
+  template <class ToDo> void ForEachRecord(ToDo && toDo) const
+  {
+    if (m_blocks)
+      m_blocks->ForEachRecord(toDo);
+    else
+      m_recordReader->ForEachRecord(toDo);
+  }
+
+  uint32_t GetRecordOffset(uint32_t index) const;
+  uint8_t const * GetMappedRecord(uint32_t offset, uint32_t & size) const;
 
   friend class FeaturesVectorTest;
   using RecordReader = VarRecordReader<FilesContainerR::TReader>;
 
   feature::SharedLoadInfo m_loadInfo;
   std::unique_ptr<RecordReader> m_recordReader;
+  // Compressed records, nullptr if the mwm has no FEATURES_BLOCKS_FILE_TAG section.
+  // Points to the mwm value's blocks, so decompressed blocks outlive the vector, or to |m_ownBlocks|.
+  feature::FeaturesBlocks const * m_blocks = nullptr;
+  std::unique_ptr<feature::FeaturesBlocks> m_ownBlocks;
   feature::FeaturesOffsetsTable const * m_table;
   indexer::MetadataDeserializer * m_metaDeserializer;
+
+  FilesMappingContainer::Handle const * m_mappedFeatures = nullptr;
+  // Feature records in |m_mappedFeatures|, nullptr if the section is not mapped.
+  uint8_t const * m_records = nullptr;
+  uint64_t m_recordsSize = 0;
 };
 
 /// Test features vector (reader) that combines all the needed data for stand-alone work.
@@ -174,6 +174,42 @@ bool BaseChecker::operator()(vector<uint32_t> const & types) const
   return false;
 }
 
+CompiledCheckers::CompiledCheckers(vector<BaseChecker const *> checkers) : m_checkers(move(checkers))
+{
+  CHECK_LESS_OR_EQUAL(m_checkers.size(), kMaxCheckers, ());
+  classif().ForEachTree([this](ClassifObject const *, uint32_t type) { m_masks[type] = Calc(type); });
+}
+
+CompiledCheckers::Mask CompiledCheckers::Calc(uint32_t type) const
+{
+  Mask mask = 0;
+  for (size_t i = 0; i < m_checkers.size(); ++i)
+  {
+    if (m_checkers[i]->IsMatched(type))
+      mask |= GetBit(i);
+  }
+  return mask;
+}
+
+CompiledCheckers::Mask CompiledCheckers::operator()(uint32_t type) const
+{
+  auto const it = m_masks.find(type);
+  return it != m_masks.end() ? it->second : Calc(type);
+}
+
+CompiledCheckers::Mask CompiledCheckers::operator()(feature::TypesHolder const & types) const
+{
+  Mask mask = 0;
+  for (uint32_t t : types)
+    mask |= (*this)(t);
+  return mask;
+}
+
+CompiledCheckers::Mask CompiledCheckers::operator()(FeatureType & ft) const
+{
+  return (*this)(feature::TypesHolder(ft));
+}
+
 IsPeakChecker::IsPeakChecker()
 {
   Classificator const & c = classif();
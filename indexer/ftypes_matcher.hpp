@@ -6,6 +6,9 @@
 #include "base/small_map.hpp"
 #include "base/stl_helpers.hpp"
 
+#include "3party/skarupke/flat_hash_map.hpp"
+
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <vector>
@@ -38,6 +41,32 @@ public:
   static uint32_t PrepareToMatch(uint32_t type, uint8_t level);
 };
 
+/// Answers of several checkers at once: bit i of a mask is set if the i-th checker matches.
+/// Masks are precomputed for all classificator types, so a feature is classified by one lookup
+/// per type instead of a search in every checker.
+/// @note Classificator should be loaded before construction.
+class CompiledCheckers
+{
+public:
+  using Mask = uint64_t;
+  static size_t constexpr kMaxCheckers = 64;
+
+  explicit CompiledCheckers(std::vector<BaseChecker const *> checkers);
+
+  static Mask GetBit(size_t i) { return Mask(1) << i; }
+
+  Mask operator()(uint32_t type) const;
+  /// @return Union of masks of all types.
+  Mask operator()(feature::TypesHolder const & types) const;
+  Mask operator()(FeatureType & ft) const;
+
+private:
+  Mask Calc(uint32_t type) const;
+
+  std::vector<BaseChecker const *> m_checkers;
+  ska::flat_hash_map<uint32_t, Mask> m_masks;
+};
+
 class IsPeakChecker : public BaseChecker
 {
   IsPeakChecker();
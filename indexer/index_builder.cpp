@@ -8,20 +8,36 @@
 
 namespace indexer
 {
-bool BuildIndexFromDataFile(std::string const & dataFile, std::string const & tmpFile)
+bool BuildIndexFromDataFile(std::string const & dataFile, std::string const & tmpFile,
+                            bool buildRTree)
 {
   try
   {
     std::string const idxFileName(tmpFile + GEOM_INDEX_TMP_EXT);
+    std::string const rtreeFileName(tmpFile + RTREE_INDEX_FILE_TAG + GEOM_INDEX_TMP_EXT);
     {
       FeaturesVectorTest features(dataFile);
       FileWriter writer(idxFileName);
 
-      BuildIndex(features.GetHeader(), features.GetVector(), writer, tmpFile);
+      if (buildRTree)
+      {
+        FileWriter rtreeWriter(rtreeFileName);
+        BuildIndexAndRTree(features.GetHeader(), features.GetVector(), writer, rtreeWriter);
+      }
+      else
+      {
+        BuildIndex(features.GetHeader(), features.GetVector(), writer, tmpFile);
+      }
     }
 
-    FilesContainerW(dataFile, FileWriter::OP_WRITE_EXISTING).Write(idxFileName, INDEX_FILE_TAG);
+    FilesContainerW cont(dataFile, FileWriter::OP_WRITE_EXISTING);
+    cont.Write(idxFileName, INDEX_FILE_TAG);
     FileWriter::DeleteFileX(idxFileName);
+    if (buildRTree)
+    {
+      cont.Write(rtreeFileName, RTREE_INDEX_FILE_TAG);
+      FileWriter::DeleteFileX(rtreeFileName);
+    }
   }
   catch (Reader::Exception const & e)
   {
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "indexer/data_header.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/packed_rtree.hpp"
 #include "indexer/scale_index_builder.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace indexer
 {
@@ -21,6 +26,54 @@ void BuildIndex(feature::DataHeader const & header, TFeaturesVector const & feat
     LOG(LINFO, ("Built scale index. Size =", indexSize));
   }
 
+  /// Builds the scale index to |writer| and the R-tree index (see RTreeIndex) to |rtreeWriter|.
+  /// Every feature is put to the R-tree of the same bucket as in the scale index.
+  template <class TFeaturesVector, typename TWriter>
+  void BuildIndexAndRTree(feature::DataHeader const & header, TFeaturesVector const & features,
+                          TWriter & writer, TWriter & rtreeWriter)
+  {
+    LOG(LINFO, ("Building scale index."));
+    uint32_t const bucketsCount = header.GetLastScale() + 1;
+    auto const cells = covering::CoverFeatures(header, features);
+    uint64_t indexSize;
+    {
+      SubWriter<TWriter> subWriter(writer);
+      covering::WriteScaleIndex(bucketsCount, cells, subWriter);
+      indexSize = subWriter.Size();
+    }
+    LOG(LINFO, ("Built scale index. Size =", indexSize));
+
+    LOG(LINFO, ("Building R-tree index."));
+    uint32_t constexpr kNoBucket = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> featureBuckets;
+    for (auto const & cell : cells)
+    {
+      auto const index = cell.GetCellFeaturePair().GetValue();
+      if (index >= featureBuckets.size())
+        featureBuckets.resize(index + 1, kNoBucket);
+      featureBuckets[index] = std::min(featureBuckets[index], cell.GetBucket());
+    }
+
+    std::vector<std::vector<PackedRTree::Item>> buckets(bucketsCount);
+    features.ForEach([&](FeatureType & ft, uint32_t index)
+    {
+      if (index < featureBuckets.size() && featureBuckets[index] != kNoBucket)
+      {
+        buckets[featureBuckets[index]].emplace_back(ft.GetLimitRect(FeatureType::BEST_GEOMETRY),
+                                                    index);
+      }
+    });
+
+    uint64_t rtreeSize;
+    {
+      SubWriter<TWriter> subWriter(rtreeWriter);
+      RTreeIndex::Serialize(buckets, subWriter);
+      rtreeSize = subWriter.Size();
+    }
+    LOG(LINFO, ("Built R-tree index. Size =", rtreeSize));
+  }
+
   // doesn't throw exceptions
-  bool BuildIndexFromDataFile(std::string const & dataFile, std::string const & tmpFile);
+  bool BuildIndexFromDataFile(std::string const & dataFile, std::string const & tmpFile,
+                              bool buildRTree = false);
 }  // namespace indexer
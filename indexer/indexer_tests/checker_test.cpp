@@ -173,4 +173,34 @@ UNIT_TEST(IsMotorwayJunctionChecker)
   TEST(!ftypes::IsMotorwayJunctionChecker::Instance()(GetStreetTypes()), ());
 }
 
+UNIT_TEST(CompiledCheckers)
+{
+  classificator::Load();
+  Classificator const & c = classif();
+
+  vector<ftypes::BaseChecker const *> const checkers = {
+      &ftypes::IsBuildingChecker::Instance(), &ftypes::IsStreetOrSquareChecker::Instance(),
+      &ftypes::IsLocalityChecker::Instance(), &ftypes::IsPoiChecker::Instance(),
+      &ftypes::IsWayChecker::Instance()};
+  ftypes::CompiledCheckers const compiled(checkers);
+
+  c.ForEachTree([&](ClassifObject const *, uint32_t type)
+  {
+    auto const mask = compiled(type);
+    for (size_t i = 0; i < checkers.size(); ++i)
+    {
+      bool const expected = checkers[i]->IsMatched(type);
+      TEST_EQUAL((mask & ftypes::CompiledCheckers::GetBit(i)) != 0, expected, (c.GetFullObjectName(type), i));
+    }
+  });
+
+  feature::TypesHolder types;
+  types.Add(c.GetTypeByPath({"building"}));
+  types.Add(c.GetTypeByPath({"highway", "residential"}));
+  // Building, street, POI (highway) and way.
+  using ftypes::CompiledCheckers;
+  TEST_EQUAL(compiled(types), CompiledCheckers::GetBit(0) | CompiledCheckers::GetBit(1) |
+                                  CompiledCheckers::GetBit(3) | CompiledCheckers::GetBit(4), ());
+}
+
 } // namespacce checker_test
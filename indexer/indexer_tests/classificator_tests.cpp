@@ -102,3 +102,37 @@ UNIT_CLASS_TEST(TestWithClassificator, Classificator_StableIndex)
   TEST_NOT_EQUAL(type, c.GetTypeForIndex(356 - 1), ()); // Restored underground-fee
   TEST_EQUAL(type, c.GetTypeForIndex(357 - 1), ());
 }
+
+UNIT_CLASS_TEST(TestWithClassificator, Classificator_CompiledTypes)
+{
+  Classificator const & c = classif();
+
+  vector<pair<ClassifObject const *, uint32_t>> objects;
+  c.ForEachTree([&](ClassifObject const * p, uint32_t type) { objects.emplace_back(p, type); });
+  TEST(!objects.empty(), ());
+
+  size_t drawable = 0;
+  for (auto const & [p, type] : objects)
+  {
+    TEST_EQUAL(c.GetObject(type), p, (type));
+    for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+    {
+      TEST_EQUAL(c.IsDrawable(type, scale), p->IsDrawable(scale), (type, scale));
+      if (c.IsDrawable(type, scale))
+        ++drawable;
+
+      for (auto const geomType : {feature::GeomType::Point, feature::GeomType::Line, feature::GeomType::Area})
+      {
+        drule::KeysT expected;
+        p->GetSuitable(scale, geomType, expected);
+        drule::KeysT actual;
+        c.GetSuitable(type, scale, geomType, actual);
+        TEST(equal(expected.begin(), expected.end(), actual.begin(), actual.end()), (type, scale));
+      }
+    }
+  }
+  TEST_GREATER(drawable, 0, ());
+
+  // Invalid type paths are not compiled.
+  TEST(!c.GetObject(ftype::GetEmptyValue()), ());
+}
@@ -3,6 +3,7 @@
 #include "indexer/data_header.hpp"
 #include "indexer/data_source.hpp"
 #include "indexer/feature_source.hpp"
+#include "indexer/index_builder.hpp"
 #include "indexer/mwm_set.hpp"
 
 #include "coding/internal/file_data.hpp"
@@ -17,7 +18,11 @@
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 
+#include "defines.hpp"
+
 #include <algorithm>
+#include <mutex>
+#include <set>
 #include <string>
 
 namespace data_source_test
@@ -87,6 +92,89 @@ UNIT_CLASS_TEST(DataSourceTest, Parse)
   m_dataSource.ForEachInScale([](FeatureType &) { return; }, 15);
 }
 
+UNIT_CLASS_TEST(DataSourceTest, ForEachParallel)
+{
+  UNUSED_VALUE(m_dataSource.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass")));
+
+  size_t constexpr kThreadsCount = 4;
+  std::vector<std::shared_ptr<MwmInfo>> infos;
+  m_dataSource.GetMwmsInfo(infos);
+  TEST_EQUAL(infos.size(), 1, ());
+
+  m2::RectD rect(infos.front()->m_bordersRect.Center(), infos.front()->m_bordersRect.Center());
+  rect.Inflate(0.01, 0.01);
+
+  for (int const scale : {10, 15, 17})
+  {
+    std::set<FeatureID> expected;
+    m_dataSource.ForEachInScale([&](FeatureType & ft) { TEST(expected.insert(ft.GetID()).second, ()); },
+                                scale);
+
+    std::mutex mutex;
+    std::set<FeatureID> actual;
+    m_dataSource.ForEachInScaleParallel([&](FeatureType & ft, size_t threadIndex)
+    {
+      TEST_LESS(threadIndex, kThreadsCount, ());
+      std::lock_guard lock(mutex);
+      TEST(actual.insert(ft.GetID()).second, (ft.GetID()));
+    }, scale, kThreadsCount);
+    TEST_EQUAL(actual, expected, (scale));
+
+    expected.clear();
+    actual.clear();
+    m_dataSource.ForEachInRect([&](FeatureType & ft) { TEST(expected.insert(ft.GetID()).second, ()); },
+                               rect, scale);
+    m_dataSource.ForEachInRectParallel([&](FeatureType & ft, size_t)
+    {
+      std::lock_guard lock(mutex);
+      TEST(actual.insert(ft.GetID()).second, (ft.GetID()));
+    }, rect, scale, kThreadsCount);
+    TEST_EQUAL(actual, expected, (scale));
+  }
+}
+
+UNIT_CLASS_TEST(DataSourceTest, ForEachInRectParallel_RTree)
+{
+  std::string const mapsDir = GetPlatform().WritableDir();
+  CountryFile const country("minsk-pass-rtree");
+  LocalCountryFile const file(mapsDir, country, 0 /* version */);
+  std::string const path = file.GetPath(MapFileType::Map);
+  TEST(base::CopyFileX(base::JoinPath(mapsDir, "minsk-pass" DATA_FILE_EXTENSION), path), ());
+  SCOPE_GUARD(deleteFile, [&path] { base::DeleteFileX(path); });
+  TEST(indexer::BuildIndexFromDataFile(path, path, true /* buildRTree */), ());
+
+  auto const result = m_dataSource.RegisterMap(file);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+  SCOPE_GUARD(deregister, [&] { m_dataSource.DeregisterMap(country); });
+  {
+    auto const handle = m_dataSource.GetMwmHandleById(result.first);
+    TEST(handle.GetValue()->GetRTree(), ());
+  }
+
+  auto const center = result.first.GetInfo()->m_bordersRect.Center();
+  for (double const size : {0.001, 0.01, 0.1})
+  {
+    m2::RectD rect(center, center);
+    rect.Inflate(size, size);
+    for (int const scale : {10, 15, 17})
+    {
+      std::set<FeatureID> expected;
+      m_dataSource.ForEachInRect([&](FeatureType & ft) { TEST(expected.insert(ft.GetID()).second, ()); },
+                                 rect, scale);
+
+      // Every thread reads several parts of the R-tree.
+      std::mutex mutex;
+      std::set<FeatureID> actual;
+      m_dataSource.ForEachInRectParallel([&](FeatureType & ft, size_t)
+      {
+        std::lock_guard lock(mutex);
+        TEST(actual.insert(ft.GetID()).second, (ft.GetID()));
+      }, rect, scale, 4 /* threadsCount */);
+      TEST_EQUAL(actual, expected, (size, scale));
+    }
+  }
+}
+
 UNIT_CLASS_TEST(DataSourceTest, StatusNotifications)
 {
   std::string const mapsDir = GetPlatform().WritableDir();
@@ -0,0 +1,119 @@
+#include "testing/testing.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_header.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/feature_columns.hpp"
+#include "indexer/features_vector.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/file_name_utils.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace feature_columns_test
+{
+using namespace feature;
+using std::string, std::vector;
+
+UNIT_TEST(PackedColumn_Smoke)
+{
+  for (uint32_t const maxValue : {0U, 1U, 5U, 1000U, 0xFFFFFFFFU})
+  {
+    vector<uint32_t> values;
+    for (uint32_t i = 0; i < 200; ++i)
+      values.push_back(maxValue == 0 ? 0 : (i * 2654435761U) % maxValue);
+    values.push_back(maxValue);
+
+    vector<uint8_t> buffer;
+    {
+      MemWriter<vector<uint8_t>> writer(buffer);
+      PackedColumn::Write(writer, values);
+    }
+
+    ArrayByteSource src(buffer.data());
+    auto const column = PackedColumn::Read(src, static_cast<uint32_t>(values.size()));
+    TEST_EQUAL(src.PtrUint8(), buffer.data() + buffer.size(), (maxValue));
+
+    for (uint32_t i = 0; i < values.size(); ++i)
+      TEST_EQUAL(column.Get(i), values[i], (maxValue, i));
+  }
+}
+
+struct FeatureColumnsTest
+{
+  FeatureColumnsTest() { classificator::Load(); }
+};
+
+UNIT_CLASS_TEST(FeatureColumnsTest, Smoke)
+{
+  string const kMap = base::JoinPath(GetPlatform().WritableDir(), "minsk-pass.mwm");
+  FeaturesVectorTest fv(kMap);
+
+  vector<uint8_t> buffer;
+  {
+    FeatureColumnsBuilder builder(fv.GetHeader().GetBounds(), FeatureColumns::GetDefaultMetadata());
+    fv.GetVector().ForEach([&](FeatureType & ft, uint32_t index) { builder.Put(index, ft); });
+
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto const columns = FeatureColumns::Load(reader);
+  TEST(columns, ());
+  TEST_EQUAL(columns->GetCount(), fv.GetVector().GetNumFeatures(), ());
+  TEST(columns->HasMetadata(Metadata::FMD_POSTCODE), ());
+  TEST(!columns->HasMetadata(Metadata::FMD_PHONE_NUMBER), ());
+
+  uint32_t const cafe = classif().GetTypeByPath({"amenity", "cafe"});
+  uint32_t const amenity = classif().GetTypeByPath({"amenity"});
+  m2::RectD const rect = mercator::RectByCenterXYAndSizeInMeters(fv.GetHeader().GetBounds().Center(), 2000);
+
+  FeatureColumnsQuery query;
+  query.m_rect = rect;
+  query.m_types = {amenity};
+  query.m_metadata = {Metadata::FMD_OPEN_HOURS};
+
+  vector<uint32_t> expected;
+  fv.GetVector().ForEach([&](FeatureType & ft, uint32_t index)
+  {
+    TypesHolder const types(ft);
+    TypesHolder const & actualTypes = columns->GetTypes(index);
+    TEST_EQUAL(vector<uint32_t>(types.begin(), types.end()),
+               vector<uint32_t>(actualTypes.begin(), actualTypes.end()), (index));
+    TEST_EQUAL(types.GetGeomType(), actualTypes.GetGeomType(), (index));
+
+    auto const center = GetCenter(ft);
+    TEST_LESS_OR_EQUAL(mercator::DistanceOnEarth(center, columns->GetCenter(index)), 1.0, (index));
+    TEST_EQUAL(ft.GetRank(), columns->GetRank(index), (index));
+    for (auto const type : FeatureColumns::GetDefaultMetadata())
+      TEST_EQUAL(ft.GetMetadata(type), columns->GetMetadata(index, type), (index, type));
+
+    if (types.HasWithSubclass(amenity) && rect.IsPointInside(columns->GetCenter(index)) &&
+        ft.HasMetadata(Metadata::FMD_OPEN_HOURS))
+    {
+      expected.push_back(index);
+    }
+  });
+
+  vector<uint32_t> actual;
+  columns->ForEach(query, [&](uint32_t index) { actual.push_back(index); });
+  TEST_EQUAL(actual, expected, ());
+
+  query = {};
+  query.m_types = {cafe};
+  query.m_metadata = {Metadata::FMD_PHONE_NUMBER};
+  columns->ForEach(query, [](uint32_t index) { TEST(false, (index)); });
+}
+}  // namespace feature_columns_test
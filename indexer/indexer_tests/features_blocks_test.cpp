@@ -0,0 +1,191 @@
+#include "testing/testing.hpp"
+
+#include "indexer/dat_section_header.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/features_blocks.hpp"
+#include "indexer/scales.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/var_record_reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/checked_cast.hpp"
+#include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+#include "base/scope_guard.hpp"
+#include "base/timer.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace features_blocks_test
+{
+using namespace feature;
+using std::string, std::vector;
+
+UNIT_TEST(FeaturesBlocks_Smoke)
+{
+  string const kMap = base::JoinPath(GetPlatform().WritableDir(), "minsk-pass.mwm");
+  string const kBlocksFile = base::JoinPath(GetPlatform().WritableDir(), "features_blocks_test.tmp");
+  SCOPE_GUARD(removeBlocksFile, [&]() { FileWriter::DeleteFileX(kBlocksFile); });
+
+  FilesContainerR const cont(kMap);
+  auto const reader = cont.GetReader(FEATURES_FILE_TAG);
+  DatSectionHeader header;
+  header.Read(*reader.GetPtr());
+  auto const records = reader.SubReader(header.m_featuresOffset, header.m_featuresSize);
+
+  vector<std::pair<uint32_t, vector<uint8_t>>> expected;
+  VarRecordReader<FilesContainerR::TReader>(records).ForEachRecord(
+      [&](uint32_t offset, vector<uint8_t> && data) { expected.emplace_back(offset, std::move(data)); });
+  TEST(!expected.empty(), ());
+
+  for (uint32_t const blockSize : {1U, 4U * 1024, FeaturesBlocks::kDefaultBlockSize})
+  {
+    {
+      FilesContainerW wcont(kBlocksFile);
+      auto writer = wcont.GetWriter(FEATURES_BLOCKS_FILE_TAG);
+      FeaturesBlocks::Build(*records.GetPtr(), *writer, blockSize);
+    }
+
+    FilesContainerR const blocksCont(kBlocksFile);
+    auto const blocks = FeaturesBlocks::Load(blocksCont);
+    TEST(blocks, ());
+    TEST_EQUAL(blocks->GetRecordsSize(), header.m_featuresSize, ());
+    if (blockSize == 1)
+      TEST_EQUAL(blocks->GetBlocksCount(), expected.size(), ());
+
+    base::Timer timer;
+    size_t i = 0;
+    blocks->ForEachRecord([&](uint32_t offset, vector<uint8_t> && data)
+    {
+      TEST_LESS(i, expected.size(), ());
+      TEST_EQUAL(offset, expected[i].first, (i));
+      TEST(data == expected[i].second, (i));
+      ++i;
+    });
+    TEST_EQUAL(i, expected.size(), ());
+    auto const sequentialTime = timer.ElapsedSeconds();
+
+    // Nearby records are usually read together, so shuffle within windows of records.
+    vector<size_t> order(expected.size());
+    for (i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::mt19937 rng(0);
+    for (i = 0; i < order.size(); i += 256)
+      std::shuffle(order.begin() + i, order.begin() + std::min(i + 256, order.size()), rng);
+
+    timer.Reset();
+    for (auto const j : order)
+      TEST(blocks->ReadRecord(expected[j].first) == expected[j].second, (j));
+    auto const randomTime = timer.ElapsedSeconds();
+
+    LOG(LINFO, ("Block size:", blockSize, "blocks:", blocks->GetBlocksCount(),
+                "records size:", header.m_featuresSize,
+                "section size:", blocksCont.GetReader(FEATURES_BLOCKS_FILE_TAG).Size(),
+                "sequential read:", sequentialTime, "random read:", randomTime));
+  }
+}
+
+// Same as the generator's compression pass.
+void CompressFeatures(string const & fileName)
+{
+  vector<uint8_t> features;
+  vector<uint8_t> blocks;
+  {
+    FilesContainerR const cont(fileName);
+    auto const reader = cont.GetReader(FEATURES_FILE_TAG);
+    DatSectionHeader header;
+    header.Read(*reader.GetPtr());
+
+    MemWriter<vector<uint8_t>> blocksWriter(blocks);
+    FeaturesBlocks::Build(*reader.SubReader(header.m_featuresOffset, header.m_featuresSize).GetPtr(),
+                          blocksWriter);
+
+    MemWriter<vector<uint8_t>> writer(features);
+    header.m_version = DatSectionHeader::Version::V1;
+    header.m_featuresSize = 0;
+    header.Serialize(writer);
+    header.m_featuresOffset = base::checked_cast<uint32_t>(writer.Pos());
+    writer.Seek(0);
+    header.Serialize(writer);
+  }
+
+  FilesContainerW cont(fileName, FileWriter::OP_WRITE_EXISTING);
+  cont.Write(features, FEATURES_FILE_TAG);
+  cont.Write(blocks, FEATURES_BLOCKS_FILE_TAG);
+}
+
+UNIT_TEST(FeaturesBlocks_ForEachInRect)
+{
+  string const kCompressedName = "features_blocks_test_minsk";
+  string const kCompressedFile =
+      base::JoinPath(GetPlatform().WritableDir(), kCompressedName + DATA_FILE_EXTENSION);
+  SCOPE_GUARD(removeCompressedFile, [&]() { FileWriter::DeleteFileX(kCompressedFile); });
+
+  TEST(base::CopyFileX(base::JoinPath(GetPlatform().WritableDir(), "minsk-pass" DATA_FILE_EXTENSION),
+                       kCompressedFile), ());
+  CompressFeatures(kCompressedFile);
+
+  using Features = vector<std::pair<uint32_t, m2::RectD>>;
+  auto const readFeatures = [](string const & countryName)
+  {
+    FrozenDataSource dataSource;
+    auto const res = dataSource.RegisterMap(platform::LocalCountryFile::MakeForTesting(countryName));
+    TEST_EQUAL(res.second, MwmSet::RegResult::Success, ());
+
+    // Viewport-like queries over the mwm, the second pass goes through the already cached values.
+    int const scale = scales::GetUpperScale();
+    auto const bounds = res.first.GetInfo()->m_bordersRect;
+    auto const stepX = bounds.SizeX() / 4;
+    auto const stepY = bounds.SizeY() / 4;
+
+    Features features;
+    vector<double> times;
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+      features.clear();
+      base::Timer timer;
+      for (size_t i = 0; i < 4; ++i)
+      {
+        for (size_t j = 0; j < 4; ++j)
+        {
+          m2::RectD const rect(bounds.minX() + i * stepX, bounds.minY() + j * stepY,
+                               bounds.minX() + (i + 1) * stepX, bounds.minY() + (j + 1) * stepY);
+          dataSource.ForEachInRect([&](FeatureType & ft)
+          {
+            features.emplace_back(ft.GetID().m_index, ft.GetLimitRect(scale));
+          }, rect, scale);
+        }
+      }
+      times.push_back(timer.ElapsedSeconds());
+    }
+    LOG(LINFO, (countryName, "features:", features.size(), "first pass:", times[0], "second pass:", times[1]));
+
+    std::sort(features.begin(), features.end(), [](auto const & lhs, auto const & rhs)
+    {
+      return lhs.first < rhs.first;
+    });
+    return features;
+  };
+
+  auto const expected = readFeatures("minsk-pass");
+  auto const actual = readFeatures(kCompressedName);
+  TEST(!expected.empty(), ());
+  TEST_EQUAL(actual.size(), expected.size(), ());
+  for (size_t i = 0; i < actual.size(); ++i)
+  {
+    TEST_EQUAL(actual[i].first, expected[i].first, (i));
+    TEST(actual[i].second == expected[i].second, (i));
+  }
+}
+}  // namespace features_blocks_test
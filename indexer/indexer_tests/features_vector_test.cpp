@@ -7,6 +7,7 @@
 #include "platform/local_country_file.hpp"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -76,4 +77,62 @@ UNIT_TEST(FeaturesVectorTest_ParseMetadata)
   });
   TEST_EQUAL(expected, actual, ());
 }
+
+UNIT_TEST(FeaturesVectorTest_MappedFeatures)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto result = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  MwmSet::MwmHandle handle = dataSource.GetMwmHandleById(result.first);
+  TEST(handle.IsAlive(), ());
+
+  auto const * value = handle.GetValue();
+  TEST(value->GetMappedFeatures().IsValid(), ());
+
+  FeaturesVector copied(value->m_cont, value->GetHeader(), value->m_table.get(),
+                        value->m_metaDeserializer.get());
+  FeaturesVector mapped(value->m_cont, value->GetHeader(), value->m_table.get(),
+                        value->m_metaDeserializer.get(), &value->GetMappedFeatures());
+  TEST_EQUAL(copied.GetNumFeatures(), mapped.GetNumFeatures(), ());
+
+  for (uint32_t i = 0; i < copied.GetNumFeatures(); ++i)
+  {
+    auto expected = copied.GetByIndex(i);
+    mapped.ReadByIndex(i, [&](FeatureType & ft)
+    {
+      TEST_EQUAL(expected->DebugString(), ft.DebugString(), (i));
+      TEST_EQUAL(expected->GetMetadata(feature::Metadata::FMD_POSTCODE),
+                 ft.GetMetadata(feature::Metadata::FMD_POSTCODE), (i));
+    });
+  }
+}
+
+UNIT_TEST(FeaturesVectorTest_FeatureOutlivesHandle)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto result = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  std::vector<std::unique_ptr<FeatureType>> features;
+  std::vector<StringUtf8Multilang> expectedNames;
+  {
+    FeaturesLoaderGuard guard(dataSource, result.first);
+    TEST(guard.GetHandle().GetValue()->GetMappedFeatures().IsValid(), ());
+    for (uint32_t i = 0; i < guard.GetNumFeatures(); ++i)
+    {
+      expectedNames.push_back(guard.GetFeatureByIndex(i)->GetNames());
+      features.push_back(guard.GetFeatureByIndex(i));
+    }
+  }
+
+  // Values with their mapped sections are destroyed, but features own copies of their records.
+  dataSource.ClearCache();
+  for (size_t i = 0; i < features.size(); ++i)
+    TEST_EQUAL(features[i]->GetNames(), expectedNames[i], (i));
+}
 } // namespace features_vector_test
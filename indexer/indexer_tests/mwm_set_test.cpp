@@ -5,10 +5,16 @@
 #include "indexer/indexer_tests/test_mwm_set.hpp"
 #include "indexer/mwm_set.hpp"
 
+#include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/timer.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <initializer_list>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace mwm_set_test
 {
@@ -169,4 +175,110 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+UNIT_TEST(MwmSetIdleValuesLimitTest)
+{
+  class CountingMwmSet : public TestMwmSet
+  {
+  public:
+    explicit CountingMwmSet(size_t cacheSize) : TestMwmSet(cacheSize) {}
+
+    size_t m_valuesCount = 0;
+
+  protected:
+    unique_ptr<MwmValue> CreateValue(MwmInfo & info) const override
+    {
+      ++const_cast<CountingMwmSet *>(this)->m_valuesCount;
+      return TestMwmSet::CreateValue(info);
+    }
+  };
+
+  ScopedMwm mwm0("0.mwm");
+  ScopedMwm mwm1("1.mwm");
+  ScopedMwm mwm2("2.mwm");
+  ScopedMwm mwm3("3.mwm");
+  CountingMwmSet mwmSet(2 /* cacheSize */);
+
+  vector<MwmSet::MwmId> ids;
+  for (auto const name : {"0", "1", "2", "3"})
+    ids.push_back(mwmSet.Register(LocalCountryFile::MakeForTesting(name)).first);
+
+  for (auto const & id : ids)
+    TEST(mwmSet.GetMwmHandleById(id).IsAlive(), (id));
+  TEST_EQUAL(mwmSet.m_valuesCount, 4, ());
+
+  // Only two idle values are kept, in the pools of the first two mwms.
+  for (auto const & id : ids)
+    TEST(mwmSet.GetMwmHandleById(id).IsAlive(), (id));
+  TEST_EQUAL(mwmSet.m_valuesCount, 6, ());
+}
+
+UNIT_TEST(MwmSetConcurrentHandlesTest)
+{
+  ScopedMwm mwm0("0.mwm");
+  ScopedMwm mwm1("1.mwm");
+  TestMwmSet mwmSet;
+
+  vector<MwmSet::MwmId> ids;
+  for (auto const name : {"0", "1"})
+  {
+    auto const p = mwmSet.Register(LocalCountryFile::MakeForTesting(name));
+    TEST_EQUAL(MwmSet::RegResult::Success, p.second, (name));
+    ids.push_back(p.first);
+  }
+
+  size_t const threadsCount = max(4U, thread::hardware_concurrency());
+  size_t constexpr kHandlesPerThread = 10000;
+
+  // Contention benchmark: every thread takes and releases handles of the same mwms.
+  {
+    atomic<size_t> notAlive = 0;
+    base::Timer timer;
+    vector<thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+      threads.emplace_back([&, i]()
+      {
+        for (size_t j = 0; j < kHandlesPerThread; ++j)
+        {
+          auto const handle = mwmSet.GetMwmHandleById(ids[(i + j) % ids.size()]);
+          if (!handle.IsAlive())
+            ++notAlive;
+        }
+      });
+    }
+    for (auto & thread : threads)
+      thread.join();
+
+    LOG(LINFO, ("Threads:", threadsCount, "handles:", threadsCount * kHandlesPerThread,
+                "time:", timer.ElapsedSeconds()));
+    TEST_EQUAL(notAlive, 0, ());
+    for (auto const & id : ids)
+      TEST_EQUAL(id.GetInfo()->GetNumRefs(), 0, (id));
+  }
+
+  // Mwm is deregistered at the latest when the last handle is released.
+  {
+    atomic<bool> stop = false;
+    vector<thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+      threads.emplace_back([&]()
+      {
+        while (!stop)
+          UNUSED_VALUE(mwmSet.GetMwmHandleById(ids[0]));
+      });
+    }
+
+    mwmSet.Deregister(CountryFile("0"));
+    stop = true;
+    for (auto & thread : threads)
+      thread.join();
+
+    TEST_EQUAL(MwmInfo::STATUS_DEREGISTERED, ids[0].GetInfo()->GetStatus(), ());
+    TEST_EQUAL(ids[0].GetInfo()->GetNumRefs(), 0, ());
+    TEST(!mwmSet.GetMwmHandleById(ids[0]).IsAlive(), ());
+    TEST(mwmSet.GetMwmHandleById(ids[1]).IsAlive(), ());
+  }
+}
 }  // namespace mwm_set_test
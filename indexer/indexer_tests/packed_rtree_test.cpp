@@ -0,0 +1,167 @@
+#include "testing/testing.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_factory.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_covering.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/index_builder.hpp"
+#include "indexer/packed_rtree.hpp"
+#include "indexer/scale_index.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace packed_rtree_test
+{
+using namespace indexer;
+using std::set, std::vector;
+
+// Boxes are quantized, so results may contain items near the rect border.
+double constexpr kEps = 1e-5;
+
+UNIT_TEST(PackedRTree_Random)
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> coord(-50.0, 50.0);
+  std::uniform_real_distribution<double> size(0.0, 2.0);
+
+  for (uint32_t const count : {0U, 1U, 15U, 16U, 17U, 1000U})
+  {
+    vector<PackedRTree::Item> items;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      m2::PointD const p(coord(rng), coord(rng));
+      items.emplace_back(m2::RectD(p, p + m2::PointD(size(rng), size(rng))), i * 3);
+    }
+
+    vector<uint8_t> buffer;
+    {
+      MemWriter<vector<uint8_t>> writer(buffer);
+      PackedRTree::Serialize(items, writer);
+    }
+    PackedRTree const tree(buffer.data(), buffer.size());
+    TEST_EQUAL(tree.GetSize(), count, ());
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+      m2::PointD const p(coord(rng), coord(rng));
+      m2::RectD const rect(p, p + m2::PointD(10 * size(rng), 10 * size(rng)));
+
+      set<uint32_t> actual;
+      tree.ForEachInRect(rect, [&](uint32_t value) { TEST(actual.insert(value).second, (value)); });
+
+      m2::RectD inflated = rect;
+      inflated.Inflate(kEps, kEps);
+      for (auto const & [itemRect, value] : items)
+      {
+        if (itemRect.IsIntersect(rect))
+          TEST(actual.count(value) != 0, (count, value, itemRect, rect));
+        else if (!itemRect.IsIntersect(inflated))
+          TEST(actual.count(value) == 0, (count, value, itemRect, rect));
+      }
+
+      // Leaves ranges split the result without intersections.
+      for (uint32_t const partsCount : {2U, 3U, 7U})
+      {
+        set<uint32_t> parts;
+        for (uint32_t part = 0; part < partsCount; ++part)
+        {
+          tree.ForEachInRect(rect, count * part / partsCount, count * (part + 1) / partsCount,
+                             [&](uint32_t value) { TEST(parts.insert(value).second, (value, part)); });
+        }
+        TEST_EQUAL(parts, actual, (count, partsCount));
+      }
+    }
+  }
+}
+
+UNIT_TEST(RTreeIndex_MinskPass)
+{
+  classificator::Load();
+
+  FilesContainerR const cont(GetPlatform().GetReader("minsk-pass" DATA_FILE_EXTENSION));
+  FeaturesVectorTest features(cont);
+  auto const & header = features.GetHeader();
+
+  vector<uint8_t> indexBuffer;
+  vector<uint8_t> rtreeBuffer;
+  {
+    MemWriter<vector<uint8_t>> writer(indexBuffer);
+    MemWriter<vector<uint8_t>> rtreeWriter(rtreeBuffer);
+    BuildIndexAndRTree(header, features.GetVector(), writer, rtreeWriter);
+  }
+
+  IndexFactory factory;
+  factory.Load(cont);
+  ScaleIndex<MemReader> const index(MemReader(indexBuffer.data(), indexBuffer.size()), factory);
+  auto const rtree = RTreeIndex::Load(std::move(rtreeBuffer));
+
+  vector<m2::RectD> limitRects;
+  features.GetVector().ForEach([&](FeatureType & ft, uint32_t index)
+  {
+    if (index >= limitRects.size())
+      limitRects.resize(index + 1);
+    limitRects[index] = ft.GetLimitRect(FeatureType::BEST_GEOMETRY);
+  });
+
+  auto const center = header.GetBounds().Center();
+  // Viewport-sized and city-sized rects.
+  for (double const radiusM : {1000.0, 10000.0})
+  {
+    auto const rect = mercator::RectByCenterXYAndSizeInMeters(center, radiusM);
+    for (int const scale : {14, 17})
+    {
+      base::Timer timer;
+      set<uint32_t> covered;
+      covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
+      for (auto const & interval : cov.Get<RectId::DEPTH_LEVELS>(header.GetLastScale()))
+      {
+        index.ForEachInIntervalAndScale(interval.first, interval.second, scale,
+                                        [&](uint64_t /* key */, uint32_t value) { covered.insert(value); });
+      }
+      auto const coveringTime = timer.ElapsedSeconds();
+
+      timer.Reset();
+      set<uint32_t> found;
+      rtree->ForEachInRectAndScale(rect, scale, [&](uint32_t value) { found.insert(value); });
+      auto const rtreeTime = timer.ElapsedSeconds();
+
+      // Cells covering is coarser than bounding boxes, but all really intersecting features are
+      // in both indexes.
+      size_t intersecting = 0;
+      for (auto const value : covered)
+      {
+        if (limitRects[value].IsIntersect(rect))
+        {
+          ++intersecting;
+          TEST(found.count(value) != 0, (value, radiusM, scale));
+        }
+      }
+      m2::RectD inflated = rect;
+      inflated.Inflate(kEps, kEps);
+      for (auto const value : found)
+        TEST(limitRects[value].IsIntersect(inflated), (value, radiusM, scale));
+
+      LOG(LINFO, ("Rect size:", radiusM, "scale:", scale, "covering features:", covered.size(),
+                  "intersecting:", intersecting, "time:", coveringTime, "R-tree features:",
+                  found.size(), "time:", rtreeTime));
+    }
+  }
+}
+}  // namespace packed_rtree_test
@@ -1,5 +1,6 @@
 #include "indexer/mwm_set.hpp"
 
+#include "indexer/features_blocks.hpp"
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/scales.hpp"
 
@@ -21,7 +22,12 @@ using namespace std;
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
-MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0) {}
+MwmInfo::MwmInfo()
+  : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(kNotUpToDateFlag)
+{
+}
+
+MwmInfo::~MwmInfo() { ClearFreeValues(); }
 
 MwmInfo::MwmTypeT MwmInfo::GetType() const
 {
@@ -33,6 +39,57 @@ MwmInfo::MwmTypeT MwmInfo::GetType() const
   return COASTS;
 }
 
+bool MwmInfo::TryAddRef()
+{
+  uint32_t refs = m_numRefs.load();
+  do
+  {
+    if (refs & kNotUpToDateFlag)
+      return false;
+  } while (!m_numRefs.compare_exchange_weak(refs, refs + 1));
+  return true;
+}
+
+unique_ptr<MwmValue> MwmInfo::PopFreeValue()
+{
+  for (auto & slot : m_freeValues)
+  {
+    if (slot.load(memory_order_relaxed) == nullptr)
+      continue;
+    if (MwmValue * value = slot.exchange(nullptr, memory_order_acquire))
+      return unique_ptr<MwmValue>(value);
+  }
+  return nullptr;
+}
+
+bool MwmInfo::PushFreeValue(unique_ptr<MwmValue> & value)
+{
+  for (auto & slot : m_freeValues)
+  {
+    MwmValue * expected = nullptr;
+    if (slot.compare_exchange_strong(expected, value.get()))
+    {
+      value.release();
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t MwmInfo::ClearFreeValues()
+{
+  size_t count = 0;
+  for (auto & slot : m_freeValues)
+  {
+    if (MwmValue * value = slot.exchange(nullptr))
+    {
+      delete value;
+      ++count;
+    }
+  }
+  return count;
+}
+
 bool MwmSet::MwmId::IsDeregistered(platform::LocalCountryFile const & deregisteredCountryFile) const
 {
   return m_info && m_info->GetStatus() == MwmInfo::STATUS_DEREGISTERED &&
@@ -160,7 +217,10 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     return false;
 
   shared_ptr<MwmInfo> const & info = id.GetInfo();
-  if (info->m_numRefs == 0)
+  // The mark disables references without |m_lock| (see MwmInfo::TryAddRef), so the number
+  // of references can't grow until the lock is released.
+  SetStatus(*info, MwmInfo::STATUS_MARKED_TO_DEREGISTER, events);
+  if (info->GetNumRefs() == 0)
   {
     SetStatus(*info, MwmInfo::STATUS_DEREGISTERED, events);
     vector<shared_ptr<MwmInfo>> & infos = m_info[info->GetCountryName()];
@@ -173,10 +233,10 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
         break;
       }
     }
+    ClearFreeValues(*info);
     return true;
   }
 
-  SetStatus(*info, MwmInfo::STATUS_MARKED_TO_DEREGISTER, events);
   return false;
 }
 
@@ -311,6 +371,15 @@ unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
 
 void MwmSet::UnlockValue(MwmId const & id, unique_ptr<MwmValue> p)
 {
+  ASSERT(id.IsAlive(), (id));
+  ASSERT(p.get() != nullptr, ());
+  MwmInfo & info = *id.GetInfo();
+  if (info.IsUpToDate() && PushFreeValue(info, p))
+  {
+    ReleaseRef(id);
+    return;
+  }
+
   WithEventLog([&](EventList & events)
                {
                  UnlockValueImpl(id, std::move(p), events);
@@ -325,9 +394,8 @@ void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValue> p, EventList
     return;
 
   shared_ptr<MwmInfo> const & info = id.GetInfo();
-  ASSERT_GREATER(info->m_numRefs, 0, ());
-  --info->m_numRefs;
-  if (info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
+  ASSERT_GREATER(info->GetNumRefs(), 0, ());
+  if (info->RemoveRef() == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
     VERIFY(DeregisterImpl(id, events), ());
 
   if (info->IsUpToDate())
@@ -336,19 +404,28 @@ void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValue> p, EventList
     /// But it's no obvious if we have many threads working with the single mwm.
 
     m_cache.push_back(make_pair(id, std::move(p)));
-    if (m_cache.size() > m_cacheSize)
+    // Idle values in the pools of mwms are counted against the cache size too.
+    while (!m_cache.empty() && m_cache.size() + m_freeValuesCount > m_cacheSize)
     {
       LOG(LDEBUG, ("MwmValue max cache size reached! Added", id, "removed", m_cache.front().first));
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
       m_cache.pop_front();
     }
   }
 }
 
+void MwmSet::ReleaseRef(MwmId const & id)
+{
+  MwmInfo & info = *id.GetInfo();
+  ASSERT_GREATER(info.GetNumRefs(), 0, ());
+  if (info.RemoveRef() == 0 && info.GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
+    WithEventLog([&](EventList & events) { DeregisterImpl(id, events); });
+}
+
 void MwmSet::Clear()
 {
   lock_guard<mutex> lock(m_lock);
   ClearCacheImpl(m_cache.begin(), m_cache.end());
+  ClearFreeValuesImpl();
   m_info.clear();
 }
 
@@ -356,6 +433,7 @@ void MwmSet::ClearCache()
 {
   lock_guard<mutex> lock(m_lock);
   ClearCacheImpl(m_cache.begin(), m_cache.end());
+  ClearFreeValuesImpl();
 }
 
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
@@ -376,6 +454,17 @@ MwmSet::MwmHandle MwmSet::GetMwmHandleByCountryFile(CountryFile const & countryF
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleById(MwmId const & id)
 {
+  if (id.IsAlive())
+  {
+    MwmInfo & info = *id.GetInfo();
+    if (info.TryAddRef())
+    {
+      if (auto value = PopFreeValue(info))
+        return MwmHandle(*this, id, std::move(value));
+      ReleaseRef(id);
+    }
+  }
+
   MwmSet::MwmHandle handle;
   WithEventLog([&](EventList & events)
                {
@@ -394,6 +483,42 @@ MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & eve
 
 void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end) { m_cache.erase(beg, end); }
 
+void MwmSet::ClearFreeValuesImpl()
+{
+  for (auto const & p : m_info)
+  {
+    for (auto const & info : p.second)
+      ClearFreeValues(*info);
+  }
+}
+
+unique_ptr<MwmValue> MwmSet::PopFreeValue(MwmInfo & info)
+{
+  auto value = info.PopFreeValue();
+  if (value)
+    --m_freeValuesCount;
+  return value;
+}
+
+bool MwmSet::PushFreeValue(MwmInfo & info, unique_ptr<MwmValue> & value)
+{
+  if (m_freeValuesCount++ >= m_cacheSize || !info.PushFreeValue(value))
+  {
+    --m_freeValuesCount;
+    return false;
+  }
+
+  // The mwm may be deregistered after the caller's status check, its pool isn't used anymore.
+  if (!info.IsUpToDate())
+    ClearFreeValues(info);
+  return true;
+}
+
+void MwmSet::ClearFreeValues(MwmInfo & info)
+{
+  m_freeValuesCount -= info.ClearFreeValues();
+}
+
 void MwmSet::ClearCache(MwmId const & id)
 {
   auto sameId = [&id](pair<MwmSet::MwmId, unique_ptr<MwmValue>> const & p)
@@ -401,6 +526,8 @@ void MwmSet::ClearCache(MwmId const & id)
     return (p.first == id);
   };
   ClearCacheImpl(base::RemoveIfKeepValid(m_cache.begin(), m_cache.end(), sameId), m_cache.end());
+  if (id.GetInfo())
+    ClearFreeValues(*id.GetInfo());
 }
 
 // MwmValue ----------------------------------------------------------------------------------------
@@ -411,6 +538,39 @@ MwmValue::MwmValue(LocalCountryFile const & localFile)
   m_factory.Load(m_cont);
 }
 
+MwmValue::~MwmValue() = default;
+
+FilesMappingContainer::Handle const & MwmValue::GetMappedFeatures() const
+{
+  std::call_once(m_mapSectionsOnce, &MwmValue::MapSections, this);
+  return m_features;
+}
+
+indexer::RTreeIndex const * MwmValue::GetRTree() const
+{
+  std::call_once(m_mapSectionsOnce, &MwmValue::MapSections, this);
+  return m_rtree.get();
+}
+
+void MwmValue::MapSections() const
+{
+  // The whole section is mapped, so don't waste the address space of 32-bit devices.
+  if (sizeof(void *) < 8 || m_file.IsInBundle())
+    return;
+
+  try
+  {
+    // The mapping stays valid after the container is closed.
+    FilesMappingContainer const cont(m_file.GetPath(MapFileType::Map));
+    m_features = cont.Map(FEATURES_FILE_TAG);
+    m_rtree = indexer::RTreeIndex::Load(cont);
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't map features of", m_file, e.Msg()));
+  }
+}
+
 void MwmValue::SetTable(MwmInfoEx & info)
 {
   m_table = info.m_table.lock();
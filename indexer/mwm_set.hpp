@@ -1,10 +1,13 @@
 #pragma once
 #include "indexer/data_factory.hpp"
 #include "indexer/house_to_street_iface.hpp"
+#include "indexer/packed_rtree.hpp"
 
 #include "platform/local_country_file.hpp"
 #include "platform/mwm_version.hpp"
 
+#include "coding/files_container.hpp"
+
 #include "geometry/rect2d.hpp"
 
 #include "base/macros.hpp"
@@ -12,6 +15,7 @@
 
 #include "defines.hpp"
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <map>
@@ -21,7 +25,13 @@
 #include <utility>
 #include <vector>
 
-namespace feature { class FeaturesOffsetsTable; }
+namespace feature
+{
+class FeaturesBlocks;
+class FeaturesOffsetsTable;
+}  // namespace feature
+
+class MwmValue;
 
 /// Information about stored mwm.
 class MwmInfo
@@ -45,7 +55,7 @@ public:
   };
 
   MwmInfo();
-  virtual ~MwmInfo() = default;
+  virtual ~MwmInfo();
 
   /// @obsolete Rect around region border. Features which cross region border may cross this rect.
   /// @todo VNG: Not true. This rect accumulates all features in MWM. Since we don't crop features by border,
@@ -74,13 +84,16 @@ public:
   feature::RegionData const & GetRegionData() const { return m_data; }
 
   /// Returns the lock counter value for test needs.
-  uint8_t GetNumRefs() const { return m_numRefs; }
+  uint32_t GetNumRefs() const { return m_numRefs & kRefsMask; }
 
 protected:
   Status SetStatus(Status status)
   {
-    Status result = m_status;
-    m_status = status;
+    Status const result = m_status.exchange(status);
+    if (status == STATUS_REGISTERED)
+      m_numRefs &= kRefsMask;
+    else
+      m_numRefs |= kNotUpToDateFlag;
     return result;
   }
 
@@ -88,7 +101,33 @@ protected:
 
   platform::LocalCountryFile m_file;  ///< Path to the mwm file.
   std::atomic<Status> m_status;       ///< Current country status.
-  uint32_t m_numRefs;                 ///< Number of active handles.
+  std::atomic<uint32_t> m_numRefs;    ///< Number of active handles and kNotUpToDateFlag.
+
+private:
+  friend class MwmSet;
+
+  // Set in |m_numRefs| while the mwm is not up to date, so references which are taken without
+  // MwmSet's lock can't appear after the mwm is marked to deregister.
+  static uint32_t constexpr kNotUpToDateFlag = 1U << 31;
+  static uint32_t constexpr kRefsMask = kNotUpToDateFlag - 1;
+
+  // Number of idle values which are kept in the info itself.
+  static size_t constexpr kFreeValuesCount = 8;
+
+  /// Takes a reference without MwmSet's lock.
+  /// @return false if the mwm is not up to date.
+  bool TryAddRef();
+  /// @return Number of references left.
+  uint32_t RemoveRef() { return --m_numRefs & kRefsMask; }
+
+  // Lock-free pool of idle values for handles of an up to date mwm, see MwmSet::GetMwmHandleById.
+  std::unique_ptr<MwmValue> PopFreeValue();
+  /// @return false if the pool is full, |value| is untouched in this case.
+  bool PushFreeValue(std::unique_ptr<MwmValue> & value);
+  /// @return Number of destroyed values.
+  size_t ClearFreeValues();
+
+  std::array<std::atomic<MwmValue *>, kFreeValuesCount> m_freeValues = {};
 };
 
 class MwmInfoEx : public MwmInfo
@@ -108,8 +147,6 @@ private:
   std::weak_ptr<feature::FeaturesOffsetsTable> m_table;
 };
 
-class MwmValue;
-
 class MwmSet
 {
 public:
@@ -299,6 +336,8 @@ public:
 
   MwmHandle GetMwmHandleByCountryFile(platform::CountryFile const & countryFile);
 
+  /// Takes an idle value of an up to date mwm without |m_lock|, so many threads can take and release
+  /// handles of the same mwms without contention. Falls back to the locked path otherwise.
   MwmHandle GetMwmHandleById(MwmId const & id);
 
   /// Now this function looks like workaround, but it allows to avoid ugly const_cast everywhere..
@@ -348,12 +387,27 @@ private:
   void UnlockValue(MwmId const & id, std::unique_ptr<MwmValue> p);
   void UnlockValueImpl(MwmId const & id, std::unique_ptr<MwmValue> p, EventList & events);
 
+  // Releases a reference which was taken without |m_lock|.
+  void ReleaseRef(MwmId const & id);
+
   /// Do the cleaning for [beg, end) without acquiring the mutex.
   /// @precondition This function is always called under mutex m_lock.
   void ClearCacheImpl(Cache::iterator beg, Cache::iterator end);
 
+  /// Destroys idle values of all registered mwms.
+  /// @precondition This function is always called under mutex m_lock.
+  void ClearFreeValuesImpl();
+
+  // Wrappers of MwmInfo's pool which maintain |m_freeValuesCount|.
+  std::unique_ptr<MwmValue> PopFreeValue(MwmInfo & info);
+  bool PushFreeValue(MwmInfo & info, std::unique_ptr<MwmValue> & value);
+  void ClearFreeValues(MwmInfo & info);
+
   Cache m_cache;
+  // Max number of idle values in |m_cache| and in the pools of all mwms together.
   size_t const m_cacheSize;
+  // Number of idle values in the pools of all mwms.
+  std::atomic<size_t> m_freeValuesCount = 0;
 
 protected:
   /// @precondition This function is always called under mutex m_lock.
@@ -380,11 +434,22 @@ public:
 
   std::shared_ptr<feature::FeaturesOffsetsTable> m_table;
   std::unique_ptr<indexer::MetadataDeserializer> m_metaDeserializer;
+  /// Compressed feature records with the cache of decompressed blocks, nullptr if records
+  /// are not compressed. Lives with the value, so cached blocks are reused by later queries.
+  std::unique_ptr<feature::FeaturesBlocks> m_featuresBlocks;
   std::unique_ptr<HouseToStreetTable> m_house2street, m_house2place;
 
   explicit MwmValue(platform::LocalCountryFile const & localFile);
+  ~MwmValue();
   void SetTable(MwmInfoEx & info);
 
+  /// Mapped features section, invalid if the mwm can't be mapped (bundled or 32-bit platform).
+  /// FeaturesVector reads feature records from it without copying.
+  /// Sections are mapped on the first access, so short-living values don't map anything.
+  FilesMappingContainer::Handle const & GetMappedFeatures() const;
+  /// Optional R-tree geometry index, mapped under the same conditions as features.
+  indexer::RTreeIndex const * GetRTree() const;
+
   feature::DataHeader const & GetHeader() const  { return m_factory.GetHeader(); }
   feature::RegionData const & GetRegionData() const { return m_factory.GetRegionData(); }
   version::MwmVersion const & GetMwmVersion() const { return m_factory.GetMwmVersion(); }
@@ -392,6 +457,13 @@ public:
 
   bool HasSearchIndex() const { return m_cont.IsExist(SEARCH_INDEX_FILE_TAG); }
   bool HasGeometryIndex() const { return m_cont.IsExist(INDEX_FILE_TAG); }
+
+private:
+  void MapSections() const;
+
+  mutable std::once_flag m_mapSectionsOnce;
+  mutable FilesMappingContainer::Handle m_features;
+  mutable std::unique_ptr<indexer::RTreeIndex> m_rtree;
 }; // class MwmValue
 
 
@@ -0,0 +1,326 @@
+#include "indexer/packed_rtree.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/point_coding.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace indexer
+{
+namespace
+{
+template <typename T>
+T ReadAt(uint8_t const * data, size_t size, size_t pos)
+{
+  CHECK_LESS_OR_EQUAL(pos + sizeof(T), size, ());
+  T value;
+  memcpy(&value, data + pos, sizeof(T));
+  return SwapIfBigEndianMacroBased(value);
+}
+
+// Hilbert curve index of a point of 2^16 x 2^16 grid.
+uint32_t HilbertIndex(uint32_t x, uint32_t y)
+{
+  uint32_t constexpr kSide = 1 << 16;
+  uint64_t index = 0;
+  for (uint32_t s = kSide / 2; s > 0; s /= 2)
+  {
+    uint32_t const rx = (x & s) != 0 ? 1 : 0;
+    uint32_t const ry = (y & s) != 0 ? 1 : 0;
+    index += uint64_t(s) * s * ((3 * rx) ^ ry);
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = kSide - 1 - x;
+        y = kSide - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return static_cast<uint32_t>(index);
+}
+}  // namespace
+
+// PackedRTree -------------------------------------------------------------------------------------
+PackedRTree::PackedRTree(uint8_t const * data, size_t size)
+{
+  m_size = ReadAt<uint32_t>(data, size, 0);
+  auto const levelsCount = ReadAt<uint32_t>(data, size, sizeof(uint32_t));
+  size_t pos = 2 * sizeof(uint32_t);
+  m_levelBounds.resize(levelsCount);
+  for (auto & bound : m_levelBounds)
+  {
+    bound = ReadAt<uint32_t>(data, size, pos);
+    pos += sizeof(uint32_t);
+  }
+
+  uint32_t const nodesCount = m_levelBounds.empty() ? 0 : m_levelBounds.back();
+  m_boxes = data + pos;
+  m_values = m_boxes + nodesCount * sizeof(Box);
+  CHECK_EQUAL(pos + nodesCount * (sizeof(Box) + sizeof(uint32_t)), size, ());
+}
+
+// static
+PackedRTree::Box PackedRTree::ToBox(m2::RectD const & rect)
+{
+  auto const min = PointDToPointU(rect.LeftBottom(), kPointCoordBits);
+  auto const max = PointDToPointU(rect.RightTop(), kPointCoordBits);
+  // Expand the box to compensate rounding.
+  return {std::max(min.x, 1U) - 1, std::max(min.y, 1U) - 1, max.x + 1, max.y + 1};
+}
+
+// static
+void PackedRTree::Serialize(std::vector<Item> const & items, Writer & writer)
+{
+  auto const size = base::checked_cast<uint32_t>(items.size());
+
+  std::vector<Box> leaves(size);
+  std::vector<uint32_t> hilbert(size);
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    leaves[i] = ToBox(items[i].first);
+    // Centers in 16-bit grid.
+    hilbert[i] = HilbertIndex((leaves[i].m_minX / 2 + leaves[i].m_maxX / 2) >> (kPointCoordBits - 16),
+                              (leaves[i].m_minY / 2 + leaves[i].m_maxY / 2) >> (kPointCoordBits - 16));
+  }
+
+  std::vector<uint32_t> order(size);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs)
+  {
+    return hilbert[lhs] != hilbert[rhs] ? hilbert[lhs] < hilbert[rhs]
+                                        : items[lhs].second < items[rhs].second;
+  });
+
+  std::vector<uint32_t> levelBounds;
+  if (size != 0)
+  {
+    uint32_t count = size;
+    uint32_t nodesCount = count;
+    levelBounds.push_back(nodesCount);
+    do
+    {
+      count = (count + kNodeSize - 1) / kNodeSize;
+      nodesCount += count;
+      levelBounds.push_back(nodesCount);
+    } while (count != 1);
+  }
+
+  std::vector<Box> boxes(levelBounds.empty() ? 0 : levelBounds.back());
+  std::vector<uint32_t> values(boxes.size());
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    boxes[i] = leaves[order[i]];
+    values[i] = items[order[i]].second;
+  }
+
+  uint32_t pos = 0;
+  for (size_t level = 0; level + 1 < levelBounds.size(); ++level)
+  {
+    uint32_t parent = levelBounds[level];
+    for (; pos < levelBounds[level]; pos += kNodeSize, ++parent)
+    {
+      auto const end = std::min(pos + kNodeSize, levelBounds[level]);
+      Box box = boxes[pos];
+      for (uint32_t i = pos + 1; i < end; ++i)
+      {
+        box.m_minX = std::min(box.m_minX, boxes[i].m_minX);
+        box.m_minY = std::min(box.m_minY, boxes[i].m_minY);
+        box.m_maxX = std::max(box.m_maxX, boxes[i].m_maxX);
+        box.m_maxY = std::max(box.m_maxY, boxes[i].m_maxY);
+      }
+      boxes[parent] = box;
+      values[parent] = pos;
+    }
+    CHECK_EQUAL(parent, levelBounds[level + 1], ());
+    pos = levelBounds[level];
+  }
+
+  WriteToSink(writer, size);
+  WriteToSink(writer, base::checked_cast<uint32_t>(levelBounds.size()));
+  for (auto const bound : levelBounds)
+    WriteToSink(writer, bound);
+  for (auto const & box : boxes)
+  {
+    WriteToSink(writer, box.m_minX);
+    WriteToSink(writer, box.m_minY);
+    WriteToSink(writer, box.m_maxX);
+    WriteToSink(writer, box.m_maxY);
+  }
+  for (auto const value : values)
+    WriteToSink(writer, value);
+}
+
+PackedRTree::Box PackedRTree::GetBox(uint32_t node) const
+{
+  Box box;
+  memcpy(&box, m_boxes + node * sizeof(Box), sizeof(Box));
+  box.m_minX = SwapIfBigEndianMacroBased(box.m_minX);
+  box.m_minY = SwapIfBigEndianMacroBased(box.m_minY);
+  box.m_maxX = SwapIfBigEndianMacroBased(box.m_maxX);
+  box.m_maxY = SwapIfBigEndianMacroBased(box.m_maxY);
+  return box;
+}
+
+uint32_t PackedRTree::GetValue(uint32_t node) const
+{
+  uint32_t value;
+  memcpy(&value, m_values + node * sizeof(uint32_t), sizeof(value));
+  return SwapIfBigEndianMacroBased(value);
+}
+
+void PackedRTree::ForEachInRect(m2::RectD const & rect, std::function<void(uint32_t)> const & fn) const
+{
+  ForEachInRect(rect, 0 /* leavesBegin */, m_size, fn);
+}
+
+void PackedRTree::ForEachInRect(m2::RectD const & rect, uint32_t leavesBegin, uint32_t leavesEnd,
+                                std::function<void(uint32_t)> const & fn) const
+{
+  leavesEnd = std::min(leavesEnd, m_size);
+  if (leavesBegin >= leavesEnd)
+    return;
+
+  Box const query = ToBox(rect);
+  uint32_t const root = m_levelBounds.back() - 1;
+  if (!GetBox(root).IsIntersect(query))
+    return;
+
+  // Nodes with their levels, leaves are on the level 0. A node of the level l with index i in
+  // the level covers leaves [i * kNodeSize^l, (i + 1) * kNodeSize^l).
+  std::vector<std::pair<uint32_t, size_t>> stack = {{root, m_levelBounds.size() - 1}};
+  while (!stack.empty())
+  {
+    auto const [node, level] = stack.back();
+    stack.pop_back();
+
+    size_t const childLevel = level - 1;
+    uint32_t const levelBegin = childLevel == 0 ? 0 : m_levelBounds[childLevel - 1];
+    uint64_t leavesPerChild = 1;
+    for (size_t i = 0; i < childLevel; ++i)
+      leavesPerChild *= kNodeSize;
+
+    uint32_t const first = GetValue(node);
+    uint32_t const end = std::min(first + kNodeSize, m_levelBounds[childLevel]);
+    for (uint32_t child = first; child < end; ++child)
+    {
+      uint64_t const childLeavesBegin = (child - levelBegin) * leavesPerChild;
+      if (childLeavesBegin >= leavesEnd || childLeavesBegin + leavesPerChild <= leavesBegin)
+        continue;
+
+      if (!GetBox(child).IsIntersect(query))
+        continue;
+
+      if (childLevel == 0)
+        fn(GetValue(child));
+      else
+        stack.emplace_back(child, childLevel);
+    }
+  }
+}
+
+// RTreeIndex --------------------------------------------------------------------------------------
+// static
+std::unique_ptr<RTreeIndex> RTreeIndex::Load(FilesMappingContainer const & cont)
+{
+  if (!cont.IsExist(RTREE_INDEX_FILE_TAG))
+    return {};
+
+  // Can't use make_unique with private constructor.
+  std::unique_ptr<RTreeIndex> index(new RTreeIndex());
+  index->m_handle = cont.Map(RTREE_INDEX_FILE_TAG);
+  index->Init(index->m_handle.GetData<uint8_t>(), index->m_handle.GetSize());
+  return index;
+}
+
+// static
+std::unique_ptr<RTreeIndex> RTreeIndex::Load(std::vector<uint8_t> && buffer)
+{
+  std::unique_ptr<RTreeIndex> index(new RTreeIndex());
+  index->m_buffer = std::move(buffer);
+  index->Init(index->m_buffer.data(), index->m_buffer.size());
+  return index;
+}
+
+// static
+void RTreeIndex::Serialize(std::vector<std::vector<PackedRTree::Item>> const & buckets, Writer & writer)
+{
+  std::vector<std::vector<uint8_t>> trees(buckets.size());
+  for (size_t i = 0; i < buckets.size(); ++i)
+  {
+    MemWriter<std::vector<uint8_t>> treeWriter(trees[i]);
+    PackedRTree::Serialize(buckets[i], treeWriter);
+  }
+
+  auto const bucketsCount = base::checked_cast<uint32_t>(buckets.size());
+  WriteToSink(writer, static_cast<uint8_t>(Version::Latest));
+  WriteToSink(writer, bucketsCount);
+
+  // Offsets of trees and the end of the section.
+  uint64_t offset = sizeof(uint8_t) + sizeof(uint32_t) * (bucketsCount + 2);
+  for (auto const & tree : trees)
+  {
+    WriteToSink(writer, base::checked_cast<uint32_t>(offset));
+    offset += tree.size();
+  }
+  WriteToSink(writer, base::checked_cast<uint32_t>(offset));
+
+  for (auto const & tree : trees)
+    writer.Write(tree.data(), tree.size());
+}
+
+void RTreeIndex::Init(uint8_t const * data, size_t size)
+{
+  auto const version = ReadAt<uint8_t>(data, size, 0);
+  CHECK_EQUAL(version, static_cast<uint8_t>(Version::V0), ());
+  auto const bucketsCount = ReadAt<uint32_t>(data, size, sizeof(uint8_t));
+
+  size_t const offsetsPos = sizeof(uint8_t) + sizeof(uint32_t);
+  for (uint32_t i = 0; i < bucketsCount; ++i)
+  {
+    auto const begin = ReadAt<uint32_t>(data, size, offsetsPos + i * sizeof(uint32_t));
+    auto const end = ReadAt<uint32_t>(data, size, offsetsPos + (i + 1) * sizeof(uint32_t));
+    CHECK_LESS_OR_EQUAL(begin, end, ());
+    CHECK_LESS_OR_EQUAL(end, size, ());
+    m_trees.emplace_back(data + begin, end - begin);
+  }
+}
+
+void RTreeIndex::ForEachInRectAndScale(m2::RectD const & rect, int scale,
+                                       std::function<void(uint32_t)> const & fn) const
+{
+  auto const scaleBucket = BucketByScale(scale);
+  if (scaleBucket >= m_trees.size())
+    return;
+
+  for (size_t i = 0; i <= scaleBucket; ++i)
+    m_trees[i].ForEachInRect(rect, fn);
+}
+
+void RTreeIndex::ForEachInRectAndScale(m2::RectD const & rect, int scale, size_t part, size_t partsCount,
+                                       std::function<void(uint32_t)> const & fn) const
+{
+  CHECK_LESS(part, partsCount, ());
+  auto const scaleBucket = BucketByScale(scale);
+  if (scaleBucket >= m_trees.size())
+    return;
+
+  for (size_t i = 0; i <= scaleBucket; ++i)
+  {
+    uint64_t const size = m_trees[i].GetSize();
+    auto const begin = static_cast<uint32_t>(size * part / partsCount);
+    auto const end = static_cast<uint32_t>(size * (part + 1) / partsCount);
+    m_trees[i].ForEachInRect(rect, begin, end, fn);
+  }
+}
+}  // namespace indexer
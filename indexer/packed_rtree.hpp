@@ -0,0 +1,110 @@
+#pragma once
+
+#include "indexer/scale_index.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class Writer;
+
+namespace indexer
+{
+/// Static R-tree packed in the Hilbert order of boxes centers (see flatbush).
+/// Nodes of each level are stored contiguously, from the leaves to the root. A node is a bounding
+/// box and a value: a feature index for leaves and a position of the first child for inner nodes.
+/// Boxes are stored in kPointCoordBits mercator coordinates.
+class PackedRTree
+{
+public:
+  using Item = std::pair<m2::RectD, uint32_t>;
+
+  static uint32_t constexpr kNodeSize = 16;
+
+  PackedRTree() = default;
+  /// @param data Serialized tree, it should outlive the object.
+  PackedRTree(uint8_t const * data, size_t size);
+
+  static void Serialize(std::vector<Item> const & items, Writer & writer);
+
+  uint32_t GetSize() const { return m_size; }
+
+  /// Calls |fn| with values of items which boxes intersect |rect|.
+  void ForEachInRect(m2::RectD const & rect, std::function<void(uint32_t)> const & fn) const;
+  /// Same, but only for leaves [leavesBegin, leavesEnd) in the packed order. Leaves are sorted
+  /// along the Hilbert curve, so a range of them is a compact area.
+  void ForEachInRect(m2::RectD const & rect, uint32_t leavesBegin, uint32_t leavesEnd,
+                     std::function<void(uint32_t)> const & fn) const;
+
+private:
+  struct Box
+  {
+    bool IsIntersect(Box const & rhs) const
+    {
+      return m_minX <= rhs.m_maxX && rhs.m_minX <= m_maxX && m_minY <= rhs.m_maxY &&
+             rhs.m_minY <= m_maxY;
+    }
+
+    uint32_t m_minX = 0;
+    uint32_t m_minY = 0;
+    uint32_t m_maxX = 0;
+    uint32_t m_maxY = 0;
+  };
+
+  static_assert(sizeof(Box) == 16);
+
+  static Box ToBox(m2::RectD const & rect);
+
+  Box GetBox(uint32_t node) const;
+  uint32_t GetValue(uint32_t node) const;
+
+  uint32_t m_size = 0;
+  // End positions of levels.
+  std::vector<uint32_t> m_levelBounds;
+  uint8_t const * m_boxes = nullptr;
+  uint8_t const * m_values = nullptr;
+};
+
+/// Optional alternative to ScaleIndex: packed R-trees of features bounding boxes per scale bucket.
+/// Unlike the cells covering, a long feature is a single item of a tree, and rect queries
+/// prune whole subtrees by bounding boxes.
+class RTreeIndex : public ScaleIndexBase
+{
+public:
+  enum class Version : uint8_t
+  {
+    V0 = 0,
+    Latest = V0
+  };
+
+  /// @return nullptr if the section doesn't exist.
+  static std::unique_ptr<RTreeIndex> Load(FilesMappingContainer const & cont);
+  static std::unique_ptr<RTreeIndex> Load(std::vector<uint8_t> && buffer);
+
+  /// @param buckets Features of every scale bucket.
+  static void Serialize(std::vector<std::vector<PackedRTree::Item>> const & buckets, Writer & writer);
+
+  /// Calls |fn| for features of buckets up to |scale| which boxes intersect |rect|.
+  void ForEachInRectAndScale(m2::RectD const & rect, int scale,
+                             std::function<void(uint32_t)> const & fn) const;
+  /// Same, but only for the |part|-th of |partsCount| equal parts of leaves of every tree.
+  /// Parts don't intersect, so they can be read by different threads.
+  void ForEachInRectAndScale(m2::RectD const & rect, int scale, size_t part, size_t partsCount,
+                             std::function<void(uint32_t)> const & fn) const;
+
+private:
+  RTreeIndex() = default;
+
+  void Init(uint8_t const * data, size_t size);
+
+  FilesMappingContainer::Handle m_handle;
+  std::vector<uint8_t> m_buffer;
+  std::vector<PackedRTree> m_trees;
+};
+}  // namespace indexer
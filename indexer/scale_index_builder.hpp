@@ -123,9 +123,10 @@ private:
   std::vector<uint32_t> & m_cellsInBucket;
 };
 
-template <class FeaturesVector, class Writer>
-void IndexScales(feature::DataHeader const & header, FeaturesVector const & features,
-                 Writer & writer, std::string const &)
+/// @return Cells of all indexed features sorted by buckets.
+template <class FeaturesVector>
+std::vector<CellFeatureBucketTuple> CoverFeatures(feature::DataHeader const & header,
+                                                  FeaturesVector const & features)
 {
   // TODO: Make scale bucketing dynamic.
 
@@ -161,7 +162,14 @@ void IndexScales(feature::DataHeader const & header, FeaturesVector const & feat
                   "cells per feature:", cellsPerFeature));
     }
   }
+  return cellsToFeaturesAllBuckets;
+}
 
+template <class Writer>
+void WriteScaleIndex(uint32_t bucketsCount,
+                     std::vector<CellFeatureBucketTuple> const & cellsToFeaturesAllBuckets,
+                     Writer & writer)
+{
   VarSerialVectorWriter<Writer> recordWriter(writer, bucketsCount);
   auto it = cellsToFeaturesAllBuckets.begin();
 
@@ -190,4 +198,11 @@ void IndexScales(feature::DataHeader const & header, FeaturesVector const & feat
   LOG(LINFO, ("All scale indexes done."));
 }
 
+template <class FeaturesVector, class Writer>
+void IndexScales(feature::DataHeader const & header, FeaturesVector const & features,
+                 Writer & writer, std::string const &)
+{
+  WriteScaleIndex(header.GetLastScale() + 1, CoverFeatures(header, features), writer);
+}
+
 }  // namespace covering
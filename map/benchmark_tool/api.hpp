@@ -43,6 +43,7 @@ namespace bench
     double m_all = 0.0;
   };
 
-  /// @param[in] count number of times to run benchmark
-  void RunFeaturesLoadingBenchmark(std::string filePath, std::pair<int, int> scaleR, AllResult & res);
+  /// @param[in] threadsCount number of threads to read features of each rect
+  void RunFeaturesLoadingBenchmark(std::string filePath, std::pair<int, int> scaleR,
+                                   size_t threadsCount, AllResult & res);
 }  // namespace bench
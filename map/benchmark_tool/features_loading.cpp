@@ -11,6 +11,7 @@
 #include "base/macros.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -61,14 +62,20 @@ namespace
   };
 
   void RunBenchmark(FeaturesFetcher const & src, m2::RectD const & rect,
-                    pair<int, int> const & scaleRange, AllResult & res)
+                    pair<int, int> const & scaleRange, size_t threadsCount, AllResult & res)
   {
     ASSERT_LESS_OR_EQUAL(scaleRange.first, scaleRange.second, ());
+    ASSERT_GREATER(threadsCount, 0, ());
 
     vector<m2::RectD> rects;
     rects.push_back(rect);
 
-    Accumulator acc(res.m_reading);
+    // One accumulator per reading thread, results are merged at the end.
+    vector<Result> results(threadsCount);
+    vector<Accumulator> accs;
+    accs.reserve(threadsCount);
+    for (auto & r : results)
+      accs.emplace_back(r);
 
     while (!rects.empty())
     {
@@ -79,13 +86,23 @@ namespace
       int const scale = scales::GetScaleLevel(r);
       if (scale >= scaleRange.first)
       {
-        acc.Reset(scale);
+        for (auto & acc : accs)
+          acc.Reset(scale);
 
         base::Timer timer;
-        src.ForEachFeature(r, acc, scale);
+        if (threadsCount == 1)
+        {
+          src.ForEachFeature(r, accs.front(), scale);
+        }
+        else
+        {
+          src.GetDataSource().ForEachInRectParallel(
+              [&accs](FeatureType & ft, size_t threadIndex) { accs[threadIndex](ft); }, r, scale,
+              threadsCount);
+        }
         res.Add(timer.ElapsedSeconds());
 
-        doDivide = !acc.IsEmpty();
+        doDivide = !all_of(accs.begin(), accs.end(), [](auto const & acc) { return acc.IsEmpty(); });
       }
 
       if (doDivide && scale < scaleRange.second)
@@ -96,10 +113,14 @@ namespace
         rects.push_back(r2);
       }
     }
+
+    for (auto const & r : results)
+      res.m_reading.Add(r);
   }
 }
 
-void RunFeaturesLoadingBenchmark(string fileName, pair<int, int> scaleRange, AllResult & res)
+void RunFeaturesLoadingBenchmark(string fileName, pair<int, int> scaleRange, size_t threadsCount,
+                                 AllResult & res)
 {
   base::GetNameFromFullPath(fileName);
   base::GetNameWithoutExt(fileName);
@@ -119,6 +140,6 @@ void RunFeaturesLoadingBenchmark(string fileName, pair<int, int> scaleRange, All
   if (scaleRange.first > scaleRange.second)
     return;
 
-  RunBenchmark(src, r.first.GetInfo()->m_bordersRect, scaleRange, res);
+  RunBenchmark(src, r.first.GetInfo()->m_bordersRect, scaleRange, threadsCount, res);
 }
 }  // namespace bench
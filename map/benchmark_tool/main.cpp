@@ -13,6 +13,7 @@ DEFINE_string(input, "", "MWM file name in the data directory");
 DEFINE_int32(lowS, 10, "Low processing scale");
 DEFINE_int32(highS, 17, "High processing scale");
 DEFINE_bool(print_scales, false, "Print geometry scales for MWM and exit");
+DEFINE_uint64(threads, 1, "Number of threads to read features in a rect");
 
 int main(int argc, char ** argv)
 {
@@ -42,7 +43,8 @@ int main(int argc, char ** argv)
     using namespace bench;
 
     AllResult res;
-    RunFeaturesLoadingBenchmark(FLAGS_input, make_pair(FLAGS_lowS, FLAGS_highS), res);
+    RunFeaturesLoadingBenchmark(FLAGS_input, make_pair(FLAGS_lowS, FLAGS_highS),
+                                static_cast<size_t>(FLAGS_threads), res);
 
     res.Print();
   }
@@ -44,6 +44,7 @@
 #include "platform/preferred_languages.hpp"
 #include "platform/settings.hpp"
 
+#include "coding/block_cache.hpp"
 #include "coding/point_coding.hpp"
 #include "coding/string_utf8_multilang.hpp"
 #include "coding/transliteration.hpp"
@@ -100,6 +101,7 @@ char const kLargeFontsSize[] = "LargeFontsSize";
 char const kTranslitMode[] = "TransliterationMode";
 char const kPreferredGraphicsAPI[] = "PreferredGraphicsAPI";
 char const kShowDebugInfo[] = "DebugInfo";
+char const kMwmBlockCacheSizeMB[] = "MwmBlockCacheSizeMB";
 
 auto constexpr kLargeFontsScaleFactor = 1.6;
 size_t constexpr kMaxTrafficCacheSizeBytes = 64 /* Mb */ * 1024 * 1024;
@@ -295,6 +297,11 @@ Framework::Framework(FrameworkParams const & params, bool loadMaps)
   GetStyleReader().SetCurrentStyle(mapStyle);
   df::LoadTransitColors();
 
+  // Mwm readers share one block cache when it's enabled. It should be set before maps registration.
+  uint32_t blockCacheSizeMB = 0;
+  if (settings::Get(kMwmBlockCacheSizeMB, blockCacheSizeMB) && blockCacheSizeMB > 0)
+    GetPlatform().SetMwmBlockCache(std::make_shared<BlockCache>(uint64_t(blockCacheSizeMB) << 20));
+
   m_connectToGpsTrack = GpsTracker::Instance().IsEnabled();
 
   // Init strings bundle.
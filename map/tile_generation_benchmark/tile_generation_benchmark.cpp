@@ -0,0 +1,356 @@
+#include "map/features_fetcher.hpp"
+
+#include "drape_frontend/area_shape.hpp"
+#include "drape_frontend/batcher_bucket.hpp"
+#include "drape_frontend/colored_symbol_shape.hpp"
+#include "drape_frontend/engine_context.hpp"
+#include "drape_frontend/line_geometry_cache.hpp"
+#include "drape_frontend/line_shape.hpp"
+#include "drape_frontend/map_data_provider.hpp"
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/metaline_manager.hpp"
+#include "drape_frontend/path_symbol_shape.hpp"
+#include "drape_frontend/path_text_shape.hpp"
+#include "drape_frontend/poi_symbol_shape.hpp"
+#include "drape_frontend/text_shape.hpp"
+#include "drape_frontend/threads_commutator.hpp"
+#include "drape_frontend/tile_info.hpp"
+#include "drape_frontend/tile_utils.hpp"
+#include "drape_frontend/visual_params.hpp"
+
+#include "drape/batcher.hpp"
+#include "drape/drape_routine.hpp"
+#include "drape/index_storage.hpp"
+#include "drape/null_graphics_context.hpp"
+#include "drape/render_bucket.hpp"
+#include "drape/texture_manager.hpp"
+#include "drape/vertex_array_buffer.hpp"
+
+#include "indexer/scales.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/thread_pool_computational.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+// This tool measures CPU cost of tiles geometry generation without GPU: features reading,
+// RuleDrawer and Stylist work (shapes preparation) and shapes drawing into batchers with
+// the null graphics context. Also it measures size of generated vertices and indices, which
+// are uploaded to GPU. For example:
+// tile_generation_benchmark -input=Belarus_Minsk-Region.mwm -zoom=16 -max_tiles=100
+// tile_generation_benchmark -input=Belarus_Minsk-Region.mwm -tiles="37881,-21337,16;37882,-21337,16"
+
+DEFINE_string(input, "", "MWM file name in the data directory.");
+DEFINE_string(tiles, "", "Semicolon separated tiles in x,y,zoom format. If empty, tiles of "
+                         "|zoom| around the mwm center are used.");
+DEFINE_int32(zoom, 15, "Zoom of tiles, if |tiles| is empty.");
+DEFINE_uint64(max_tiles, 100, "Max tiles count around the mwm center, if |tiles| is empty.");
+DEFINE_double(visual_scale, df::VisualParams::kXhdpiScale, "Visual scale.");
+DEFINE_uint64(iterations, 1, "Number of iterations over all tiles.");
+DEFINE_uint64(shapes_threads, 0, "Number of additional threads to process features of a tile, "
+                                 "0 means sequential processing.");
+DEFINE_bool(line_geometry_cache, true, "Reuse decoded geometry of long lines in neighboring tiles.");
+
+namespace
+{
+using namespace df;
+
+uint32_t constexpr kBatchSize = 5000;
+uint32_t constexpr kTileSize = 512;
+
+// Collects shapes which are sent by EngineContext to the backend renderer.
+class ShapesCollector : public ThreadsCommutator
+{
+public:
+  void PostMessage(ThreadName name, drape_ptr<Message> && message, MessagePriority priority) override
+  {
+    auto const type = message->GetType();
+    if (type == Message::Type::MapShapeReaded || type == Message::Type::OverlayMapShapeReaded)
+    {
+      ref_ptr<MapShapeReadedMessage> msg = make_ref(message);
+      auto const & shapes = msg->GetShapes();
+      m_shapes.insert(m_shapes.end(), shapes.begin(), shapes.end());
+    }
+  }
+
+  TMapShapes TakeShapes() { return std::move(m_shapes); }
+
+private:
+  TMapShapes m_shapes;
+};
+
+std::string GetShapeName(MapShape const & shape)
+{
+  if (dynamic_cast<LineShape const *>(&shape) != nullptr)
+    return "LineShape";
+  if (dynamic_cast<AreaShape const *>(&shape) != nullptr)
+    return "AreaShape";
+  if (dynamic_cast<TextShape const *>(&shape) != nullptr)
+    return "TextShape";
+  if (dynamic_cast<PathTextShape const *>(&shape) != nullptr)
+    return "PathTextShape";
+  if (dynamic_cast<PoiSymbolShape const *>(&shape) != nullptr)
+    return "PoiSymbolShape";
+  if (dynamic_cast<PathSymbolShape const *>(&shape) != nullptr)
+    return "PathSymbolShape";
+  if (dynamic_cast<ColoredSymbolShape const *>(&shape) != nullptr)
+    return "ColoredSymbolShape";
+  return "Other";
+}
+
+bool ParseTiles(std::string const & str, std::vector<TileKey> & tiles)
+{
+  for (auto const & tileStr : strings::Tokenize(str, ";"))
+  {
+    auto const coords = strings::Tokenize<std::string>(tileStr, ",");
+    int x, y, zoom;
+    if (coords.size() != 3 || !strings::to_int(coords[0], x) || !strings::to_int(coords[1], y) ||
+        !strings::to_int(coords[2], zoom) || zoom <= 0 || zoom > scales::GetUpperStyleScale())
+    {
+      LOG(LERROR, ("Bad tile:", tileStr));
+      return false;
+    }
+    tiles.emplace_back(x, y, static_cast<uint8_t>(zoom));
+  }
+  return true;
+}
+
+std::vector<TileKey> GetTilesAroundCenter(m2::RectD const & rect, int zoom, size_t maxCount)
+{
+  std::vector<TileKey> tiles;
+  CalcTilesCoverage(rect, zoom, [&tiles, zoom](int x, int y)
+  {
+    tiles.emplace_back(x, y, static_cast<uint8_t>(zoom));
+  });
+
+  auto const center = rect.Center();
+  std::sort(tiles.begin(), tiles.end(), [&center](TileKey const & lhs, TileKey const & rhs)
+  {
+    return lhs.GetGlobalRect().Center().SquaredLength(center) <
+           rhs.GetGlobalRect().Center().SquaredLength(center);
+  });
+  if (tiles.size() > maxCount)
+    tiles.resize(maxCount);
+  return tiles;
+}
+
+struct ShapeTypeStat
+{
+  size_t m_count = 0;
+  double m_seconds = 0.0;
+};
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  gflags::SetUsageMessage(
+      "Headless tiles geometry generation benchmark. Reads tiles of mwm, prepares and draws "
+      "their shapes without GPU and prints features/sec, shapes/sec, generated vertices, "
+      "size of vertex and index data per tile and time of shapes drawing per shape type.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_input.empty())
+  {
+    LOG(LERROR, ("Mwm file name should be set."));
+    return -1;
+  }
+
+  std::string mwmName = FLAGS_input;
+  base::GetNameFromFullPath(mwmName);
+  base::GetNameWithoutExt(mwmName);
+
+  FeaturesFetcher fetcher;
+  fetcher.InitClassificator();
+  auto const regResult = fetcher.RegisterMap(platform::LocalCountryFile::MakeForTesting(mwmName));
+  if (regResult.second != MwmSet::RegResult::Success)
+  {
+    LOG(LERROR, ("Can't register", FLAGS_input));
+    return -1;
+  }
+
+  std::vector<TileKey> tiles;
+  if (!FLAGS_tiles.empty())
+  {
+    if (!ParseTiles(FLAGS_tiles, tiles))
+      return -1;
+  }
+  else
+  {
+    tiles = GetTilesAroundCenter(regResult.first.GetInfo()->m_bordersRect, FLAGS_zoom,
+                                 static_cast<size_t>(FLAGS_max_tiles));
+  }
+
+  if (tiles.empty())
+  {
+    LOG(LERROR, ("No tiles to generate."));
+    return -1;
+  }
+
+  VisualParams::Init(FLAGS_visual_scale, kTileSize);
+  dp::DrapeRoutine::Init();
+
+  auto const makeModel = [&fetcher](std::atomic<uint64_t> * featuresCount)
+  {
+    return MapDataProvider(
+        [&fetcher](MapDataProvider::TReadCallback<FeatureID const> const & fn, m2::RectD const & r,
+                   int scale) { fetcher.ForEachFeatureID(r, fn, scale); },
+        [&fetcher, featuresCount](MapDataProvider::TReadCallback<FeatureType> const & fn,
+                                  std::vector<FeatureID> const & ids)
+        {
+          if (featuresCount != nullptr)
+            *featuresCount += ids.size();
+          fetcher.ReadFeatures(fn, ids);
+        },
+        [&fetcher](std::string_view country) { return fetcher.IsLoaded(country); },
+        [](m2::PointD const &, int) {});
+  };
+
+  // Features which are read for tiles are counted. Batches of a tile are read in parallel
+  // (see --shapes_threads). Metalines are read on a separate thread, so they have their own model.
+  std::atomic<uint64_t> featuresCount = 0;
+  MapDataProvider model = makeModel(&featuresCount);
+  MapDataProvider metalineModel = makeModel(nullptr);
+
+  dp::NullGraphicsContext context;
+  ShapesCollector collector;
+  MetalineManager metalineManager(make_ref(&collector), metalineModel);
+
+  dp::TextureManager texMng;
+  {
+    dp::TextureManager::Params params;
+    params.m_resPostfix = VisualParams::Instance().GetResourcePostfix();
+    params.m_visualScale = VisualParams::Instance().GetVisualScale();
+    params.m_colors = "colors.txt";
+    params.m_patterns = "patterns.txt";
+    params.m_glyphMngParams.m_uniBlocks = "unicode_blocks.txt";
+    params.m_glyphMngParams.m_whitelist = "fonts_whitelist.txt";
+    params.m_glyphMngParams.m_blacklist = "fonts_blacklist.txt";
+    GetPlatform().GetFontNames(params.m_glyphMngParams.m_fonts);
+    texMng.Init(make_ref(&context), params);
+  }
+
+  double readingSeconds = 0.0;
+  double drawingSeconds = 0.0;
+  uint64_t shapesCount = 0;
+  uint64_t verticesCount = 0;
+  uint64_t indicesCount = 0;
+  uint64_t vertexBytes = 0;
+  uint64_t bucketsCount = 0;
+  std::map<std::string, ShapeTypeStat> shapeTypeStats;
+
+  drape_ptr<base::thread_pool::computational::ThreadPool> shapesPool;
+  if (FLAGS_shapes_threads > 0)
+  {
+    shapesPool = make_unique_dp<base::thread_pool::computational::ThreadPool>(
+        static_cast<size_t>(FLAGS_shapes_threads));
+  }
+
+  LineGeometryCache lineGeometryCache(LineGeometryCache::kDefaultMaxPointsCount);
+
+  dp::Batcher batcher(kBatchSize, kBatchSize);
+  base::Timer timer;
+  for (uint64_t i = 0; i < FLAGS_iterations; ++i)
+  {
+    // Every iteration is a new reading of tiles.
+    lineGeometryCache.Clear();
+    for (auto const & tileKey : tiles)
+    {
+      // Shapes preparation: features reading, RuleDrawer and Stylist.
+      timer.Reset();
+      {
+        TileInfo tileInfo(make_unique_dp<EngineContext>(
+            tileKey, make_ref(&collector), make_ref(&texMng), make_ref(&metalineManager),
+            nullptr /* shapesCache */,
+            FLAGS_line_geometry_cache ? make_ref(&lineGeometryCache) : ref_ptr<LineGeometryCache>(),
+            make_ref(shapesPool), nullptr /* freeShapesThreadsCount */, CustomFeaturesContextWeakPtr(),
+            false /* is3dBuildingsEnabled */, false /* isTrafficEnabled */,
+            false /* isolinesEnabled */));
+        tileInfo.ReadFeatures(model);
+      }
+      readingSeconds += timer.ElapsedSeconds();
+
+      // Shapes drawing into batcher, geometry stays in CPU memory.
+      auto const shapes = collector.TakeShapes();
+      shapesCount += shapes.size();
+      batcher.SetBatcherHash(tileKey.GetHashValue(BatcherBucket::Default));
+      batcher.StartSession([&](dp::RenderState const &, drape_ptr<dp::RenderBucket> && bucket)
+      {
+        auto const buffer = bucket->GetBuffer();
+        verticesCount += buffer->GetStartIndexValue();
+        indicesCount += buffer->GetIndexCount();
+        vertexBytes += buffer->GetVertexDataSize();
+        ++bucketsCount;
+      });
+      for (auto const & shape : shapes)
+      {
+        timer.Reset();
+        batcher.SetFeatureMinZoom(shape->GetFeatureMinZoom());
+        shape->Draw(make_ref(&context), make_ref(&batcher), make_ref(&texMng));
+        auto const seconds = timer.ElapsedSeconds();
+
+        auto & stat = shapeTypeStats[GetShapeName(*shape)];
+        ++stat.m_count;
+        stat.m_seconds += seconds;
+        drawingSeconds += seconds;
+      }
+      timer.Reset();
+      batcher.EndSession(make_ref(&context));
+      drawingSeconds += timer.ElapsedSeconds();
+    }
+  }
+
+  metalineManager.Stop();
+  texMng.Release();
+  dp::DrapeRoutine::Shutdown();
+
+  auto const totalSeconds = readingSeconds + drawingSeconds;
+  auto const perSecond = [](uint64_t count, double seconds)
+  {
+    return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+  };
+
+  printf("Tiles: %zu, iterations: %llu\n", tiles.size(),
+         static_cast<unsigned long long>(FLAGS_iterations));
+  printf("Features: %llu, %.1f features/sec (reading and shapes preparation: %.3f sec)\n",
+         static_cast<unsigned long long>(featuresCount), perSecond(featuresCount, readingSeconds),
+         readingSeconds);
+  printf("Shapes: %llu, %.1f shapes/sec (drawing: %.3f sec, total: %.3f sec)\n",
+         static_cast<unsigned long long>(shapesCount), perSecond(shapesCount, drawingSeconds),
+         drawingSeconds, totalSeconds);
+  printf("Vertices: %llu, indices: %llu, render buckets: %llu\n",
+         static_cast<unsigned long long>(verticesCount),
+         static_cast<unsigned long long>(indicesCount),
+         static_cast<unsigned long long>(bucketsCount));
+
+  auto const tilesCount = static_cast<double>(tiles.size() * FLAGS_iterations);
+  auto const indexBytes = indicesCount * dp::IndexStorage::SizeOfIndex();
+  printf("Vertex data: %.1f KB/tile, %.1f bytes/vertex, index data: %.1f KB/tile\n",
+         vertexBytes / tilesCount / 1024.0,
+         verticesCount != 0 ? static_cast<double>(vertexBytes) / verticesCount : 0.0,
+         indexBytes / tilesCount / 1024.0);
+  if (FLAGS_line_geometry_cache)
+    printf("%s\n", DebugPrint(lineGeometryCache.GetStats()).c_str());
+  printf("%-20s %10s %12s %14s\n", "Shape type", "Count", "Time, sec", "Avg time, us");
+  for (auto const & [name, stat] : shapeTypeStats)
+  {
+    printf("%-20s %10zu %12.3f %14.2f\n", name.c_str(), stat.m_count, stat.m_seconds,
+           stat.m_count != 0 ? stat.m_seconds * 1e6 / stat.m_count : 0.0);
+  }
+
+  return 0;
+}
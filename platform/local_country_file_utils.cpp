@@ -5,6 +5,7 @@
 #include "platform/platform.hpp"
 #include "platform/settings.hpp"
 
+#include "coding/file_reader.hpp"
 #include "coding/internal/file_data.hpp"
 #include "coding/reader.hpp"
 
@@ -336,8 +337,10 @@ unique_ptr<ModelReader> GetCountryReader(LocalCountryFile const & file, MapFileT
   Platform & platform = GetPlatform();
   if (file.IsInBundle())
     return platform.GetReader(file.GetFileName(type), GetAdditionalWorldScope());
-  else
-    return platform.GetReader(file.GetPath(type), "f");
+
+  if (auto blockCache = platform.GetMwmBlockCache())
+    return make_unique<FileReader>(platform.ReadPathForFile(file.GetPath(type), "f"), std::move(blockCache));
+  return platform.GetReader(file.GetPath(type), "f");
 }
 
 // static
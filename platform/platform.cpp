@@ -374,6 +374,18 @@ void Platform::SetGuiThread(std::unique_ptr<base::TaskLoop> guiThread)
   m_guiThread = std::move(guiThread);
 }
 
+void Platform::SetMwmBlockCache(std::shared_ptr<BlockCache> blockCache)
+{
+  std::lock_guard lock(m_mwmBlockCacheMutex);
+  m_mwmBlockCache = std::move(blockCache);
+}
+
+std::shared_ptr<BlockCache> Platform::GetMwmBlockCache() const
+{
+  std::lock_guard lock(m_mwmBlockCacheMutex);
+  return m_mwmBlockCache;
+}
+
 void Platform::CancelTask(Thread thread, base::TaskLoop::TaskId id)
 {
   ASSERT(m_networkThread && m_fileThread && m_backgroundThread, ());
@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -28,6 +29,7 @@ namespace platform
 class LocalCountryFile;
 }
 
+class BlockCache;
 class Platform;
 
 extern Platform & GetPlatform();
@@ -118,6 +120,9 @@ protected:
 
   platform::BatteryLevelTracker m_batteryTracker;
 
+  mutable std::mutex m_mwmBlockCacheMutex;
+  std::shared_ptr<BlockCache> m_mwmBlockCache;
+
 public:
   Platform();
   virtual ~Platform() = default;
@@ -339,6 +344,11 @@ public:
 
   platform::BatteryLevelTracker & GetBatteryTracker() { return m_batteryTracker; }
 
+  /// Sets the cache shared by readers of downloaded mwm files, see platform::GetCountryReader().
+  /// Readers which are already opened are not affected. nullptr disables the cache.
+  void SetMwmBlockCache(std::shared_ptr<BlockCache> blockCache);
+  std::shared_ptr<BlockCache> GetMwmBlockCache() const;
+
 private:
   void RunThreads();
   void ShutdownThreads();
@@ -62,19 +62,6 @@ public:
   }
 };
 
-/// @todo Should be merged/replaced with ftypes::IsPoiChecker?
-class IsPoiChecker
-{
-public:
-  DECLARE_CHECKER_INSTANCE(IsPoiChecker);
-
-  bool operator()(FeatureType & ft) const { return m_oneLevel(ft) || m_twoLevel(ft); }
-
-private:
-  OneLevelPOIChecker const m_oneLevel;
-  TwoLevelPOIChecker const m_twoLevel;
-};
-
 class IsComplexPoiChecker : public ftypes::BaseChecker
 {
   IsComplexPoiChecker() : ftypes::BaseChecker()
@@ -117,42 +104,72 @@ public:
   DECLARE_CHECKER_INSTANCE(IsComplexPoiChecker);
 };
 
-class CustomIsBuildingChecker
+/// All checkers of Model::GetType, so feature types are looked up once.
+class ModelCheckers
 {
 public:
-  DECLARE_CHECKER_INSTANCE(CustomIsBuildingChecker);
+  DECLARE_CHECKER_INSTANCE(ModelCheckers);
+
+  enum Checker
+  {
+    COMPLEX_POI,
+    ONE_LEVEL_POI,
+    TWO_LEVEL_POI,
+    ADDRESS_INTERPOL,
+    BUILDING,
+    STREET_OR_SQUARE,
+    SUBURB
+  };
 
-  bool operator()(FeatureType & ft) const
+  static bool Has(CompiledCheckers::Mask mask, Checker checker)
   {
-    if (!ft.GetHouseNumber().empty())
-      return true;
+    return (mask & CompiledCheckers::GetBit(checker)) != 0;
+  }
+
+  CompiledCheckers::Mask operator()(feature::TypesHolder const & types) const { return m_compiled(types); }
 
-    if (ft.GetGeomType() == feature::GeomType::Line)
-      return IsAddressInterpolChecker::Instance()(ft);
-    else
-      return IsBuildingChecker::Instance()(ft);
+private:
+  ModelCheckers()
+    : m_compiled({&IsComplexPoiChecker::Instance(), &m_oneLevel, &m_twoLevel,
+                  &IsAddressInterpolChecker::Instance(), &IsBuildingChecker::Instance(),
+                  &IsStreetOrSquareChecker::Instance(), &IsSuburbChecker::Instance()})
+  {
   }
+
+  OneLevelPOIChecker const m_oneLevel;
+  TwoLevelPOIChecker const m_twoLevel;
+  CompiledCheckers const m_compiled;
 };
 }  // namespace
 
-Model::Type Model::GetType(FeatureType & feature) const
+Model::Type Model::GetType(FeatureType & ft) const
 {
+  using Checkers = ModelCheckers;
+
+  feature::TypesHolder const types(ft);
+  auto const mask = Checkers::Instance()(types);
+
   // Check whether object is POI first to mark POIs with address tags as POI.
-  if (IsComplexPoiChecker::Instance()(feature))
+  if (Checkers::Has(mask, Checkers::COMPLEX_POI))
     return TYPE_COMPLEX_POI;
-  if (IsPoiChecker::Instance()(feature))
+  if (Checkers::Has(mask, Checkers::ONE_LEVEL_POI) || Checkers::Has(mask, Checkers::TWO_LEVEL_POI))
     return TYPE_SUBPOI;
 
-  if (CustomIsBuildingChecker::Instance()(feature))
+  if (!ft.GetHouseNumber().empty())
     return TYPE_BUILDING;
+  if (ft.GetGeomType() == feature::GeomType::Line ? Checkers::Has(mask, Checkers::ADDRESS_INTERPOL)
+                                                       : Checkers::Has(mask, Checkers::BUILDING))
+  {
+    return TYPE_BUILDING;
+  }
 
-  if (IsStreetOrSquareChecker::Instance()(feature))
+  if (Checkers::Has(mask, Checkers::STREET_OR_SQUARE))
     return TYPE_STREET;
 
-  if (IsSuburbChecker::Instance()(feature))
+  if (Checkers::Has(mask, Checkers::SUBURB))
     return TYPE_SUBURB;
 
-  auto const type = IsLocalityChecker::Instance().GetType(feature);
+  auto const type = IsLocalityChecker::Instance().GetType(types);
   switch (type)
   {
   case LocalityType::State: return TYPE_STATE;
@@ -20,7 +20,7 @@ typedef struct
 typedef struct
 {
   float3 a_position [[attribute(0)]];
-  float2 a_texCoords [[attribute(1)]];
+  ushort2 a_texCoords [[attribute(1)]];
 } AreaVertex_T;
 
 typedef struct
@@ -37,7 +37,7 @@ vertex AreaFragment_T vsArea(const AreaVertex_T in [[stage_in]],
   AreaFragment_T out;
   float4 pos = float4(in.a_position, 1.0) * uniforms.u_modelView * uniforms.u_projection;
   out.position = ApplyPivotTransform(pos, uniforms.u_pivotTransform, 0.0);
-  half4 color = u_colorTex.sample(u_colorTexSampler, in.a_texCoords);
+  half4 color = u_colorTex.sample(u_colorTexSampler, UnpackTexCoords(in.a_texCoords));
   color.a *= uniforms.u_opacity;
   out.color = color;
   return out;
@@ -107,7 +107,7 @@ fragment half4 fsArea3d(const Area3dFragment_T in [[stage_in]])
 typedef struct
 {
   float3 a_position [[attribute(0)]];
-  float2 a_texCoords [[attribute(1)]];
+  ushort2 a_texCoords [[attribute(1)]];
 } Area3dOutlineVertex_T;
 
 vertex AreaFragment_T vsArea3dOutline(const Area3dOutlineVertex_T in [[stage_in]],
@@ -122,7 +122,7 @@ vertex AreaFragment_T vsArea3dOutline(const Area3dOutlineVertex_T in [[stage_in]
   pos.z = in.a_position.z * uniforms.u_zScale;
   out.position = uniforms.u_pivotTransform * pos;
   
-  half4 color = u_colorTex.sample(u_colorTexSampler, in.a_texCoords);
+  half4 color = u_colorTex.sample(u_colorTexSampler, UnpackTexCoords(in.a_texCoords));
   color.a *= uniforms.u_opacity;
   out.color = color;
   return out;
@@ -216,8 +216,8 @@ fragment float4 fsCirclePoint(const CirclePointFragment_T in [[stage_in]],
 typedef struct
 {
   float3 a_position [[attribute(0)]];
-  float3 a_normal [[attribute(1)]];
-  float2 a_texCoords [[attribute(2)]];
+  float2 a_normal [[attribute(1)]];
+  ushort2 a_texCoords [[attribute(2)]];
 } LineVertex_T;
 
 typedef struct
@@ -234,7 +234,7 @@ vertex LineFragment_T vsLine(const LineVertex_T in [[stage_in]],
 {
   LineFragment_T out;
   
-  float2 normal = in.a_normal.xy;
+  float2 normal = in.a_normal;
   float halfWidth = length(normal);
   float2 transformedAxisPos = (float4(in.a_position.xy, 0.0, 1.0) * uniforms.u_modelView).xy;
   if (halfWidth != 0.0)
@@ -243,12 +243,10 @@ vertex LineFragment_T vsLine(const LineVertex_T in [[stage_in]],
                                                     uniforms.u_modelView, halfWidth);
   }
   
-  //out.halfLength = float2(sign(in.a_normal.z) * halfWidth, abs(in.a_normal.z));
-  
   float4 pos = float4(transformedAxisPos, in.a_position.z, 1.0) * uniforms.u_projection;
   out.position = ApplyPivotTransform(pos, uniforms.u_pivotTransform, 0.0);
   
-  float4 color = u_colorTex.sample(u_colorTexSampler, in.a_texCoords);
+  float4 color = u_colorTex.sample(u_colorTexSampler, UnpackTexCoords(in.a_texCoords));
   color.a *= uniforms.u_opacity;
   out.color = color;
   return out;
@@ -15,3 +15,6 @@ float4 ApplyBillboardPivotTransform(float4 pivot, float4x4 pivotTransform, float
 
 // This function calculates transformed position on an axis for line shaders family.
 float2 CalcLineTransformedAxisPos(float2 originalAxisPos, float2 shiftedPos, float4x4 modelView, float halfWidth);
+
+// This function unpacks texture coordinates which are packed into normalized 16-bit integers.
+float2 UnpackTexCoords(ushort2 packedTexCoords);
@@ -22,6 +22,11 @@ float2 CalcLineTransformedAxisPos(float2 originalAxisPos, float2 shiftedPos, flo
     return originalAxisPos;
 }
 
+float2 UnpackTexCoords(ushort2 packedTexCoords)
+{
+  return float2(packedTexCoords) / 65535.0;
+}
+
 float4 ApplyBillboardPivotTransform(float4 pivot, float4x4 pivotTransform, float pivotRealZ, float2 offset)
 {
   float logicZ = pivot.z / pivot.w;
@@ -112,6 +112,7 @@ MTLVertexFormat GetFormatByDataType(MTLDataType dataType)
   case MTLDataTypeFloat2: return MTLVertexFormatFloat2;
   case MTLDataTypeFloat3: return MTLVertexFormatFloat3;
   case MTLDataTypeFloat4: return MTLVertexFormatFloat4;
+  case MTLDataTypeUShort2: return MTLVertexFormatUShort2;
   default: CHECK(false, ("Unsupported vertex format."));
   }
   return MTLVertexFormatInvalid;
@@ -125,6 +126,7 @@ uint32_t GetSizeByDataType(MTLDataType dataType)
   case MTLDataTypeFloat2: return 2 * sizeof(float);
   case MTLDataTypeFloat3: return 3 * sizeof(float);
   case MTLDataTypeFloat4: return 4 * sizeof(float);
+  case MTLDataTypeUShort2: return 2 * sizeof(uint16_t);
   default: CHECK(false, ("Unsupported vertex format."));
   }
   return 0;
@@ -76,6 +76,22 @@ def parse_options():
         help=f"Stage from which maps will be rebuild. Available stages: "
         f"{', '.join([s.replace('stage_', '') for s in stages.stages.get_visible_stages_names()])}.",
     )
+    parser.add_argument(
+        "--osm_change",
+        type=str,
+        default="",
+        help="Path to an OSM change (.osc) file from the planet of the previous build "
+        "to the planet of this build. Only countries changed by it and worlds go through "
+        "the mwm stages (including mwm diffs). Intermediate data of the previous build "
+        "must be kept.",
+    )
+    parser.add_argument(
+        "--previous_build",
+        type=str,
+        default="",
+        help="Name of the build whose intermediate data is used with --osm_change. "
+        "Defaults to the last build.",
+    )
     parser.add_argument(
         "--coasts",
         default=False,
@@ -228,6 +244,21 @@ def main():
     if not settings.NEED_BUILD_WORLD_ROADS:
         skipped_stages.add(sd.StageRoutingWorld)
 
+    # Processing of 'osm_change' option.
+    # The previous build must be found before the new build directory is created.
+    osm_change = None
+    previous_build_name = None
+    if options.osm_change:
+        osm_change = os.path.abspath(options.osm_change)
+        previous_build_name = find_last_build_dir(options.previous_build or None)
+        if previous_build_name is None or previous_build_name == build_name:
+            raise ValidationError(
+                "--osm_change requires intermediate data of a previous build, "
+                "set it with --previous_build."
+            )
+    else:
+        skipped_stages.add(sd.StageChangedCountries)
+
     # Make env and run maps generation.
     env = Env(
         countries=countries,
@@ -235,7 +266,9 @@ def main():
         build_name=build_name,
         build_suffix=options.suffix,
         skipped_stages=skipped_stages,
-        force_download_files=options.force_download_files
+        force_download_files=options.force_download_files,
+        osm_change=osm_change,
+        previous_build_name=previous_build_name,
     )
     from_stage = None
     if options.from_stage:
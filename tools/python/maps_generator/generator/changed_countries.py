@@ -0,0 +1,27 @@
+"""
+This file contains functions to limit a build to countries changed by an OSM change.
+The list of changed countries is written by generator_tool --osm_change, that runs
+on intermediate data of the previous build.
+"""
+from typing import AnyStr
+from typing import Iterable
+from typing import List
+from typing import Set
+
+
+def read_changed_countries(path: AnyStr) -> Set[AnyStr]:
+    """Reads a newline-separated list of countries written by generator_tool --osm_change."""
+    with open(path) as f:
+        return {line.strip() for line in f if line.strip()}
+
+
+def select_changed_countries(
+    countries: Iterable[AnyStr],
+    changed_countries: Set[AnyStr],
+    always_built: Set[AnyStr] = frozenset(),
+) -> List[AnyStr]:
+    """
+    Returns countries from |countries| that are changed or must always be built,
+    keeping the order of |countries|.
+    """
+    return [c for c in countries if c in changed_countries or c in always_built]
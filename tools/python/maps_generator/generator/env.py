@@ -18,6 +18,8 @@ from typing import Union
 
 from maps_generator.generator import settings
 from maps_generator.generator import status
+from maps_generator.generator.changed_countries import read_changed_countries
+from maps_generator.generator.changed_countries import select_changed_countries
 from maps_generator.generator.osmtools import build_osmtools
 from maps_generator.generator.stages import Stage
 from maps_generator.utils.file import find_executable
@@ -149,6 +151,14 @@ class PathProvider:
         """It's a synonym for intermediate_data_path."""
         return self.intermediate_data_path
 
+    @property
+    def changed_countries_path(self) -> AnyStr:
+        """
+        changed_countries_path contains countries changed since the previous build.
+        If it exists, only these countries and worlds go through the mwm stages.
+        """
+        return os.path.join(self.intermediate_data_path, "changed_countries.txt")
+
     @property
     @create_if_not_exist
     def intermediate_tmp_path(self) -> AnyStr:
@@ -382,6 +392,8 @@ class Env:
         build_suffix: AnyStr = "",
         skipped_stages: Optional[Set[Type[Stage]]] = None,
         force_download_files: bool = False,
+        osm_change: Optional[AnyStr] = None,
+        previous_build_name: Optional[AnyStr] = None,
     ):
         self.setup_logging()
 
@@ -392,6 +404,8 @@ class Env:
 
         self.production = production
         self.force_download_files = force_download_files
+        self.osm_change = osm_change
+        self.previous_build_name = previous_build_name
         self.countries = countries
         self.skipped_stages = set() if skipped_stages is None else skipped_stages
         if self.countries is None:
@@ -469,7 +483,11 @@ class Env:
                 name = f.replace(tmp_ext, "")
                 if name in self.countries:
                     existing_names.add(name)
-        return [c for c in self.countries if c in existing_names]
+        names = [c for c in self.countries if c in existing_names]
+        if os.path.isfile(self.paths.changed_countries_path):
+            changed = read_changed_countries(self.paths.changed_countries_path)
+            names = select_changed_countries(names, changed, WORLDS_NAMES)
+        return names
 
     def add_skipped_stage(self, stage: Union[Type[Stage], Stage]):
         if isinstance(stage, Stage):
@@ -61,6 +61,7 @@ class GenTool:
         "isolines_path": str,
         "nodes_list_path": str,
         "node_storage": str,
+        "osm_change": str,
         "osm_file_name": str,
         "osm_file_type": str,
         "output": str,
@@ -68,6 +68,12 @@ class StageUpdatePlanet(Stage):
         steps.step_update_planet(env, **kwargs)
 
 
+@outer_stage
+class StageChangedCountries(Stage):
+    def apply(self, env: Env, **kwargs):
+        steps.step_changed_countries(env, **kwargs)
+
+
 @outer_stage
 class StageCoastline(Stage):
     def apply(self, env: Env, use_old_if_fail=True):
@@ -322,8 +328,8 @@ class StageRoutingTransit(Stage):
 class StageMwmDiffs(Stage):
     def apply(self, env: Env, country, logger, **kwargs):
         data_dir = diffs.DataDir(
-            mwm_name=env.build_name,
-            new_version_dir=env.build_path,
+            mwm_name=f"{country}.mwm",
+            new_version_dir=env.paths.mwm_path,
             old_version_root_dir=settings.DATA_ARCHIVE_DIR,
         )
         diffs.mwm_diff_calculation(data_dir, logger, depth=settings.DIFF_VERSION_DEPTH)
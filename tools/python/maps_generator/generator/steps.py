@@ -10,6 +10,7 @@ import subprocess
 from typing import AnyStr
 
 from maps_generator.generator import settings
+from maps_generator.generator.changed_countries import read_changed_countries
 from maps_generator.generator.env import Env
 from maps_generator.generator.env import PathProvider
 from maps_generator.generator.env import WORLDS_NAMES
@@ -91,6 +92,36 @@ def step_update_planet(env: Env, **kwargs):
     write_md5sum(env.paths.planet_o5m, md5_ext(env.paths.planet_o5m))
 
 
+def step_changed_countries(env: Env, **kwargs):
+    if env.previous_build_name is None:
+        raise ValidationError(f"There is no previous build to apply {env.osm_change} to.")
+
+    previous = PathProvider(
+        os.path.join(settings.MAIN_OUT_PATH, env.previous_build_name),
+        env.previous_build_name,
+        env.mwm_version,
+    )
+    run_gen_tool(
+        env.gen_tool,
+        out=env.get_subprocess_out(),
+        err=env.get_subprocess_out(),
+        data_path=previous.data_path,
+        intermediate_data_path=previous.intermediate_data_path,
+        cache_path=previous.cache_path,
+        node_storage=env.node_storage,
+        user_resource_path=env.paths.user_resource_path,
+        osm_change=env.osm_change,
+        **kwargs,
+    )
+    # The list must not stay in the previous build, it would limit its continuation.
+    shutil.move(previous.changed_countries_path, env.paths.changed_countries_path)
+    changed = read_changed_countries(env.paths.changed_countries_path)
+    logger.info(
+        f"{len(changed)} countries are changed by {env.osm_change} "
+        f"since {env.previous_build_name}."
+    )
+
+
 def step_preprocess(env: Env, **kwargs):
     run_gen_tool(
         env.gen_tool,
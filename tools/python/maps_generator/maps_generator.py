@@ -29,6 +29,7 @@ def generate_maps(env: Env, from_stage: Optional[AnyStr] = None):
     stages = (
         sd.StageDownloadAndConvertPlanet(),
         sd.StageUpdatePlanet(),
+        sd.StageChangedCountries(),
         sd.StageCoastline(),
         sd.StagePreprocess(),
         sd.StageFeatures(),
@@ -0,0 +1,61 @@
+import os
+import tempfile
+import unittest
+
+from maps_generator.generator.changed_countries import read_changed_countries
+from maps_generator.generator.changed_countries import select_changed_countries
+
+
+class TestChangedCountries(unittest.TestCase):
+    def setUp(self):
+        self.dir = tempfile.TemporaryDirectory()
+        self.path = os.path.join(self.dir.name, "changed_countries.txt")
+        with open(self.path, "w") as file:
+            file.write("Germany_Berlin\nCzech_Jihovychod_Jihomoravsky kraj\n\nMacedonia\n")
+
+    def tearDown(self):
+        self.dir.cleanup()
+
+    def test_read_changed_countries(self):
+        self.assertEqual(
+            read_changed_countries(self.path),
+            {"Germany_Berlin", "Czech_Jihovychod_Jihomoravsky kraj", "Macedonia"},
+        )
+
+    def test_select_changed_countries(self):
+        countries = [
+            "World",
+            "Macedonia",
+            "Japan_Kinki Region_Osaka_Osaka",
+            "Czech_Jihovychod_Jihomoravsky kraj",
+            "WorldCoasts",
+            "Germany_Berlin",
+        ]
+        selected = select_changed_countries(
+            countries,
+            read_changed_countries(self.path),
+            always_built={"World", "WorldCoasts"},
+        )
+        self.assertEqual(
+            selected,
+            [
+                "World",
+                "Macedonia",
+                "Czech_Jihovychod_Jihomoravsky kraj",
+                "WorldCoasts",
+                "Germany_Berlin",
+            ],
+        )
+
+    def test_select_unknown_changed_countries(self):
+        # Countries which are not built at all are not added.
+        selected = select_changed_countries(["Macedonia"], {"Macedonia", "Germany_Berlin"})
+        self.assertEqual(selected, ["Macedonia"])
+
+    def test_select_nothing_changed(self):
+        selected = select_changed_countries(["World", "Macedonia"], set(), {"World"})
+        self.assertEqual(selected, ["World"])
+
+
+if __name__ == "__main__":
+    unittest.main()